@@ -18,11 +18,12 @@ Args Args_Parse(const int32_t argc, const char* argv[])
     args.color = COLOR_BLU;
     args.host = "localhost";
     args.port = 1234;
-    args.port_ping = args.port + 1;
     args.xres = 800;
     args.yres = 600;
     args.users = 1;
     args.civ = CIV_NORTH_EUROPE;
+    args.watch = -1;
+    args.script = "mixed";
     for(int32_t i = 0; i < argc; i++)
     {
         const char* const arg = argv[i];
@@ -36,6 +37,27 @@ Args Args_Parse(const int32_t argc, const char* argv[])
         if(Check(arg, "-q", "--quiet" )) args.quiet = true;
         if(Check(arg, "-v", "--civ"   )) args.civ = (Civ) atoi(next);
         if(Check(arg, "-d", "--demo"  )) args.demo = true;
+        if(Check(arg, "-b", "--bench" )) args.bench = next;
+        if(Check(arg, "-H", "--shards")) args.shards = atoi(next);
+        if(Check(arg, "-m", "--match" )) args.match = atoi(next);
+        if(Check(arg, "-t", "--udp"   )) args.udp = true;
+        if(Check(arg, "-k", "--rollback")) args.rollback = true;
+        if(Check(arg, "-w", "--watch" )) args.watch = atoi(next);
+        if(Check(arg, "-o", "--observe")) args.observe = true;
+        if(Check(arg, "-a", "--swarm" )) args.swarm = atoi(next);
+        if(Check(arg, "-i", "--script")) args.script = next;
+        if(Check(arg, "-n", "--seconds")) args.seconds = atoi(next);
+        if(Check(arg, "-T", "--telemetry")) args.telemetry = next;
+        if(Check(arg, "-z", "--compress")) args.compress = atoi(next);
+        if(Check(arg, "-e", "--record")) args.record = next;
+        if(Check(arg, "-r", "--replay")) args.replay = next;
+        if(Check(arg, "-D", "--delay"    )) args.impair.delay_ms = atoi(next);
+        if(Check(arg, "-J", "--jitter"   )) args.impair.jitter_ms = atoi(next);
+        if(Check(arg, "-L", "--loss"     )) args.impair.loss = atoi(next);
+        if(Check(arg, "-U", "--duplicate")) args.impair.duplicate = atoi(next);
+        if(Check(arg, "-R", "--reorder"  )) args.impair.reorder = atoi(next);
+        if(Check(arg, "-W", "--rate"     )) args.impair.rate_kbps = atoi(next);
+        if(Check(arg, "-S", "--seed"     )) args.impair.seed = (uint32_t) atoi(next);
     }
     assert(args.path);
     return args;
@@ -2,6 +2,7 @@
 
 #include "Civ.h"
 #include "Color.h"
+#include "Impair.h"
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -14,12 +15,26 @@ typedef struct
     bool is_server;
     const char* host;
     int32_t port;
-    int32_t port_ping;
     int32_t xres;
     int32_t yres;
     int32_t users;
+    int32_t shards;
+    int32_t match;
+    bool udp;
+    bool rollback;
+    int32_t watch;
+    bool observe;
+    int32_t swarm;
+    const char* script;
+    int32_t seconds;
+    const char* telemetry;
+    int32_t compress;
+    Impair impair;
     bool quiet;
     bool demo;
+    const char* bench;
+    const char* record;
+    const char* replay;
 }
 Args;
 
@@ -0,0 +1,14 @@
+#pragma once
+
+// THE FIELD GROUPS OF A UNIT THAT ARE HASHED APART, SO THAT A DESYNC NAMES WHICH PART OF THE
+// SIMULATION WENT WRONG FIRST.
+
+typedef enum
+{
+    ASPECT_POSITION,
+    ASPECT_HEALTH,
+    ASPECT_PATH,
+    ASPECT_TIMER,
+    ASPECT_COUNT,
+}
+Aspect;
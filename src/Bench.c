@@ -0,0 +1,1629 @@
+#include "Bench.h"
+
+#include "Units.h"
+#include "Flock.h"
+#include "Fixed.h"
+#include "Rand.h"
+#include "Config.h"
+#include "Util.h"
+#include "Host.h"
+#include "Sock.h"
+#include "Packet.h"
+#include "Packets.h"
+#include "Command.h"
+#include "Shim.h"
+#include "Clock.h"
+#include "Parities.h"
+#include "Rollback.h"
+#include "Swarm.h"
+#include "Replay.h"
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+#define BENCH_ROUNDS (10)
+
+static double Now(void)
+{
+    return (double) SDL_GetPerformanceCounter() / (double) SDL_GetPerformanceFrequency();
+}
+
+static int32_t Spread(uint32_t* const seed, const int32_t span)
+{
+    const int64_t value = ((int64_t) Util_RandNext(seed) << 15) | Util_RandNext(seed);
+    return (int32_t) (value % span);
+}
+
+// ROUGHLY FOUR UNITS PER TILE WITH EVERY SIXTEENTH UNIT SHARING A CELL, SO THAT BOTH
+// NUDGING AND PLATOON ALIGNMENT ARE EXERCISED.
+static Units Populate(Units units, const Grid grid)
+{
+    uint32_t seed = 1;
+    const Point span = {
+        grid.cols * grid.tile_cart_width * CONFIG_GRID_CELL_SIZE,
+        grid.rows * grid.tile_cart_height * CONFIG_GRID_CELL_SIZE,
+    };
+    for(int32_t i = 0; i < units.max; i++)
+    {
+        static Unit zero;
+        Unit unit = zero;
+        unit.trait = Trait_Build(FILE_MILITIA_IDLE);
+        unit.file = FILE_MILITIA_IDLE;
+        unit.id = i;
+        unit.state = STATE_IDLE;
+        unit.color = (Color) (i % 4);
+        unit.command_group = i % 8;
+        unit.entropy.x = Spread(&seed, RAND_MAX_VALUE);
+        unit.entropy.y = Spread(&seed, RAND_MAX_VALUE);
+        unit.velocity.x = Spread(&seed, 2 * unit.trait.max_speed) - unit.trait.max_speed;
+        unit.velocity.y = Spread(&seed, 2 * unit.trait.max_speed) - unit.trait.max_speed;
+        unit.cell.x = Spread(&seed, span.x);
+        unit.cell.y = Spread(&seed, span.y);
+        if(i % 16 == 15)
+            unit.cell = units.unit[i - 1].cell;
+        unit.cart = Grid_CellToCart(grid, unit.cell);
+        units.unit[units.count++] = unit;
+    }
+    Units_ManageStacks(units);
+    return units;
+}
+
+// THE PER PAIR PATH THE FLOCK KERNEL REPLACED, KEPT AS THE REFERENCE.
+static void Reference(const Units units, Unit* const unit, Point* const separation, Point* const alignment)
+{
+    static Point zero;
+    Point separate = zero;
+    Point align = zero;
+    for(int32_t x = -1; x <= 1; x++)
+    for(int32_t y = -1; y <= 1; y++)
+    {
+        const Point cart_offset = { x, y };
+        const Stack stack = Units_GetStackCart(units, Point_Add(unit->cart, cart_offset));
+        for(int32_t i = 0; i < stack.count; i++)
+        {
+            Unit* const other = stack.reference[i];
+            separate = Point_Sub(separate, Unit_Separate(unit, other));
+            if(!Unit_IsExempt(other) && Unit_IsDifferent(unit, other) && Unit_InPlatoon(unit, other))
+                align = Point_Add(align, other->velocity);
+        }
+    }
+    *separation = Point_Div(separate, CONFIG_UNITS_SEPARATION_DIVISOR);
+    *alignment = Point_Div(align, CONFIG_UNITS_ALIGN_DIVISOR);
+}
+
+static void Boids(const int32_t count)
+{
+    const int32_t side = Fixed_Sqrt(count / 4) + 1;
+    const Grid grid = Grid_Make(side, side, 96, 48);
+    Units units = Units_New(grid, 1, count, COLOR_BLU, CIV_NORTH_EUROPE);
+    units = Populate(units, grid);
+    Point* const expect = UTIL_ALLOC(Point, 2 * count);
+    Point* const actual = UTIL_ALLOC(Point, 2 * count);
+    const double t0 = Now();
+    for(int32_t round = 0; round < BENCH_ROUNDS; round++)
+    for(int32_t i = 0; i < count; i++)
+        Reference(units, &units.unit[i], &expect[2 * i + 0], &expect[2 * i + 1]);
+    const double t1 = Now();
+    Flock flock = Flock_Make(CONFIG_UNITS_FLOCK_SIZE);
+    for(int32_t round = 0; round < BENCH_ROUNDS; round++)
+    for(int32_t i = 0; i < count; i++)
+    {
+        flock = Flock_Gather(flock, units, &units.unit[i]);
+        Flock_Steer(flock, &units.unit[i], &actual[2 * i + 0], &actual[2 * i + 1]);
+    }
+    const double t2 = Now();
+    int32_t mismatches = 0;
+    for(int32_t i = 0; i < 2 * count; i++)
+        if(!Point_Equal(expect[i], actual[i]))
+            mismatches++;
+    const double scale = 1e9 / ((double) count * BENCH_ROUNDS);
+    printf("boids %6d units :: reference %7.1f ns/unit :: flock (%s) %7.1f ns/unit :: mismatches %d\n",
+        count, (t1 - t0) * scale, Flock_GetPath(), (t2 - t1) * scale, mismatches);
+    Flock_Free(flock);
+    free(expect);
+    free(actual);
+    Units_Free(units);
+}
+
+// THE PARITY PASS AGAINST THE FLOCK PASS, WHICH IS ONLY ONE PART OF A TICK.
+static void Hash(const int32_t count)
+{
+    const int32_t side = Fixed_Sqrt(count / 4) + 1;
+    const Grid grid = Grid_Make(side, side, 96, 48);
+    Units units = Units_New(grid, 1, count, COLOR_BLU, CIV_NORTH_EUROPE);
+    units = Populate(units, grid);
+    Point separation;
+    Point alignment;
+    Flock flock = Flock_Make(CONFIG_UNITS_FLOCK_SIZE);
+    const double t0 = Now();
+    for(int32_t round = 0; round < BENCH_ROUNDS; round++)
+    for(int32_t i = 0; i < count; i++)
+    {
+        flock = Flock_Gather(flock, units, &units.unit[i]);
+        Flock_Steer(flock, &units.unit[i], &separation, &alignment);
+    }
+    const double t1 = Now();
+    uint64_t root = 0;
+    for(int32_t round = 0; round < BENCH_ROUNDS; round++)
+        root += Units_Parity(units).root;
+    const double t2 = Now();
+    const double scale = 1e9 / ((double) count * BENCH_ROUNDS);
+    printf("parity %6d units :: flock %7.1f ns/unit :: parity %5.1f ns/unit, %6.3f ms per checkpoint, %6.3f ms per tick :: 0x%016lX\n",
+        count, (t1 - t0) * scale, (t2 - t1) * scale, (t2 - t1) * 1e3 / BENCH_ROUNDS, (t2 - t1) * 1e3 / BENCH_ROUNDS / CONFIG_PARITY_INTERVAL, root);
+    Flock_Free(flock);
+    Units_Free(units);
+}
+
+#define BENCH_PATH (16)
+
+// A COPY OF THE SNAPSHOT WITH ONE FIELD OVERWRITTEN, WHICH MUST BE REFUSED.
+static bool Refuses(const Units units, const Snapshot snapshot, const int32_t at, const int32_t value)
+{
+    Snapshot copy = Snapshot_Make();
+    Snapshot_Put(&copy, snapshot.byte, snapshot.size);
+    memcpy(copy.byte + at, &value, sizeof(value));
+    const bool refused = !Units_CanRestore(units, copy);
+    Snapshot_Free(copy);
+    return refused;
+}
+
+// HALF THE UNITS WALK A PATH AND HAVE AN INTEREST, AND THE WORLD IS RESTORED INTO A SECOND SET OF
+// UNITS, WHICH MUST COME BACK WITH THE SAME PARITY AND TAKE THE SAME SNAPSHOT.
+static void Save(const int32_t count)
+{
+    const int32_t side = Fixed_Sqrt(count / 4) + 1;
+    const Grid grid = Grid_Make(side, side, 96, 48);
+    Units units = Units_New(grid, 1, count, COLOR_BLU, CIV_NORTH_EUROPE);
+    Units other = Units_New(grid, 1, count, COLOR_BLU, CIV_NORTH_EUROPE);
+    units = Populate(units, grid);
+    for(int32_t i = 0; i < count; i += 2)
+    {
+        Unit* const unit = &units.unit[i];
+        unit->path = Points_New(BENCH_PATH);
+        for(int32_t j = 0; j < BENCH_PATH; j++)
+        {
+            const Point point = { unit->cart.x + j, unit->cart.y };
+            unit->path = Points_Append(unit->path, point);
+        }
+        unit->interest = &units.unit[(i + 1) % count];
+    }
+    Snapshot snapshot = Snapshot_Make();
+    Snapshot again = Snapshot_Make();
+    const double t0 = Now();
+    for(int32_t round = 0; round < BENCH_ROUNDS; round++)
+        snapshot = Units_Snapshot(units, snapshot);
+    const double t1 = Now();
+    for(int32_t round = 0; round < BENCH_ROUNDS; round++)
+        other = Units_Restore(other, snapshot);
+    const double t2 = Now();
+    again = Units_Snapshot(other, again);
+    const bool same = again.size == snapshot.size
+        && memcmp(again.byte, snapshot.byte, (size_t) snapshot.size) == 0
+        && Units_Parity(other).root == Units_Parity(units).root;
+    const int32_t interests = snapshot.size - (count / 2) * BENCH_PATH * (int32_t) sizeof(Point) - count * (int32_t) sizeof(int32_t);
+    const int32_t first = interests - count * (int32_t) sizeof(Unit);
+    const Unit walker = units.unit[0];
+    const int32_t refused = Refuses(other, snapshot, first + (int32_t) (offsetof(Unit, path) + offsetof(Points, count)), walker.path.max + 1)
+                          + Refuses(other, snapshot, first + (int32_t) offsetof(Unit, path_index), walker.path.count)
+                          + Refuses(other, snapshot, first + (int32_t) (offsetof(Unit, path) + offsetof(Points, max)), INT32_MAX)
+                          + Refuses(other, snapshot, interests, count);
+    printf("snapshot %6d units :: %6.2f MB :: save %6.3f ms :: restore %6.3f ms :: %s :: %d of 4 corrupt refused\n",
+        count, snapshot.size / 1e6, (t1 - t0) * 1e3 / BENCH_ROUNDS, (t2 - t1) * 1e3 / BENCH_ROUNDS,
+        same ? "identical" : "DIFFERENT", refused);
+    Snapshot_Free(snapshot);
+    Snapshot_Free(again);
+    for(int32_t i = 0; i < count; i++)
+    {
+        Unit_FreePath(&units.unit[i]);
+        Unit_FreePath(&other.unit[i]);
+    }
+    Units_Free(units);
+    Units_Free(other);
+}
+
+#define BENCH_QUEUE_STEP (CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS / CONFIG_MAIN_LOOP_SPEED_MS)
+
+// A BACKLOG OF TURNS, AS A CLIENT HAS AFTER A STALL OR WHILE REJOINING, QUEUED AT ONCE AND THEN
+// TICKED THROUGH LIKE PLAY. EVERY TURN MUST COME OUT, AND IN ORDER.
+static void Backlog(const int32_t count)
+{
+    static Packet zero;
+    Packets packets = Packets_Init();
+    const double t0 = Now();
+    for(int32_t i = 0; i < count; i++)
+    {
+        Packet packet = zero;
+        packet.turn = i + 1;
+        packet.exec_cycle = i * BENCH_QUEUE_STEP;
+        packet.is_stable = true;
+        packets = Packets_Queue(packets, &packet);
+    }
+    const double t1 = Now();
+    int32_t applied = 0;
+    bool is_ordered = true;
+    const int32_t cycles = count * BENCH_QUEUE_STEP;
+    for(int32_t cycle = 0; cycle < cycles; cycle++)
+    {
+        packets = Packets_Skip(packets, cycle);
+        for(const Packet* turn = Packets_Find(packets, cycle); turn; turn = Packets_Find(packets, cycle))
+        {
+            is_ordered &= turn->turn == ++applied;
+            packets = Packets_Pop(packets);
+        }
+    }
+    const double t2 = Now();
+    printf("queue %6d turns :: %5d KB :: queue %6.1f ns/turn :: tick %5.1f ns/cycle :: %d applied %s\n",
+        count, (int32_t) (packets.max * sizeof(Packet) / 1024), (t1 - t0) * 1e9 / count,
+        (t2 - t1) * 1e9 / cycles, applied, (applied == count && is_ordered) ? "in order" : "OUT OF ORDER");
+    Packets_Free(packets);
+}
+
+#define BENCH_COMPRESS_TURNS (20000)
+#define BENCH_COMPRESS_USERS (8)
+
+// A CLICK SOMEWHERE ON AN 800 BY 600 SCREEN. MOSTLY MOVES, SOMETIMES A DRAGGED BOX OR A SPAWN, AND
+// NOW AND THEN THE VIEW HAS PANNED SINCE THE LAST ONE.
+static Command Click(uint32_t* const seed, Command command)
+{
+    const int32_t roll = Spread(seed, 8);
+    command.flags = (roll < 6) ? COMMAND_MOVE : (roll == 6) ? (COMMAND_SELECT | COMMAND_BOX) : COMMAND_SPAWN;
+    command.cursor.x = Spread(seed, command.xres);
+    command.cursor.y = Spread(seed, command.yres);
+    if(command.flags & COMMAND_BOX)
+    {
+        command.selection_box.a = command.cursor;
+        command.selection_box.b.x = command.cursor.x + 20 + Spread(seed, 200);
+        command.selection_box.b.y = command.cursor.y + 20 + Spread(seed, 150);
+    }
+    if(command.flags & COMMAND_SPAWN)
+        command.hotkey = Spread(seed, 15);
+    if(Spread(seed, 10) == 0)
+    {
+        command.pan.x += Spread(seed, 400) - 200;
+        command.pan.y += Spread(seed, 300) - 150;
+    }
+    return command;
+}
+
+// THE TURNS AN EIGHT PLAYER MATCH SENDS EVERY CLIENT, WHOLE, AS DELTAS, AND AS SQUEEZED DELTAS. EACH
+// PLAYER ISSUES A COMMAND IN A TURN ONE TIME IN EVERY SO MANY. THE ECHO FOLLOWS A HEARTBEAT EVERY
+// TURN THAT ARRIVES A FEW MILLISECONDS EITHER WAY. EVERY DECODED TURN MUST ENCODE WHOLE TO THE SAME
+// BYTES AS THE TURN SENT.
+static void Compress(const char* const name, const int32_t every, const int32_t level)
+{
+    static Command none;
+    static Packet zero;
+    uint32_t seed = 1;
+    Command last[BENCH_COMPRESS_USERS];
+    uint32_t stamp[BENCH_COMPRESS_USERS];
+    Codec* const server = UTIL_ALLOC(Codec, BENCH_COMPRESS_USERS);
+    Codec* const client = UTIL_ALLOC(Codec, BENCH_COMPRESS_USERS);
+    const Huffman huffman = Huffman_Make();
+    const Huffman* const squeeze = (level >= CODEC_SQUEEZE) ? &huffman : NULL;
+    for(int32_t i = 0; i < BENCH_COMPRESS_USERS; i++)
+    {
+        last[i] = none;
+        last[i].color = (Color) i;
+        last[i].civ = CIV_NORTH_EUROPE;
+        last[i].xres = 800;
+        last[i].yres = 600;
+        last[i].pan.x = Spread(&seed, 4000);
+        last[i].pan.y = Spread(&seed, 2000);
+        stamp[i] = 1000 + Spread(&seed, 100);
+    }
+    int64_t size = 0;
+    double encode = 0.0;
+    double decode = 0.0;
+    int32_t commands = 0;
+    int32_t mismatches = 0;
+    for(int32_t turn = 1; turn <= BENCH_COMPRESS_TURNS; turn++)
+    {
+        Packet packet = zero;
+        packet.turn = turn;
+        packet.setpoint = turn * CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS / CONFIG_MAIN_LOOP_SPEED_MS;
+        packet.exec_cycle = packet.setpoint + 6 + (Spread(&seed, 50) == 0);
+        packet.is_stable = true;
+        packet.game_running = true;
+        packet.users_connected = BENCH_COMPRESS_USERS;
+        packet.users = BENCH_COMPRESS_USERS;
+        for(int32_t i = 0; i < BENCH_COMPRESS_USERS; i++)
+            if(Spread(&seed, every) == 0)
+            {
+                last[i] = Click(&seed, last[i]);
+                packet.overview[i] = Command_ToOverview(last[i]);
+                commands++;
+            }
+        Bytes bytes[BENCH_COMPRESS_USERS];
+        for(int32_t i = 0; i < BENCH_COMPRESS_USERS; i++)
+            stamp[i] += CONFIG_SOCKETS_HEARTBEAT_MS + Spread(&seed, 9) - 4;
+        const double t0 = Now();
+        for(int32_t i = 0; i < BENCH_COMPRESS_USERS; i++)
+        {
+            packet.client_id = i;
+            packet.echo = stamp[i];
+            packet.hold = (int32_t) (turn % CONFIG_SOCKETS_HEARTBEAT_MS);
+            Bytes_Clear(&bytes[i]);
+            if(level == CODEC_OFF)
+                Packet_Encode(packet, &bytes[i]);
+            else
+                Packet_EncodeDelta(packet, &server[i], squeeze, &bytes[i]);
+        }
+        const double t1 = Now();
+        Packet got[BENCH_COMPRESS_USERS];
+        for(int32_t i = 0; i < BENCH_COMPRESS_USERS; i++)
+            got[i] = (level == CODEC_OFF)
+                ? Packet_Decode(&bytes[i])
+                : Packet_DecodeDelta(&bytes[i], &client[i], &huffman);
+        const double t2 = Now();
+        encode += t1 - t0;
+        decode += t2 - t1;
+        for(int32_t i = 0; i < BENCH_COMPRESS_USERS; i++)
+        {
+            size += bytes[i].size;
+            packet.client_id = i;
+            packet.echo = stamp[i];
+            packet.hold = (int32_t) (turn % CONFIG_SOCKETS_HEARTBEAT_MS);
+            Bytes sent;
+            Bytes again;
+            Bytes_Clear(&sent);
+            Bytes_Clear(&again);
+            Packet_Encode(packet, &sent);
+            Packet_Encode(got[i], &again);
+            if(!Bytes_IsDone(&bytes[i]) || sent.size != again.size || memcmp(sent.byte, again.byte, (size_t) sent.size) != 0)
+                mismatches++;
+        }
+    }
+    const double messages = (double) BENCH_COMPRESS_TURNS * BENCH_COMPRESS_USERS;
+    const char* const levels[] = { "whole", "delta", "squeeze" };
+    printf("compress %-7s :: %4.2f commands per turn :: %-7s :: %5.1f bytes per client per turn :: %6.1f bytes per turn :: encode %4.0f ns :: decode %4.0f ns :: %s\n",
+        name, commands / (double) BENCH_COMPRESS_TURNS, levels[level], size / messages, size / (double) BENCH_COMPRESS_TURNS,
+        encode * 1e9 / messages, decode * 1e9 / messages, mismatches == 0 ? "identical" : "DIFFERENT");
+    free(server);
+    free(client);
+}
+
+#define BENCH_PORT (34500)
+#define BENCH_BOTS (4)
+#define BENCH_SECONDS (3)
+
+typedef struct
+{
+    Sock* sock;
+    int32_t count;
+    int32_t turns;
+}
+Bot;
+
+// FRAMES BETWEEN HEARTBEATS, AS IN THE GAME LOOP.
+#define BENCH_BEAT (CONFIG_SOCKETS_HEARTBEAT_MS / CONFIG_MAIN_LOOP_SPEED_MS)
+
+// EACH BOT THREAD DRIVES ITS SHARE OF IDLE CLIENTS LIKE THE GAME LOOP DOES: A HEARTBEAT EVERY
+// FEW FRAMES, AND EVERY FRAME EACH TURN THAT ARRIVED IS DRAINED.
+static int32_t Drive(void* const data)
+{
+    Bot* const bot = (Bot*) data;
+    Overview overview = Overview_Init(0, 0);
+    const uint32_t end = SDL_GetTicks() + 1000 * BENCH_SECONDS;
+    for(int32_t cycles = 1; SDL_GetTicks() < end; cycles++)
+    {
+        overview.cycles = cycles;
+        for(int32_t i = 0; i < bot->count; i++)
+        {
+            if(cycles % BENCH_BEAT == 0)
+                Sock_SendHeartbeat(bot->sock[i], overview);
+            for(Packet packet = Packet_Get(bot->sock[i]); packet.turn > 0; packet = Packet_Get(bot->sock[i]))
+                bot->turns++;
+        }
+        SDL_Delay(CONFIG_MAIN_LOOP_SPEED_MS);
+    }
+    return 0;
+}
+
+// SHARD TIME IS COUNTED ONLY WHILE A SHARD IS AWAKE, SO MATCHES PER CORE IS THE NUMBER OF
+// MATCHES ONE FULLY BUSY SHARD COULD CARRY AT THIS LOAD.
+static void Lobbies(const int32_t count, const int32_t users)
+{
+    const int32_t needed = (count + CONFIG_HOST_MATCHES_PER_SHARD - 1) / CONFIG_HOST_MATCHES_PER_SHARD;
+    const int32_t shards = UTIL_MAX(needed, SDL_GetCPUCount() / 2);
+    Host* const host = Host_Start(BENCH_PORT, shards);
+    const int32_t clients = count * users;
+    Sock* const sock = UTIL_ALLOC(Sock, clients);
+    for(int32_t i = 0; i < clients; i++)
+    {
+        sock[i] = Sock_Join(Sock_Connect("localhost", BENCH_PORT), 0, users);
+        if(sock[i].match == 0)
+            Util_Bomb("BENCH :: CLIENT %d WAS NOT SEATED\n", i);
+    }
+    const int32_t matches = Matches_Count(host->matches);
+    Bot bots[BENCH_BOTS];
+    SDL_Thread* threads[BENCH_BOTS];
+    for(int32_t i = 0; i < BENCH_BOTS; i++)
+    {
+        const int32_t a = (clients * (i + 0)) / BENCH_BOTS;
+        const int32_t b = (clients * (i + 1)) / BENCH_BOTS;
+        static Bot zero;
+        bots[i] = zero;
+        bots[i].sock = &sock[a];
+        bots[i].count = b - a;
+    }
+    uint32_t busy = 0;
+    for(int32_t i = 0; i < shards; i++)
+        busy -= (uint32_t) SDL_AtomicGet(&host->shard[i]->busy);
+    const double t0 = Now();
+    for(int32_t i = 0; i < BENCH_BOTS; i++) threads[i] = SDL_CreateThread(Drive, "N/A", &bots[i]);
+    for(int32_t i = 0; i < BENCH_BOTS; i++) SDL_WaitThread(threads[i], NULL);
+    const double t1 = Now();
+    for(int32_t i = 0; i < shards; i++)
+        busy += (uint32_t) SDL_AtomicGet(&host->shard[i]->busy);
+    int32_t turns = 0;
+    for(int32_t i = 0; i < BENCH_BOTS; i++)
+        turns += bots[i].turns;
+    for(int32_t i = 0; i < clients; i++)
+        Sock_Disconnect(sock[i]);
+    Host_Stop(host);
+    const double cores = (busy / 1e6) / (t1 - t0);
+    printf("matches %4d x %d users on %d shards :: turns %7.1f /s :: shard load %6.3f cores :: %8.0f matches per core\n",
+        matches, users, shards, turns / (t1 - t0), cores, matches / cores);
+    free(sock);
+}
+
+#define BENCH_TURNS (4096)
+#define BENCH_TRANSPORT_SECONDS (6)
+#define BENCH_TRANSPORT_USERS (4)
+
+typedef struct
+{
+    Poll poll;
+    bool udp;
+    bool rollback;
+    bool spectate;
+    int32_t delay;
+    int32_t compress;
+    SDL_atomic_t* sent;
+    SDL_atomic_t turn;
+    SDL_atomic_t lead;
+    SDL_atomic_t late;
+    SDL_atomic_t done;
+    SDL_atomic_t relay_us;
+    SDL_atomic_t watching;
+    SDL_atomic_t streamed;
+    SDL_Thread* thread;
+    double epoch;
+}
+Server;
+
+static int32_t Micros(const Server* const server)
+{
+    return (int32_t) ((Now() - server->epoch) * 1e6);
+}
+
+// THE SERVER LOOP OF MAIN, STAMPING THE TIME EACH TURN LEFT.
+static int32_t Serve(void* const data)
+{
+    Server* const server = (Server*) data;
+    Sockets sockets = Sockets_Init(BENCH_PORT, BENCH_TRANSPORT_USERS);
+    if(server->udp)
+        sockets = Sockets_EnableUdp(sockets, BENCH_PORT);
+    sockets.is_rollback = server->rollback;
+    if(server->compress > CODEC_OFF)
+        sockets = Sockets_EnableCompression(sockets, server->compress);
+    if(server->spectate)
+        sockets = Sockets_EnableSpectators(sockets, BENCH_PORT + SPECTATORS_PORT_OFFSET, server->delay);
+    sockets = Sockets_Watch(sockets, server->poll, 0);
+    while(!SDL_AtomicGet(&server->done))
+    {
+        int32_t tags[POLL_EVENTS_MAX];
+        const int32_t count = Poll_Wait(server->poll, tags);
+        for(int32_t i = 0; i < count; i++)
+        {
+            const int32_t tag = tags[i];
+            if(tag == POLL_TIMER)
+            {
+                const int32_t sent = Micros(server);
+                SDL_AtomicSet(&server->sent[sockets.turn % BENCH_TURNS], sent);
+                sockets = Sockets_Relay(sockets, true);
+                SDL_AtomicAdd(&server->relay_us, Micros(server) - sent);
+                SDL_AtomicSet(&server->turn, sockets.turn);
+                SDL_AtomicSet(&server->lead, sockets.lead->cycles);
+                SDL_AtomicSet(&server->late, Lead_GetLateRate(sockets.lead));
+                SDL_AtomicSet(&server->watching, sockets.spectators ? sockets.spectators->count : 0);
+                SDL_AtomicSet(&server->streamed, sockets.spectators ? sockets.spectators->base + sockets.spectators->size : 0);
+            }
+            else if(tag == COLOR_COUNT)
+                sockets = Sockets_Accept(sockets);
+            else if(tag == COLOR_COUNT + 1)
+                sockets = Sockets_ReadDatagrams(sockets);
+            else if(tag == COLOR_COUNT + 2)
+                Sockets_AcceptSpectator(sockets);
+            else if(tag >= 0)
+                sockets = Sockets_Read(sockets, tag);
+        }
+    }
+    Sockets_Free(sockets);
+    return 0;
+}
+
+// THE FLAGS OF THE SERVER ARE SET BEFORE IT STARTS. THE SHIM IS STARTED AFRESH, SO NOTHING A BENCH
+// BEFORE LEFT QUEUED IS DELIVERED, AND THE CLIENTS ONLY CONNECT ONCE THE SERVER IS LISTENING.
+static void StartServer(Server* const server, const Impair impair)
+{
+    server->poll = Poll_Make(CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS);
+    server->epoch = Now();
+    server->sent = UTIL_ALLOC(SDL_atomic_t, BENCH_TURNS);
+    Shim_Stop();
+    Shim_Start(impair);
+    server->thread = SDL_CreateThread(Serve, "N/A", server);
+    SDL_Delay(100);
+}
+
+static void StopServer(Server* const server)
+{
+    SDL_AtomicSet(&server->done, true);
+    Poll_Wake(server->poll);
+    SDL_WaitThread(server->thread, NULL);
+    Shim_Stop();
+    Poll_Free(server->poll);
+    free(server->sent);
+}
+
+static int CompareInt(const void* const a, const void* const b)
+{
+    return *(const int32_t*) a - *(const int32_t*) b;
+}
+
+static Impair MakeImpair(const int32_t delay_ms, const int32_t jitter_ms, const int32_t loss, const int32_t duplicate, const int32_t reorder, const int32_t rate_kbps)
+{
+    static Impair zero;
+    Impair impair = zero;
+    impair.delay_ms = delay_ms;
+    impair.jitter_ms = jitter_ms;
+    impair.loss = loss;
+    impair.duplicate = duplicate;
+    impair.reorder = reorder;
+    impair.rate_kbps = rate_kbps;
+    impair.seed = 1;
+    return impair;
+}
+
+// TURN LATENCY IS FROM THE SERVER RELAYING A TURN TO A CLIENT DECODING IT. THE CLIENTS SEND
+// HEARTBEATS LIKE THE GAME LOOP BUT POLL EVERY MILLISECOND TO TIME ARRIVALS CLOSELY.
+// SERVER AND CLIENTS SHARE THE PROCESS, SO THE SHIM IMPAIRS BOTH DIRECTIONS.
+//
+// TURNS RELAYED BEFORE EVERY CLIENT HAD JOINED ARE NOT COUNTED. A STALL IS A GAP BETWEEN TWO TURNS WELL OVER THE TURN INTERVAL, COUNTED BY WHAT IT ADDS TO
+// THE INTERVAL. THE BACKLOG IS HOW MANY TURNS A CLIENT TRAILED THE SERVER BY AT WORST, AND THE
+// BURST IS HOW MANY TURNS ARRIVED AT ONCE WHEN IT CAUGHT UP.
+static void Transport(const char* const name, const Impair impair, const bool udp)
+{
+    static Server zero;
+    Server server = zero;
+    server.udp = udp;
+    StartServer(&server, impair);
+    Sock sock[BENCH_TRANSPORT_USERS];
+    int32_t last_turn[BENCH_TRANSPORT_USERS];
+    double last_time[BENCH_TRANSPORT_USERS];
+    int32_t burst[BENCH_TRANSPORT_USERS];
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        sock[i] = Sock_Join(Sock_Connect("localhost", BENCH_PORT), 0, BENCH_TRANSPORT_USERS);
+        last_turn[i] = 0;
+        last_time[i] = 0.0;
+        burst[i] = 0;
+    }
+    const int32_t max = BENCH_TRANSPORT_USERS * BENCH_TRANSPORT_SECONDS * 1000 / CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS + 64;
+    int32_t* const latency = UTIL_ALLOC(int32_t, max);
+    int32_t count = 0;
+    int32_t stalls = 0;
+    double stall_ms = 0.0;
+    int32_t backlog = 0;
+    int32_t burst_max = 0;
+    Overview overview = Overview_Init(0, 0);
+    const double t0 = Now();
+    const int32_t start = Micros(&server);
+    double uplink = t0;
+    for(int32_t cycles = 1; Now() - t0 < BENCH_TRANSPORT_SECONDS;)
+    {
+        const bool is_frame = Now() >= uplink;
+        if(is_frame)
+        {
+            overview.cycles = cycles++;
+            uplink += CONFIG_MAIN_LOOP_SPEED_MS / 1000.0;
+        }
+        for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+        {
+            if(is_frame && overview.cycles % BENCH_BEAT == 0)
+            {
+                overview.ping = Rtt_GetLast(sock[i].rtt);
+                Sock_SendHeartbeat(sock[i], overview);
+            }
+            for(Packet packet = Packet_Get(sock[i]); packet.turn > 0; packet = Packet_Get(sock[i]))
+            {
+                const double now = Now();
+                const int32_t sent = SDL_AtomicGet(&server.sent[packet.turn % BENCH_TURNS]);
+                last_turn[i] = packet.turn;
+                if(sent < start)
+                    continue;
+                if(count < max)
+                    latency[count++] = Micros(&server) - sent;
+                const double gap_ms = (now - last_time[i]) * 1e3;
+                if(last_time[i] > 0.0 && gap_ms > 1.5 * CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS)
+                {
+                    stalls += 1;
+                    stall_ms += gap_ms - CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS;
+                }
+                burst[i] = gap_ms < 2.0 ? burst[i] + 1 : 1;
+                burst_max = UTIL_MAX(burst_max, burst[i]);
+                last_time[i] = now;
+            }
+            if(last_turn[i] > 0)
+                backlog = UTIL_MAX(backlog, SDL_AtomicGet(&server.turn) - 1 - last_turn[i]);
+        }
+        SDL_Delay(1);
+    }
+    int32_t resends = 0;
+    int32_t rtt = 0;
+    int32_t jitter = 0;
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        if(sock[i].link)
+            resends += sock[i].link->resends;
+        rtt += Rtt_GetSmooth(sock[i].rtt);
+        jitter += Rtt_GetJitter(sock[i].rtt);
+        Sock_Disconnect(sock[i]);
+    }
+    StopServer(&server);
+    UTIL_SORT(latency, count, CompareInt);
+    const int32_t expected = BENCH_TRANSPORT_USERS * BENCH_TRANSPORT_SECONDS * 1000 / CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS;
+    if(count == 0)
+        Util_Bomb("BENCH :: NO TURNS ARRIVED\n");
+    printf("transport %-6s %s :: turns %4d of ~%d :: p50 %7.2f ms :: p99 %7.2f ms :: max %7.2f ms :: stalls %3d, %6.0f ms per client :: backlog %2d turns :: burst %2d :: rtt %3d +- %2d ms :: lead %2d cycles, %3d/1000 late :: resends %d\n",
+        name, udp ? "udp" : "tcp", count, expected,
+        latency[count / 2] / 1e3, latency[(count * 99) / 100] / 1e3, latency[count - 1] / 1e3,
+        stalls, stall_ms / BENCH_TRANSPORT_USERS, backlog, burst_max,
+        rtt / BENCH_TRANSPORT_USERS, jitter / BENCH_TRANSPORT_USERS,
+        SDL_AtomicGet(&server.lead), SDL_AtomicGet(&server.late), resends);
+    free(latency);
+}
+
+#define BENCH_CLOCK_STAGGER_MS (700)
+#define BENCH_CLOCK_SECONDS (8)
+
+// CLIENTS START THEIR SIMULATIONS STAGGERED, SO THE LAST ONE STARTS WELL BEHIND THE OTHERS, AND
+// EACH FRAME RUNS THE TICKS ITS CLOCK ALLOWS. THE SPREAD IS HOW FAR APART THE FURTHEST TWO CLIENTS
+// ARE, AND IT HAS CONVERGED ONCE IT STAYS WITHIN TWO CYCLES.
+static void Timeline(const char* const name, const Impair impair)
+{
+    static Server zero;
+    Server server = zero;
+    StartServer(&server, impair);
+    Sock sock[BENCH_TRANSPORT_USERS];
+    Clock clock[BENCH_TRANSPORT_USERS];
+    int32_t cycles[BENCH_TRANSPORT_USERS];
+    bool started[BENCH_TRANSPORT_USERS];
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        sock[i] = Sock_Join(Sock_Connect("localhost", BENCH_PORT), 0, BENCH_TRANSPORT_USERS);
+        cycles[i] = 0;
+        started[i] = false;
+    }
+    Overview overview = Overview_Init(0, 0);
+    const double t0 = Now();
+    const double last_start = t0 + (BENCH_TRANSPORT_USERS - 1) * BENCH_CLOCK_STAGGER_MS / 1000.0;
+    int32_t spread_start = -1;
+    double converged = -1.0;
+    int32_t ticks_max = 0;
+    int32_t idle = 0;
+    int32_t frames = 0;
+    int32_t beats = 0;
+    for(double frame = t0; Now() - t0 < BENCH_CLOCK_SECONDS; frame += CONFIG_MAIN_LOOP_SPEED_MS / 1000.0, beats++)
+    {
+        while(Now() < frame)
+            SDL_Delay(1);
+        const uint32_t now = SDL_GetTicks();
+        for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+        {
+            const double start = t0 + i * BENCH_CLOCK_STAGGER_MS / 1000.0;
+            if(frame < start)
+                continue;
+            if(!started[i])
+            {
+                clock[i] = Clock_Make(now);
+                started[i] = true;
+            }
+            for(Packet packet = Packet_Get(sock[i]); packet.turn > 0; packet = Packet_Get(sock[i]))
+                clock[i] = Clock_Observe(clock[i], packet.setpoint, Rtt_GetSmooth(sock[i].rtt));
+            clock[i] = Clock_Advance(clock[i], cycles[i], now);
+            cycles[i] += clock[i].ticks;
+            if(converged >= 0.0)
+            {
+                ticks_max = UTIL_MAX(ticks_max, clock[i].ticks);
+                idle += clock[i].ticks == 0;
+                frames += 1;
+            }
+            if(beats % BENCH_BEAT == 0)
+            {
+                overview.cycles = cycles[i];
+                overview.ping = Rtt_GetLast(sock[i].rtt);
+                Sock_SendHeartbeat(sock[i], overview);
+            }
+        }
+        if(frame >= last_start)
+        {
+            int32_t low = cycles[0];
+            int32_t high = cycles[0];
+            for(int32_t i = 1; i < BENCH_TRANSPORT_USERS; i++)
+            {
+                low = UTIL_MIN(low, cycles[i]);
+                high = UTIL_MAX(high, cycles[i]);
+            }
+            if(spread_start == -1)
+                spread_start = high - low;
+            if(high - low > 2)
+                converged = -1.0;
+            else if(converged < 0.0)
+                converged = frame - last_start;
+        }
+    }
+    int32_t low = cycles[0];
+    int32_t high = cycles[0];
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        low = UTIL_MIN(low, cycles[i]);
+        high = UTIL_MAX(high, cycles[i]);
+        Sock_Disconnect(sock[i]);
+    }
+    StopServer(&server);
+    printf("clock %-6s :: spread %3d cycles at the last start :: converged %5.2f s :: final spread %d :: then at most %d ticks and %4.1f%% idle frames\n",
+        name, spread_start, converged, high - low, ticks_max, frames > 0 ? 100.0 * idle / frames : 0.0);
+}
+
+#define BENCH_DESYNC_CYCLE (150)
+#define BENCH_DESYNC_CLIENT (2)
+#define BENCH_DESYNC_REGION (5)
+#define BENCH_DESYNC_SECONDS (15)
+
+// A STAND IN FOR A SIMULATION: EVERY ASPECT HASHES THE CYCLE, AND ONE CLIENT STARTS GETTING ITS PATHS
+// WRONG IN ONE REGION AT A KNOWN CYCLE.
+static Parity Fake(const int32_t cycles, const bool is_wrong)
+{
+    static Parity zero;
+    Parity parity = zero;
+    parity.cycles = cycles;
+    uint64_t aspect[ASPECT_COUNT];
+    for(int32_t i = 0; i < ASPECT_COUNT; i++)
+        aspect[i] = Parity_Mix(0, cycles, i);
+    Parity_Add(&parity, 0, aspect);
+    if(is_wrong)
+    {
+        uint64_t wrong[ASPECT_COUNT] = { 0 };
+        wrong[ASPECT_PATH] = Parity_Mix(1, cycles, ASPECT_PATH);
+        Parity_Add(&parity, BENCH_DESYNC_REGION, wrong);
+    }
+    return Parity_Seal(parity);
+}
+
+// CLIENTS PLAY IN STEP, ANSWER PROBES LIKE THE GAME LOOP, AND STOP AT THE DESYNC THE SERVER FINDS.
+static void Hunt(const char* const name, const Impair impair)
+{
+    static Server zero;
+    Server server = zero;
+    StartServer(&server, impair);
+    Sock sock[BENCH_TRANSPORT_USERS];
+    Parities parities[BENCH_TRANSPORT_USERS];
+    int32_t probed[BENCH_TRANSPORT_USERS];
+    Packet found[BENCH_TRANSPORT_USERS];
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        static Packet none;
+        sock[i] = Sock_Join(Sock_Connect("localhost", BENCH_PORT), 0, BENCH_TRANSPORT_USERS);
+        parities[i] = Parities_Make(CONFIG_PARITY_HISTORY);
+        probed[i] = 0;
+        found[i] = none;
+    }
+    Overview overview = Overview_Init(0, 0);
+    const double t0 = Now();
+    double wrong_at = 0.0;
+    double found_at = 0.0;
+    int32_t probes = 0;
+    for(int32_t cycles = 0; Now() - t0 < BENCH_DESYNC_SECONDS && found_at == 0.0; cycles++)
+    {
+        if(cycles == BENCH_DESYNC_CYCLE)
+            wrong_at = Now();
+        for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+        {
+            const bool is_wrong = i == BENCH_DESYNC_CLIENT && cycles >= BENCH_DESYNC_CYCLE;
+            if(Parity_IsCheckpoint(cycles))
+                Parities_Put(parities[i], Fake(cycles, is_wrong));
+            for(Packet packet = Packet_Get(sock[i]); packet.turn > 0; packet = Packet_Get(sock[i]))
+            {
+                if(packet.probe > 0 && packet.probe != probed[i])
+                {
+                    Sock_SendParity(sock[i], Parities_Get(parities[i], packet.probe));
+                    probed[i] = packet.probe;
+                    probes += i == 0;
+                }
+                if(packet.desync > 0 && found[i].desync == 0)
+                {
+                    found[i] = packet;
+                    found_at = Now();
+                }
+            }
+            if(cycles % BENCH_BEAT == 0)
+            {
+                const Parity parity = Parities_Get(parities[i], Parity_GetCheckpoint(cycles));
+                overview.cycles = cycles;
+                overview.parity = parity.root;
+                overview.parity_cycles = parity.cycles;
+                overview.ping = Rtt_GetLast(sock[i].rtt);
+                Sock_SendHeartbeat(sock[i], overview);
+            }
+        }
+        SDL_Delay(CONFIG_MAIN_LOOP_SPEED_MS);
+    }
+    Packet result = found[0];
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        if(found[i].desync > 0)
+            result = found[i];
+        Parities_Free(parities[i]);
+        Sock_Disconnect(sock[i]);
+    }
+    StopServer(&server);
+    printf("desync %-6s :: wrong from cycle %d :: found checkpoint %d, expected %d, in %.2f s after %d probes :: regions 0x%04X, expected 0x%04X\n",
+        name, BENCH_DESYNC_CYCLE, result.desync, Parity_GetCheckpoint(BENCH_DESYNC_CYCLE + CONFIG_PARITY_INTERVAL - 1), found_at > 0.0 ? found_at - wrong_at : -1.0, probes,
+        result.desync_regions, 1u << BENCH_DESYNC_REGION);
+}
+
+#define BENCH_REJOIN_CLIENT (BENCH_TRANSPORT_USERS - 1)
+#define BENCH_REJOIN_DROP (60)
+#define BENCH_REJOIN_AFTER (64)
+#define BENCH_REJOIN_SECONDS (30)
+
+typedef struct
+{
+    Sock sock;
+    Units units;
+    Packets packets;
+    Parities parities;
+    Transfer donation;
+    int32_t asked;
+    int32_t newest;
+    double last;
+    double gap;
+    bool is_playing;
+}
+Player;
+
+static Player Arrive(const int32_t count, const Grid grid)
+{
+    static Player zero;
+    Player player = zero;
+    player.sock = Sock_Join(Sock_Connect("localhost", BENCH_PORT), 0, BENCH_TRANSPORT_USERS);
+    player.units = Units_New(grid, 1, count, COLOR_BLU, CIV_NORTH_EUROPE);
+    player.packets = Packets_Init();
+    player.parities = Parities_Make(CONFIG_PARITY_HISTORY);
+    player.donation = Transfer_Make();
+    return player;
+}
+
+static void Depart(const Player player)
+{
+    Sock_Disconnect(player.sock);
+    Units_Free(player.units);
+    Packets_Free(player.packets);
+    Parities_Free(player.parities);
+    Transfer_Free(player.donation);
+}
+
+// THE PACKET LOOP OF PLAY. THE WORST GAP BETWEEN TWO TURNS IS WHAT A STALLED RELAY WOULD SHOW.
+static Player Listen(Player player)
+{
+    for(Packet packet = Packet_Get(player.sock); packet.turn > 0; packet = Packet_Get(player.sock))
+    {
+        const double now = Now();
+        if(player.last > 0.0)
+            player.gap = UTIL_MAX(player.gap, now - player.last);
+        player.last = now;
+        if(Packet_IsStable(packet))
+        {
+            player.packets = Packets_Queue(player.packets, &packet);
+            player.newest = UTIL_MAX(player.newest, packet.exec_cycle);
+        }
+        if(packet.snapshot != player.asked)
+        {
+            player.donation = Transfer_Stop(player.donation);
+            player.asked = packet.snapshot;
+        }
+    }
+    return player;
+}
+
+// THE TICK OF PLAY WITH A STAND IN FOR THE SIMULATION, WHERE EVERY TURN NUDGES ONE UNIT. LIKE PLAY,
+// IT HOLDS AT THE NEWEST STABLE TURN ONCE ONE HAS COME.
+static Player Tick(Player player)
+{
+    if(player.newest > 0 && player.units.cycles >= player.newest)
+        return player;
+    Units units = player.units;
+    player.packets = Packets_Skip(player.packets, units.cycles);
+    if(player.asked > 0 && !player.donation.is_active && units.cycles >= player.asked)
+    {
+        player.donation = Transfer_Begin(player.donation, units.cycles, 0);
+        player.donation.snapshot = Units_Snapshot(units, player.donation.snapshot);
+    }
+    for(const Packet* turn = Packets_Find(player.packets, units.cycles); turn; turn = Packets_Find(player.packets, units.cycles))
+    {
+        units.unit[turn->turn % units.count].cell.x += turn->turn;
+        player.packets = Packets_Pop(player.packets);
+    }
+    units.cycles++;
+    if(Parity_IsCheckpoint(units.cycles))
+        Parities_Put(player.parities, Units_Parity(units));
+    player.units = units;
+    return player;
+}
+
+// ONE CLIENT DROPS A SECOND INTO THE MATCH AND COMES BACK WITH NOTHING. THE OTHERS KEEP PLAYING, ONE OF
+// THEM DONATES A SNAPSHOT, AND THE RETURNING CLIENT FAST FORWARDS THROUGH THE BACKLOG HEADLESS. IT HAS
+// REJOINED IF, SOME CYCLES AFTER CATCHING UP, EVERY CLIENT STILL HAS THE SAME PARITY. THE FAST FORWARD
+// GETS WHAT IS LEFT OF EACH FRAME, LIKE PLAY. THE FRAMES ARE NOT MADE UP FOR THE TIME THE RECONNECT
+// BLOCKED, AND THE TURN GAPS ARE ONLY MEASURED FROM THEN ON.
+static void Return(const int32_t count, const char* const name, const Impair impair)
+{
+    static Server zero;
+    Server server = zero;
+    StartServer(&server, impair);
+    const int32_t side = Fixed_Sqrt(count / 4) + 1;
+    const Grid grid = Grid_Make(side, side, 96, 48);
+    Player player[BENCH_TRANSPORT_USERS];
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        player[i] = Arrive(count, grid);
+        player[i].units = Populate(player[i].units, grid);
+        player[i].is_playing = true;
+    }
+    Player* const back = &player[BENCH_REJOIN_CLIENT];
+    Overview overview = Overview_Init(0, 0);
+    double dropped = 0.0;
+    double restored = 0.0;
+    double caught_up = 0.0;
+    int32_t snapshot_cycle = 0;
+    int32_t behind = 0;
+    int32_t beats = 0;
+    const double t0 = Now();
+    for(double frame = t0; Now() - t0 < BENCH_REJOIN_SECONDS; frame += CONFIG_MAIN_LOOP_SPEED_MS / 1000.0, beats++)
+    {
+        while(Now() < frame)
+            SDL_Delay(1);
+        const int32_t lead = player[0].units.cycles;
+        if(caught_up > 0.0 && back->units.cycles >= snapshot_cycle + behind + BENCH_REJOIN_AFTER)
+            break;
+        if(dropped == 0.0 && lead == BENCH_REJOIN_DROP)
+        {
+            Depart(*back);
+            SDL_Delay(200);
+            dropped = Now();
+            *back = Arrive(count, grid);
+            for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+                player[i].gap = player[i].last = 0.0;
+            frame = Now();
+        }
+        for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+        {
+            Player* const at = &player[i];
+            *at = Listen(*at);
+            if(!at->is_playing && Transfer_IsDone(*at->sock.transfer))
+            {
+                at->units = Units_Restore(at->units, at->sock.transfer->snapshot);
+                Parities_Put(at->parities, Units_Parity(at->units));
+                at->newest = at->units.cycles;
+                at->is_playing = true;
+                restored = Now();
+                snapshot_cycle = at->units.cycles;
+                behind = lead - snapshot_cycle;
+                // THE BACKLOG CAME IN BEHIND THE LAST CHUNK.
+                *at = Listen(*at);
+            }
+            if(at->is_playing)
+            {
+                *at = Tick(*at);
+                while(at == back
+                && at->units.cycles < UTIL_MIN(lead, at->newest)
+                && Now() - frame < CONFIG_MAIN_LOOP_SPEED_MS / 1000.0)
+                    *at = Tick(*at);
+                if(at == back && restored > 0.0 && caught_up == 0.0 && at->units.cycles >= lead)
+                    caught_up = Now();
+            }
+            Sock_SendSnapshot(at->sock, &at->donation, CONFIG_SOCKETS_REJOIN_CHUNKS);
+            if(beats % BENCH_BEAT == 0)
+            {
+                const Parity parity = Parities_Get(at->parities, Parity_GetCheckpoint(at->units.cycles));
+                overview.cycles = at->units.cycles;
+                overview.parity = parity.root;
+                overview.parity_cycles = parity.cycles;
+                overview.ping = Rtt_GetLast(at->sock.rtt);
+                Sock_SendHeartbeat(at->sock, overview);
+            }
+        }
+    }
+    int32_t common = player[0].units.cycles;
+    double gap = 0.0;
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        common = UTIL_MIN(common, player[i].units.cycles);
+        if(i != BENCH_REJOIN_CLIENT)
+            gap = UTIL_MAX(gap, player[i].gap);
+    }
+    const int32_t checkpoint = Parity_GetCheckpoint(common);
+    const uint64_t root = Parities_Get(player[0].parities, checkpoint).root;
+    bool same = caught_up > 0.0;
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        same = same && Parities_Get(player[i].parities, checkpoint).root == root;
+        Depart(player[i]);
+    }
+    StopServer(&server);
+    printf("rejoin %-6s %6d units :: snapshot at cycle %3d through %5.2f s after the drop :: %3d cycles caught up in %5.3f s :: worst turn gap %4.0f ms :: %s\n",
+        name, count, snapshot_cycle, restored > 0.0 ? restored - dropped : -1.0, behind,
+        caught_up > 0.0 ? caught_up - restored : -1.0, 1e3 * gap, same ? "in sync" : "OUT OF SYNC");
+}
+
+// A PLAYER BOXES ONE OF ITS OWN UNITS, WITH THE VIEW CENTERED ON IT, AND SENDS IT A FEW TILES AWAY.
+static Overview Order(uint32_t* const seed, const Units units, const Grid grid, const Color color)
+{
+    Overview overview = Overview_Init(1024, 768);
+    overview.share.color = color;
+    Unit* chosen = NULL;
+    for(int32_t i = 0, pick = Spread(seed, units.count); i < units.count; i++)
+    {
+        Unit* const unit = &units.unit[(pick + i) % units.count];
+        if(unit->color == color && unit->trait.max_speed > 0 && !unit->trait.is_inanimate)
+        {
+            chosen = unit;
+            break;
+        }
+    }
+    if(chosen == NULL)
+        return overview;
+    const Point iso = Overview_CartToIso(overview, grid, chosen->cart);
+    overview.pan.x = iso.x - overview.xres / 2;
+    overview.pan.y = iso.y - overview.yres / 2;
+    const Point center = { overview.xres / 2, overview.yres / 2 };
+    const Point corner = { 48, 48 };
+    overview.selection_box.a = Point_Sub(center, corner);
+    overview.selection_box.b = Point_Add(center, corner);
+    const Point goal = {
+        UTIL_MIN(UTIL_MAX(chosen->cart.x + Spread(seed, 17) - 8, 0), grid.cols - 1),
+        UTIL_MIN(UTIL_MAX(chosen->cart.y + Spread(seed, 17) - 8, 0), grid.rows - 1),
+    };
+    overview.mouse_cursor = Overview_CartToIso(overview, grid, goal);
+    overview.event.mouse_lu = true;
+    overview.event.mouse_ru = true;
+    return overview;
+}
+
+#define BENCH_ROLLBACK_SECONDS (8)
+#define BENCH_ROLLBACK_START (40)
+#define BENCH_ROLLBACK_EVERY (12)
+#define BENCH_ROLLBACK_COMMANDS (1024)
+
+typedef struct
+{
+    Sock sock;
+    Units units;
+    Parities parities;
+    Rollback* rollback;
+    int32_t cycles;
+    int32_t issued[BENCH_ROLLBACK_COMMANDS];
+    int32_t commands;
+    int32_t seen;
+    int32_t waited;
+    uint32_t seed;
+}
+Seer;
+
+// THE PREDICTED TICK OF PLAY, ON STAND IN GRAPHICS.
+static Units Foresee(Units units, Rollback* const rollback, const Parities parities, const Registrar graphics, const Grid grid, const Map map)
+{
+    Rollback_Save(rollback, units);
+    const Field field = Units_Field(units, map);
+    int32_t index = 0;
+    for(const Packet* packet = Rollback_Next(rollback, units.cycles, &index); packet; packet = Rollback_Next(rollback, units.cycles, &index))
+        units = Units_PacketService(units, graphics, *packet, grid, map, field);
+    units = Units_Caretake(units, graphics, grid, map, field);
+    Field_Free(field);
+    if(Parity_IsCheckpoint(units.cycles))
+        Parities_Put(parities, Units_Parity(units));
+    return units;
+}
+
+// AS PLAY CATCHES UP AFTER A REWIND.
+static Units CatchUp(Units units, Rollback* const rollback, const int32_t present, const Parities parities, const Registrar graphics, const Grid grid, const Map map)
+{
+    const double t0 = Now();
+    units = Rollback_Rewind(rollback, units);
+    const bool is_redoing = Rollback_IsRedoing(rollback, units);
+    double spent = 0.0;
+    double tick = 0.0;
+    while(units.cycles < present && (spent == 0.0 || spent + tick <= CONFIG_ROLLBACK_RESIM_MS))
+    {
+        units = Foresee(units, rollback, parities, graphics, grid, map);
+        const double ms = 1e3 * (Now() - t0);
+        tick = UTIL_MAX(tick, ms - spent);
+        spent = ms;
+    }
+    if(is_redoing)
+        Rollback_Count(rollback, spent);
+    return units;
+}
+
+// EVERY CLIENT NOW AND THEN BOXES ONE OF ITS UNITS AND SENDS IT OFF, AND SEES IT WHEN ITS UNITS NEXT
+// TICK. THE TURN CARRYING THE COMMAND ARRIVES LATER, FOR A CYCLE THE CLIENTS HAVE ALREADY SIMULATED,
+// AND THE CYCLES FROM THE COMMAND TO ITS TURN ARE THE LEAST LOCKSTEP WOULD HAVE KEPT IT WAITING. A
+// SLOT'S COMMANDS ARE RELAYED IN THE ORDER SENT. ALL CLIENTS SHARE ONE THREAD, SO WITH MANY UNITS THE
+// FRAMES RUN LATE, BUT EACH CLIENT'S RESIMULATION A FRAME IS TIMED ON ITS OWN. THE CLIENTS ARE IN SYNC
+// IF THEY AGREE ON THE LAST CHECKPOINT ALL OF THEM CONFIRMED.
+static void Predict(const int32_t count, const char* const name, const Impair impair)
+{
+    static Server zero;
+    Server server = zero;
+    server.rollback = true;
+    StartServer(&server, impair);
+    const Registrar terrain = Registrar_StubTerrain();
+    const Registrar graphics = Registrar_StubGraphics();
+    const Map map = Map_Make(Fixed_Sqrt(count / 4) + 1, terrain);
+    const Grid grid = Grid_Make(map.cols, map.rows, map.tile_width, map.tile_height);
+    Unit_SetNextId(count);
+    Seer* const seer = UTIL_ALLOC(Seer, BENCH_TRANSPORT_USERS);
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        seer[i].sock = Sock_Join(Sock_Connect("localhost", BENCH_PORT), 0, BENCH_TRANSPORT_USERS);
+        seer[i].units = Populate(Units_New(grid, SDL_GetCPUCount(), count, COLOR_BLU, CIV_NORTH_EUROPE), grid);
+        seer[i].parities = Parities_Make(CONFIG_PARITY_HISTORY);
+        seer[i].rollback = Rollback_Make((Color) i, NULL);
+        seer[i].seed = i + 1;
+        Parities_Put(seer[i].parities, Units_Parity(seer[i].units));
+        Rollback_Reset(seer[i].rollback, seer[i].units);
+    }
+    int32_t frames = 0;
+    const double t0 = Now();
+    for(double frame = t0; Now() - t0 < BENCH_ROLLBACK_SECONDS; frame += CONFIG_MAIN_LOOP_SPEED_MS / 1000.0, frames++)
+    {
+        while(Now() < frame)
+            SDL_Delay(1);
+        for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+        {
+            Seer* const at = &seer[i];
+            const int32_t cycles = at->cycles;
+            const bool is_commanding = cycles > BENCH_ROLLBACK_START
+                && frames % BENCH_ROLLBACK_EVERY == i
+                && at->commands < BENCH_ROLLBACK_COMMANDS;
+            Overview overview = is_commanding
+                ? Order(&at->seed, at->units, grid, (Color) i)
+                : Overview_Init(0, 0);
+            overview.share.color = (Color) i;
+            if(Overview_UsedAction(overview))
+            {
+                at->issued[at->commands] = cycles;
+                overview.sequence = ++at->commands;
+                Sock_SendCommand(at->sock, overview);
+                Rollback_Guess(at->rollback, overview, cycles);
+            }
+            for(Packet packet = Packet_Get(at->sock); packet.turn > 0; packet = Packet_Get(at->sock))
+            {
+                const int32_t sequence = packet.overview[i].sequence;
+                if(Packet_IsStable(packet) && Overview_UsedAction(packet.overview[i]) && sequence > 0 && sequence <= at->commands)
+                {
+                    at->waited += cycles - at->issued[sequence - 1];
+                    at->seen++;
+                }
+                Rollback_Turn(at->rollback, packet, at->units.cycles);
+            }
+            if(Rollback_CanAdvance(at->rollback, at->cycles))
+                at->cycles++;
+            at->units = CatchUp(at->units, at->rollback, at->cycles, at->parities, graphics, grid, map);
+            if(frames % BENCH_BEAT == 0)
+            {
+                const int32_t confirmed = Rollback_GetConfirmed(at->rollback, at->units.cycles);
+                const Parity parity = Parities_Get(at->parities, Parity_GetCheckpoint(confirmed));
+                overview = Overview_Init(0, 0);
+                overview.share.color = (Color) i;
+                overview.cycles = at->cycles;
+                overview.parity = parity.root;
+                overview.parity_cycles = parity.cycles;
+                overview.ping = Rtt_GetLast(at->sock.rtt);
+                Sock_SendHeartbeat(at->sock, overview);
+            }
+        }
+    }
+    int32_t common = seer[0].units.cycles;
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+        common = UTIL_MIN(common, Rollback_GetConfirmed(seer[i].rollback, seer[i].units.cycles));
+    static Rollback none;
+    Rollback all = none;
+    int32_t commands = 0;
+    int32_t seen = 0;
+    int32_t waited = 0;
+    const int32_t checkpoint = Parity_GetCheckpoint(common);
+    const uint64_t root = Parities_Get(seer[0].parities, checkpoint).root;
+    bool same = true;
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        const Rollback* const rollback = seer[i].rollback;
+        all.rollbacks += rollback->rollbacks;
+        all.depth += rollback->depth;
+        all.depth_max = UTIL_MAX(all.depth_max, rollback->depth_max);
+        all.frames += rollback->frames;
+        all.resim_ms += rollback->resim_ms;
+        all.resim_ms_max = UTIL_MAX(all.resim_ms_max, rollback->resim_ms_max);
+        all.stalls += rollback->stalls;
+        commands += seer[i].commands;
+        seen += seer[i].seen;
+        waited += seer[i].waited;
+        same = same && Parities_Get(seer[i].parities, checkpoint).root == root;
+        Rollback_Free(seer[i].rollback);
+        Parities_Free(seer[i].parities);
+        Units_Free(seer[i].units);
+        Sock_Disconnect(seer[i].sock);
+    }
+    free(seer);
+    Map_Free(map);
+    Registrar_Free(terrain);
+    Registrar_Free(graphics);
+    StopServer(&server);
+    const int32_t rollbacks = UTIL_MAX(1, all.rollbacks);
+    printf("rollback %-5s %6d units :: %3d commands seen next tick, lockstep would wait %4.1f cycles :: %4d rollbacks :: depth %4.1f mean %2d max :: resim %6.3f ms mean %6.3f ms max a frame over %4d frames :: %d stalls :: cycle %d %s\n",
+        name, count, commands, waited / (double) UTIL_MAX(1, seen), all.rollbacks,
+        all.depth / (double) rollbacks, all.depth_max, all.resim_ms / UTIL_MAX(1, all.frames), all.resim_ms_max, all.frames, all.stalls,
+        common, same ? "in sync" : "OUT OF SYNC");
+}
+
+#define BENCH_SPECTATE_UNITS (1000)
+#define BENCH_SPECTATE_DELAY (20)
+#define BENCH_SPECTATE_ARRIVE (3)
+#define BENCH_SPECTATE_SECONDS (16)
+#define BENCH_SPECTATE_STALLED_UNITS (20000)
+
+// A SPECTATOR IS A PLAYER THAT NEVER SENDS, AND TICKS ONLY UP TO THE NEWEST TURN IN HAND.
+static Player Attend(const int32_t units, const Grid grid)
+{
+    static Player zero;
+    Player player = zero;
+    player.sock = Sock_Connect("localhost", BENCH_PORT + SPECTATORS_PORT_OFFSET);
+    player.units = Units_New(grid, 1, units, COLOR_BLU, CIV_NORTH_EUROPE);
+    player.packets = Packets_Init();
+    player.parities = Parities_Make(CONFIG_PARITY_HISTORY);
+    player.donation = Transfer_Make();
+    return player;
+}
+
+// FOUR CLIENTS PLAY WHILE THE GIVEN NUMBER OF SPECTATORS ARRIVE A FEW SECONDS IN, EACH STARTING FROM
+// THE NEWEST KEYFRAME RELEASED. THE RELAY TIME IS THE WHOLE OF SOCKETS_RELAY, MEASURED ON THE SERVER
+// THREAD, SO WHAT THE SPECTATORS ADD TO IT IS WHAT EACH TURN TO THE CLIENTS IS HELD BACK BY. SPECTATORS
+// ARE IN SYNC IF THEY HAVE THE PLAYERS' PARITY AT THE LAST CYCLE THEY ALL REACHED. MINUS ONE SPECTATORS
+// RUNS WITHOUT THEM ENABLED. STALLED SPECTATORS ARRIVE WITH THE OTHERS BUT NEVER READ, SO THEIR
+// SOCKETS FILL ONCE THE KEYFRAME IS LARGER THAN THE KERNEL BUFFERS, AND THE SERVER MUST DROP THEM
+// WITHOUT THE TURNS TO THE CLIENTS EVER WAITING. THE STREAM IS WHAT THE SPECTATORS' STREAM GREW BY
+// A TURN, AT THE GIVEN CODEC LEVEL.
+static void Spectate(const int32_t units, const int32_t observers, const int32_t stalled, const int32_t compress)
+{
+    static Server zero;
+    Server server = zero;
+    server.spectate = observers >= 0;
+    server.delay = BENCH_SPECTATE_DELAY;
+    server.compress = compress;
+    StartServer(&server, MakeImpair(0, 0, 0, 0, 0, 0));
+    const int32_t side = Fixed_Sqrt(units / 4) + 1;
+    const Grid grid = Grid_Make(side, side, 96, 48);
+    Player player[BENCH_TRANSPORT_USERS];
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        player[i] = Arrive(units, grid);
+        player[i].units = Populate(player[i].units, grid);
+        player[i].is_playing = true;
+    }
+    const int32_t count = UTIL_MAX(0, observers);
+    Player* const observer = UTIL_ALLOC(Player, UTIL_MAX(1, count));
+    Sock* const stall = UTIL_ALLOC(Sock, UTIL_MAX(1, stalled));
+    Overview overview = Overview_Init(0, 0);
+    bool has_arrived = false;
+    double arrived = 0.0;
+    double keyed = 0.0;
+    int32_t restored = 0;
+    int32_t turn = 0;
+    int32_t relay_us = 0;
+    int32_t streamed = 0;
+    int32_t beats = 0;
+    const double t0 = Now();
+    for(double frame = t0; Now() - t0 < BENCH_SPECTATE_SECONDS; frame += CONFIG_MAIN_LOOP_SPEED_MS / 1000.0, beats++)
+    {
+        while(Now() < frame)
+            SDL_Delay(1);
+        if(!has_arrived && Now() - t0 >= BENCH_SPECTATE_ARRIVE)
+        {
+            for(int32_t i = 0; i < count; i++)
+                observer[i] = Attend(units, grid);
+            for(int32_t i = 0; i < stalled; i++)
+                stall[i] = Sock_Connect("localhost", BENCH_PORT + SPECTATORS_PORT_OFFSET);
+            for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+                player[i].gap = player[i].last = 0.0;
+            turn = SDL_AtomicGet(&server.turn);
+            relay_us = SDL_AtomicGet(&server.relay_us);
+            streamed = SDL_AtomicGet(&server.streamed);
+            arrived = Now();
+            has_arrived = true;
+            frame = Now();
+        }
+        for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+        {
+            Player* const at = &player[i];
+            *at = Listen(*at);
+            *at = Tick(*at);
+            Sock_SendSnapshot(at->sock, &at->donation, CONFIG_SOCKETS_REJOIN_CHUNKS);
+            if(beats % BENCH_BEAT == 0)
+            {
+                const Parity parity = Parities_Get(at->parities, Parity_GetCheckpoint(at->units.cycles));
+                overview.cycles = at->units.cycles;
+                overview.parity = parity.root;
+                overview.parity_cycles = parity.cycles;
+                overview.ping = Rtt_GetLast(at->sock.rtt);
+                Sock_SendHeartbeat(at->sock, overview);
+            }
+        }
+        for(int32_t i = 0; has_arrived && i < count; i++)
+        {
+            Player* const at = &observer[i];
+            *at = Listen(*at);
+            if(!at->is_playing && Transfer_IsDone(*at->sock.transfer))
+            {
+                at->units = Units_Restore(at->units, at->sock.transfer->snapshot);
+                Parities_Put(at->parities, Units_Parity(at->units));
+                at->newest = at->units.cycles;
+                at->is_playing = true;
+                keyed += Now() - arrived;
+                restored++;
+                *at = Listen(*at);
+            }
+            while(at->is_playing && at->units.cycles < at->newest)
+                *at = Tick(*at);
+        }
+    }
+    const int32_t turns = UTIL_MAX(1, SDL_AtomicGet(&server.turn) - turn);
+    const double relay = (SDL_AtomicGet(&server.relay_us) - relay_us) / (double) turns;
+    const double stream = (SDL_AtomicGet(&server.streamed) - streamed) / (double) turns;
+    int32_t common = player[0].units.cycles;
+    double gap = 0.0;
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+    {
+        common = UTIL_MIN(common, player[i].units.cycles);
+        gap = UTIL_MAX(gap, player[i].gap);
+    }
+    for(int32_t i = 0; i < count; i++)
+        if(observer[i].is_playing)
+            common = UTIL_MIN(common, observer[i].units.cycles);
+    const int32_t checkpoint = Parity_GetCheckpoint(common);
+    const uint64_t root = Parities_Get(player[0].parities, checkpoint).root;
+    int32_t same = 0;
+    for(int32_t i = 0; i < count; i++)
+    {
+        same += observer[i].is_playing && Parities_Get(observer[i].parities, checkpoint).root == root;
+        Depart(observer[i]);
+    }
+    for(int32_t i = 0; i < BENCH_TRANSPORT_USERS; i++)
+        Depart(player[i]);
+    const int32_t watching = SDL_AtomicGet(&server.watching);
+    for(int32_t i = 0; has_arrived && i < stalled; i++)
+        Sock_Disconnect(stall[i]);
+    free(observer);
+    free(stall);
+    StopServer(&server);
+    const char* const levels[] = { "whole", "delta", "squeeze" };
+    printf("spectate %6d units %4d spectators %2d stalled :: %4d turns relayed at %7.1f us per turn :: stream %-7s %5.1f bytes per turn :: worst turn gap %4.0f ms :: %3d keyed in %5.2f s mean :: %3d of %3d in sync at cycle %d :: %3d still watching\n",
+        units, observers, stalled, turns, relay, levels[compress], stream, 1e3 * gap, restored, restored > 0 ? keyed / restored : -1.0, same, count, common, watching);
+}
+
+#define BENCH_SWARM_USERS (8)
+#define BENCH_SWARM_SECONDS (10)
+
+// THE SWARM AGAINST THE MULTI MATCH SERVER, EVERY SCRIPT AT ONCE. THE SHARD LOAD IS COUNTED AS IN
+// THE MATCHES BENCH. BOTH ENDS OF EVERY CONNECTION SHARE THE PROCESS, AND THE BOTS ARE READ THROUGH
+// SELECT, SO ALL OF THEM TOGETHER MUST STAY UNDER FD_SETSIZE.
+static void Swarms(const int32_t count, const Script script)
+{
+    const int32_t matches = (count + BENCH_SWARM_USERS - 1) / BENCH_SWARM_USERS;
+    const int32_t needed = (matches + CONFIG_HOST_MATCHES_PER_SHARD - 1) / CONFIG_HOST_MATCHES_PER_SHARD;
+    const int32_t shards = UTIL_MAX(needed, SDL_GetCPUCount() / 2);
+    Host* const host = Host_Start(BENCH_PORT, shards);
+    Swarm* const swarm = Swarm_Make("localhost", BENCH_PORT, count, 0, BENCH_SWARM_USERS, script);
+    uint32_t busy = 0;
+    for(int32_t i = 0; i < shards; i++)
+        busy -= (uint32_t) SDL_AtomicGet(&host->shard[i]->busy);
+    const double t0 = Now();
+    Swarm_Run(swarm, BENCH_SWARM_SECONDS);
+    const double t1 = Now();
+    for(int32_t i = 0; i < shards; i++)
+        busy += (uint32_t) SDL_AtomicGet(&host->shard[i]->busy);
+    printf("swarm %4d bots, %s, in %d matches of %d on %d shards :: shard load %6.3f cores\n",
+        count, Script_ToString(script), Matches_Count(host->matches), BENCH_SWARM_USERS, shards, (busy / 1e6) / (t1 - t0));
+    Swarm_Print(swarm, false);
+    Swarm_Free(swarm);
+    Host_Stop(host);
+}
+
+#define BENCH_REPLAY_PATH "bench.replay"
+#define BENCH_REPLAY_MAP (64)
+#define BENCH_REPLAY_EVERY (8)
+
+static Units Zone(const Registrar terrain, const Registrar graphics, Map* const map, Grid* const grid, const Replay* const replay)
+{
+    Unit_SetNextId(0);
+    *map = Map_Make(replay->map_size, terrain);
+    *grid = Grid_Make(map->cols, map->rows, map->tile_width, map->tile_height);
+    const Units units = Units_New(*grid, SDL_GetCPUCount(), CONFIG_UNITS_MAX, replay->color, replay->civ);
+    return Units_GenerateTestZone(units, *map, *grid, graphics, replay->users);
+}
+
+// THE REAL SIMULATION ON STAND IN GRAPHICS, RECORDED AS A CLIENT WOULD AND PLAYED BACK AS --REPLAY
+// DOES, WHICH MUST ARRIVE AT THE PARITY RECORDED.
+static void Playback(const int32_t users, const int32_t cycles)
+{
+    const Registrar terrain = Registrar_StubTerrain();
+    const Registrar graphics = Registrar_StubGraphics();
+    Replay* const recorder = Replay_Create(BENCH_REPLAY_PATH, users, COLOR_BLU, CIV_NORTH_EUROPE, BENCH_REPLAY_MAP);
+    Map map;
+    Grid grid;
+    Units units = Zone(terrain, graphics, &map, &grid, recorder);
+    uint32_t seed = 1;
+    int32_t commands = 0;
+    const double t0 = Now();
+    while(units.cycles < cycles)
+    {
+        const Field field = Units_Field(units, map);
+        if(units.cycles % BENCH_REPLAY_EVERY == 0)
+        {
+            static Packet zero;
+            Packet packet = zero;
+            packet.turn = units.cycles / BENCH_REPLAY_EVERY + 1;
+            packet.exec_cycle = units.cycles;
+            packet.is_stable = true;
+            packet.game_running = true;
+            packet.users = users;
+            for(int32_t i = 0; i < users; i++)
+                if(Spread(&seed, 2) == 0)
+                {
+                    packet.overview[i] = Order(&seed, units, grid, (Color) i);
+                    commands += Overview_UsedAction(packet.overview[i]);
+                }
+            Replay_Record(recorder, packet);
+            units = Units_PacketService(units, graphics, packet, grid, map, field);
+        }
+        units = Units_Caretake(units, graphics, grid, map, field);
+        Field_Free(field);
+    }
+    const double t1 = Now();
+    const uint64_t parity = Units_Parity(units).root;
+    Replay_Close(recorder, units.cycles, parity);
+    Units_Free(units);
+    Map_Free(map);
+    Replay* const replay = Replay_Open(BENCH_REPLAY_PATH);
+    units = Zone(terrain, graphics, &map, &grid, replay);
+    units = Replay_Play(replay, units, graphics, grid, map, false);
+    const char* const verdict = Replay_Check(replay, units);
+    printf("replay %d users %5d units :: %4d commands :: record %6.3f ms per cycle :: play %6.3f ms per cycle, %6.3f ms worst :: cycle %d 0x%016lX %s\n",
+        users, units.count, commands, 1e3 * (t1 - t0) / cycles, replay->total_ms / UTIL_MAX(replay->played, 1), replay->worst_ms, units.cycles, parity, verdict);
+    if(!Util_StringEqual(verdict, "MATCHES"))
+        Util_Bomb("BENCH :: REPLAY %s\n", verdict);
+    Replay_Free(replay);
+    Units_Free(units);
+    Map_Free(map);
+    Registrar_Free(terrain);
+    Registrar_Free(graphics);
+    remove(BENCH_REPLAY_PATH);
+}
+
+void Bench_Run(const char* const name)
+{
+    if(Util_StringEqual(name, "boids"))
+    {
+        const int32_t counts[] = { 1000, 10000, 50000 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Boids(counts[i]);
+    }
+    else if(Util_StringEqual(name, "matches"))
+    {
+        // BOTH ENDS OF EVERY CONNECTION LIVE IN THIS PROCESS, AND THE CLIENTS ARE READ THROUGH
+        // SELECT, SO ALL OF THEM TOGETHER MUST STAY UNDER FD_SETSIZE.
+        const int32_t counts[] = { 16, 64, 192 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Lobbies(counts[i], 2);
+    }
+    else if(Util_StringEqual(name, "transport"))
+    {
+        // WAN MATCHES NETSIM.SH, LESS THE CORRUPTION.
+        const char* const names[] = { "clean", "lan", "wan", "lossy", "narrow" };
+        const Impair profiles[] = {
+            MakeImpair( 0,  0,  0,  0,  0,  0),
+            MakeImpair( 2,  1,  0,  0,  0,  0),
+            MakeImpair(50, 10,  1, 10,  0,  0),
+            MakeImpair(30,  5, 20,  0, 20,  0),
+            MakeImpair(20,  0,  0,  0,  0, 64),
+        };
+        for(int32_t i = 0; i < UTIL_LEN(profiles); i++)
+        {
+            Transport(names[i], profiles[i], false);
+            Transport(names[i], profiles[i], true);
+        }
+    }
+    else if(Util_StringEqual(name, "parity"))
+    {
+        const int32_t counts[] = { 1000, 20000 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Hash(counts[i]);
+        Hunt("clean", MakeImpair( 0,  0, 0, 0, 0, 0));
+        Hunt("wan",   MakeImpair(50, 10, 1, 0, 0, 0));
+    }
+    else if(Util_StringEqual(name, "snapshot"))
+    {
+        const int32_t counts[] = { 1000, 20000 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Save(counts[i]);
+    }
+    else if(Util_StringEqual(name, "queue"))
+    {
+        const int32_t counts[] = { 32, 4096, 65536 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Backlog(counts[i]);
+    }
+    else if(Util_StringEqual(name, "compress"))
+    {
+        // HOW MANY TURNS GO BY, PER PLAYER, BETWEEN COMMANDS.
+        const char* const names[] = { "quiet", "busy", "frantic" };
+        const int32_t every[] = { 20, 3, 1 };
+        for(int32_t i = 0; i < UTIL_LEN(every); i++)
+        for(int32_t level = CODEC_OFF; level <= CODEC_SQUEEZE; level++)
+            Compress(names[i], every[i], level);
+    }
+    else if(Util_StringEqual(name, "rejoin"))
+    {
+        const int32_t counts[] = { 1000, 20000 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Return(counts[i], "clean", MakeImpair( 0,  0, 0, 0, 0, 0));
+        Return(counts[1], "wan", MakeImpair(50, 10, 0, 0, 0, 0));
+    }
+    else if(Util_StringEqual(name, "rollback"))
+    {
+        const int32_t counts[] = { 1000, 20000 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Predict(counts[i], "clean", MakeImpair( 0,  0, 0, 0, 0, 0));
+        Predict(counts[0], "wan", MakeImpair(50, 10, 0, 0, 0, 0));
+        Predict(counts[1], "wan", MakeImpair(50, 10, 0, 0, 0, 0));
+    }
+    else if(Util_StringEqual(name, "spectate"))
+    {
+        const int32_t counts[] = { -1, 0, 16, 128 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Spectate(BENCH_SPECTATE_UNITS, counts[i], 0, CODEC_OFF);
+        Spectate(BENCH_SPECTATE_UNITS, 16, 0, CODEC_SQUEEZE);
+        Spectate(BENCH_SPECTATE_STALLED_UNITS, 16, 0, CODEC_OFF);
+        Spectate(BENCH_SPECTATE_STALLED_UNITS, 16, 4, CODEC_OFF);
+    }
+    else if(Util_StringEqual(name, "swarm"))
+    {
+        const int32_t counts[] = { 64, 256 };
+        for(int32_t i = 0; i < UTIL_LEN(counts); i++)
+            Swarms(counts[i], SCRIPT_MIXED);
+    }
+    else if(Util_StringEqual(name, "replay"))
+    {
+        const int32_t users[] = { 2, 8 };
+        for(int32_t i = 0; i < UTIL_LEN(users); i++)
+            Playback(users[i], 4000);
+    }
+    else if(Util_StringEqual(name, "clock"))
+    {
+        Timeline("clean", MakeImpair( 0,  0, 0, 0, 0, 0));
+        Timeline("wan",   MakeImpair(50, 10, 1, 0, 0, 0));
+    }
+    else Util_Bomb("BENCH :: UNKNOWN BENCHMARK %s\n", name);
+}
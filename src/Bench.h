@@ -0,0 +1,5 @@
+#pragma once
+
+// OFFLINE MICROBENCHMARKS. THESE NEED NEITHER GAME DATA NOR A WINDOW, AND PRINT ONE LINE PER RUN.
+
+void Bench_Run(const char* const name);
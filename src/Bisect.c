@@ -0,0 +1,56 @@
+#include "Bisect.h"
+
+#include "Config.h"
+
+Bisect Bisect_Start(const int32_t a, const int32_t b, const int32_t lo, const int32_t hi)
+{
+    static Bisect zero;
+    Bisect bisect = zero;
+    bisect.a = a;
+    bisect.b = b;
+    bisect.lo = lo;
+    bisect.hi = hi;
+    bisect.probe = hi;
+    bisect.is_active = true;
+    return bisect;
+}
+
+static Bisect Finish(Bisect bisect, const bool is_exact)
+{
+    bisect.is_active = false;
+    bisect.is_done = true;
+    bisect.is_exact = is_exact;
+    return bisect;
+}
+
+// ANSWERS FOR ANY OTHER CYCLE ARE LEFT OVER FROM AN EARLIER PROBE, OR COME FROM A CLIENT THAT NO
+// LONGER REMEMBERS THE PROBE, AND ARE WAITED OUT.
+Bisect Bisect_Answer(Bisect bisect, const Parity a, const Parity b)
+{
+    if(!bisect.is_active
+    || a.cycles != bisect.probe
+    || b.cycles != bisect.probe)
+        return Bisect_Wait(bisect);
+    if(a.root == b.root)
+        bisect.lo = bisect.probe;
+    else
+    {
+        bisect.hi = bisect.probe;
+        bisect.aspects = Parity_DiffAspects(a, b);
+        bisect.regions = Parity_DiffRegions(a, b);
+    }
+    bisect.waited = 0;
+    if(bisect.hi - bisect.lo <= CONFIG_PARITY_INTERVAL)
+        return Finish(bisect, true);
+    bisect.probe = Parity_GetCheckpoint(bisect.lo + (bisect.hi - bisect.lo) / 2);
+    return bisect;
+}
+
+Bisect Bisect_Wait(Bisect bisect)
+{
+    if(bisect.is_active)
+        bisect.waited += 1;
+    return (bisect.waited > CONFIG_PARITY_PATIENCE)
+        ? Finish(bisect, false)
+        : bisect;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Parity.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// THE SERVER'S SEARCH FOR THE FIRST CHECKPOINT TWO CLIENTS DISAGREE AT. IT STARTS FROM A CHECKPOINT
+// THEY LAST AGREED AT AND ONE THEY DISAGREE AT, AND ASKS BOTH CLIENTS FOR THEIR PARITY AT ONE PROBE
+// CHECKPOINT AT A TIME, AS CLIENTS ONLY HASH CHECKPOINTS. THE CHECKPOINT IS PROBED FIRST FOR ITS
+// ASPECTS AND REGIONS. A DIVERGED SIMULATION STAYS DIVERGED, SO EVERY ANSWER HALVES THE RANGE. A
+// SEARCH THAT WAITS TOO LONG FOR AN ANSWER IS GIVEN UP, LEAVING THE RANGE IT GOT TO.
+
+typedef struct
+{
+    int32_t a;
+    int32_t b;
+    int32_t lo;
+    int32_t hi;
+    int32_t probe;
+    int32_t waited;
+    uint32_t aspects;
+    uint32_t regions;
+    bool is_active;
+    bool is_done;
+    bool is_exact;
+}
+Bisect;
+
+Bisect Bisect_Start(const int32_t a, const int32_t b, const int32_t lo, const int32_t hi);
+
+Bisect Bisect_Answer(Bisect, const Parity, const Parity);
+
+Bisect Bisect_Wait(Bisect);
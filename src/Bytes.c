@@ -0,0 +1,95 @@
+#include "Bytes.h"
+
+void Bytes_Clear(Bytes* const bytes)
+{
+    bytes->size = 0;
+    bytes->index = 0;
+    bytes->is_bad = false;
+}
+
+// READS AGAIN FROM THE START, SO THAT A MESSAGE CAN BE TRIED AGAINST ANOTHER KIND.
+void Bytes_Rewind(Bytes* const bytes)
+{
+    bytes->index = 0;
+    bytes->is_bad = false;
+}
+
+void Bytes_PutU8(Bytes* const bytes, const uint8_t value)
+{
+    if(bytes->size == BYTES_MAX)
+        bytes->is_bad = true;
+    else
+        bytes->byte[bytes->size++] = value;
+}
+
+void Bytes_PutVarint(Bytes* const bytes, uint64_t value)
+{
+    while(value >= 0x80)
+    {
+        Bytes_PutU8(bytes, (uint8_t) (value | 0x80));
+        value >>= 7;
+    }
+    Bytes_PutU8(bytes, (uint8_t) value);
+}
+
+void Bytes_PutZigzag(Bytes* const bytes, const int64_t value)
+{
+    const uint64_t zigzag = ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+    Bytes_PutVarint(bytes, zigzag);
+}
+
+void Bytes_PutBytes(Bytes* const bytes, const Bytes* const other)
+{
+    for(int32_t i = 0; i < other->size; i++)
+        Bytes_PutU8(bytes, other->byte[i]);
+}
+
+uint8_t Bytes_GetU8(Bytes* const bytes)
+{
+    if(bytes->index == bytes->size)
+    {
+        bytes->is_bad = true;
+        return 0;
+    }
+    return bytes->byte[bytes->index++];
+}
+
+// AT MOST TEN BYTES ARE READ - ANYTHING LONGER IS MALFORMED.
+uint64_t Bytes_GetVarint(Bytes* const bytes)
+{
+    uint64_t value = 0;
+    for(int32_t shift = 0; shift < 64; shift += 7)
+    {
+        const uint8_t byte = Bytes_GetU8(bytes);
+        value |= (uint64_t) (byte & 0x7F) << shift;
+        if((byte & 0x80) == 0)
+            return value;
+    }
+    bytes->is_bad = true;
+    return 0;
+}
+
+int64_t Bytes_GetZigzag(Bytes* const bytes)
+{
+    const uint64_t zigzag = Bytes_GetVarint(bytes);
+    return (int64_t) (zigzag >> 1) ^ -(int64_t) (zigzag & 1);
+}
+
+// THE NEXT SIZE BYTES BECOME A MESSAGE OF THEIR OWN.
+void Bytes_GetBytes(Bytes* const bytes, Bytes* const other, const int32_t size)
+{
+    Bytes_Clear(other);
+    if(size < 0 || size > bytes->size - bytes->index)
+    {
+        bytes->is_bad = true;
+        return;
+    }
+    for(int32_t i = 0; i < size; i++)
+        other->byte[i] = bytes->byte[bytes->index++];
+    other->size = size;
+}
+
+bool Bytes_IsDone(const Bytes* const bytes)
+{
+    return !bytes->is_bad && bytes->index == bytes->size;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A BYTE BUFFER FOR THE WIRE PROTOCOL. INTEGERS ARE WRITTEN AS LITTLE ENDIAN BASE 128 VARINTS,
+// AND SIGNED INTEGERS ARE ZIGZAG ENCODED FIRST, SO THE ENCODING IS INDEPENDENT OF HOST
+// ENDIANNESS, COMPILER, AND STRUCT PADDING. RUNNING OFF EITHER END MARKS THE BUFFER BAD.
+
+#define BYTES_MAX (1024)
+
+typedef struct
+{
+    uint8_t byte[BYTES_MAX];
+    int32_t size;
+    int32_t index;
+    bool is_bad;
+}
+Bytes;
+
+void Bytes_Clear(Bytes* const);
+
+void Bytes_Rewind(Bytes* const);
+
+void Bytes_PutU8(Bytes* const, const uint8_t);
+
+void Bytes_PutVarint(Bytes* const, uint64_t);
+
+void Bytes_PutZigzag(Bytes* const, const int64_t);
+
+void Bytes_PutBytes(Bytes* const, const Bytes* const);
+
+uint8_t Bytes_GetU8(Bytes* const);
+
+uint64_t Bytes_GetVarint(Bytes* const);
+
+int64_t Bytes_GetZigzag(Bytes* const);
+
+void Bytes_GetBytes(Bytes* const, Bytes* const, const int32_t size);
+
+bool Bytes_IsDone(const Bytes* const);
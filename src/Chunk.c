@@ -0,0 +1,44 @@
+#include "Chunk.h"
+
+#include "Protocol.h"
+
+void Chunk_Encode(const Chunk chunk, Bytes* const bytes)
+{
+    Bytes_PutU8(bytes, PROTOCOL_VERSION);
+    Bytes_PutU8(bytes, PROTOCOL_CHUNK);
+    Bytes_PutVarint(bytes, (uint64_t) chunk.cycles);
+    Bytes_PutVarint(bytes, (uint64_t) chunk.size);
+    Bytes_PutVarint(bytes, (uint64_t) chunk.offset);
+    Bytes_PutVarint(bytes, (uint64_t) chunk.count);
+    for(int32_t i = 0; i < chunk.count; i++)
+        Bytes_PutU8(bytes, chunk.byte[i]);
+}
+
+// A CHUNK THAT DOES NOT FIT IN ITS SNAPSHOT IS BAD.
+Chunk Chunk_Decode(Bytes* const bytes)
+{
+    static Chunk zero;
+    Chunk chunk = zero;
+    if(Bytes_GetU8(bytes) != PROTOCOL_VERSION
+    || Bytes_GetU8(bytes) != PROTOCOL_CHUNK)
+    {
+        bytes->is_bad = true;
+        return zero;
+    }
+    chunk.cycles = (int32_t) Bytes_GetVarint(bytes);
+    chunk.size = (int32_t) Bytes_GetVarint(bytes);
+    chunk.offset = (int32_t) Bytes_GetVarint(bytes);
+    chunk.count = (int32_t) Bytes_GetVarint(bytes);
+    if(chunk.count < 0
+    || chunk.count > CHUNK_BYTES
+    || chunk.offset < 0
+    || chunk.size < 0
+    || chunk.offset > chunk.size - chunk.count)
+    {
+        bytes->is_bad = true;
+        return zero;
+    }
+    for(int32_t i = 0; i < chunk.count; i++)
+        chunk.byte[i] = Bytes_GetU8(bytes);
+    return chunk;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Bytes.h"
+
+#include <stdint.h>
+
+// ONE PIECE OF A SNAPSHOT ON ITS WAY TO A REJOINING CLIENT. EVERY CHUNK NAMES THE CYCLE THE SNAPSHOT
+// WAS TAKEN AT, THE SIZE OF THE WHOLE SNAPSHOT, AND WHERE IN IT ITS BYTES GO, SO CHUNKS CAN BE PUT
+// TOGETHER IN ANY ORDER AND A CHUNK OF AN OLDER SNAPSHOT IS TOLD APART FROM THE NEWER ONE.
+
+#define CHUNK_BYTES (BYTES_MAX - 32)
+
+typedef struct
+{
+    int32_t cycles;
+    int32_t size;
+    int32_t offset;
+    int32_t count;
+    uint8_t byte[CHUNK_BYTES];
+}
+Chunk;
+
+void Chunk_Encode(const Chunk, Bytes* const);
+
+Chunk Chunk_Decode(Bytes* const);
@@ -0,0 +1,52 @@
+#include "Clock.h"
+
+#include "Config.h"
+#include "Util.h"
+
+Clock Clock_Make(const uint32_t now)
+{
+    static Clock zero;
+    Clock clock = zero;
+    clock.last = now;
+    return clock;
+}
+
+// THE FIRST TURN SETS THE TARGET OUTRIGHT. LATER TURNS ONLY NUDGE IT, SO JITTER DOES NOT SHAKE THE RATE.
+Clock Clock_Observe(Clock clock, const int32_t setpoint, const int32_t rtt)
+{
+    if(setpoint <= 0)
+        return clock;
+    const double measured = setpoint + UTIL_MAX(0, rtt) / (2.0 * CONFIG_MAIN_LOOP_SPEED_MS);
+    if(clock.is_synced)
+        clock.target += CLOCK_BLEND * (measured - clock.target);
+    else
+    {
+        clock.target = measured;
+        clock.is_synced = true;
+    }
+    return clock;
+}
+
+// UNTIL THE FIRST TURN ARRIVES THE CLOCK RUNS AT ITS NOMINAL RATE. TICKS ARE ROUNDED RATHER THAN
+// TRUNCATED, SO A FRAME A MILLISECOND SHORT STILL RUNS ITS TICK AND THE NEXT ONE DOES NOT RUN TWO.
+Clock Clock_Advance(Clock clock, const int32_t cycles, const uint32_t now)
+{
+    const double elapsed = (int32_t) (now - clock.last) / (double) CONFIG_MAIN_LOOP_SPEED_MS;
+    clock.last = now;
+    clock.target += elapsed;
+    const double offset = clock.is_synced ? clock.target - cycles : 0.0;
+    const double error = offset > CLOCK_DEADBAND ? offset - CLOCK_DEADBAND
+                       : offset < -CLOCK_DEADBAND ? offset + CLOCK_DEADBAND
+                       : 0.0;
+    const double rate = UTIL_MIN(UTIL_MAX(1.0 + CLOCK_GAIN * error, CLOCK_SLOWEST), (double) CLOCK_BURST);
+    clock.budget += elapsed * rate;
+    clock.ticks = UTIL_MIN((int32_t) (clock.budget + 0.5), CLOCK_BURST);
+    clock.budget = UTIL_MIN(clock.budget - clock.ticks, 0.5);
+    return clock;
+}
+
+// POSITIVE WHEN BEHIND THE SERVER.
+double Clock_GetOffset(const Clock clock, const int32_t cycles)
+{
+    return clock.target - cycles;
+}
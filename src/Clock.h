@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// KEEPS A CLIENT'S SIMULATION ON THE SERVER'S TIMELINE BY TIME DILATION. EVERY TURN CARRIES THE
+// CYCLE THE SERVER BELIEVES THE MATCH IS AT, AND ADDING HALF THE RTT GIVES WHERE IT IS ON ARRIVAL.
+// BETWEEN TURNS THAT TARGET ADVANCES ONE CYCLE PER NOMINAL FRAME. EACH FRAME THE CLIENT RUNS AS
+// MANY TICKS AS ITS CLOCK RATE HAS EARNED: NOMINAL WHEN ON TIME, A LITTLE FASTER WHEN BEHIND AND
+// A LITTLE SLOWER WHEN AHEAD, SO THE GAP CLOSES WITHOUT A VISIBLE JUMP. WITHIN A CYCLE OF THE TARGET
+// IT IS LEFT ALONE, AS THAT MUCH IS JITTER. A CLIENT FAR BEHIND MAY RUN A FEW TICKS IN ONE FRAME,
+// BUT NEVER MORE THAN THE BURST, AND IT STILL RENDERS EVERY FRAME.
+
+#define CLOCK_BLEND (0.25)
+
+#define CLOCK_GAIN (0.1)
+
+#define CLOCK_DEADBAND (1.0)
+
+#define CLOCK_SLOWEST (0.75)
+
+#define CLOCK_BURST (4)
+
+typedef struct
+{
+    double target;
+    double budget;
+    uint32_t last;
+    bool is_synced;
+    int32_t ticks;
+}
+Clock;
+
+Clock Clock_Make(const uint32_t now);
+
+Clock Clock_Observe(Clock, const int32_t setpoint, const int32_t rtt);
+
+Clock Clock_Advance(Clock, const int32_t cycles, const uint32_t now);
+
+double Clock_GetOffset(const Clock, const int32_t cycles);
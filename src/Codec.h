@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Color.h"
+
+#include <stdint.h>
+
+// WHAT ONE END OF A CHANNEL LAST SAW OF THE TURN STREAM, FOR TURNS SENT AS DELTAS. THE HEADER
+// FIELDS ARE THOSE OF THE LAST TURN, WITH HOW MUCH EACH MOVED BY SINCE THE TURN BEFORE, AND EACH
+// COMMAND IS THE LAST ONE FROM THAT SLOT, HOWEVER LONG AGO. BOTH ENDS START FROM ZERO, SO THE FIRST
+// TURN IS A DELTA AGAINST NOTHING.
+//
+// THE WIRE AND THE LINK EACH DELIVER IN ORDER BUT NOT IN ORDER WITH EACH OTHER, SO A CLIENT KEEPS
+// ONE CODEC PER CHANNEL. TURNS SENT WHOLE, LIKE A REJOIN BACKLOG, LEAVE THE CODEC ALONE.
+
+#define CODEC_WIRE (0)
+
+#define CODEC_LINK (1)
+
+#define CODEC_CHANNELS (2)
+
+#define CODEC_FIELDS (14)
+
+#define CODEC_COMMAND_FIELDS (19)
+
+#define CODEC_OFF (0)
+
+#define CODEC_DELTA (1)
+
+#define CODEC_SQUEEZE (2)
+
+typedef struct
+{
+    int64_t field[CODEC_FIELDS];
+    int64_t step[CODEC_FIELDS];
+    int64_t command[COLOR_COUNT][CODEC_COMMAND_FIELDS];
+}
+Codec;
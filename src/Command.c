@@ -0,0 +1,194 @@
+#include "Command.h"
+
+// MATCHES BUTTON_FROMOVERVIEW: WHEN SEVERAL HOTKEYS ARE HELD THE LAST ONE WINS.
+static int32_t GetHotkey(const Event event)
+{
+    int32_t index = -1;
+    if(event.key_q) index =  0;
+    if(event.key_w) index =  1;
+    if(event.key_e) index =  2;
+    if(event.key_r) index =  3;
+    if(event.key_t) index =  4;
+    if(event.key_a) index =  5;
+    if(event.key_s) index =  6;
+    if(event.key_d) index =  7;
+    if(event.key_f) index =  8;
+    if(event.key_g) index =  9;
+    if(event.key_z) index = 10;
+    if(event.key_x) index = 11;
+    if(event.key_c) index = 12;
+    if(event.key_v) index = 13;
+    if(event.key_b) index = 14;
+    return index;
+}
+
+static Event SetHotkey(Event event, const int32_t hotkey)
+{
+    switch(hotkey)
+    {
+    case  0: event.key_q = true; break;
+    case  1: event.key_w = true; break;
+    case  2: event.key_e = true; break;
+    case  3: event.key_r = true; break;
+    case  4: event.key_t = true; break;
+    case  5: event.key_a = true; break;
+    case  6: event.key_s = true; break;
+    case  7: event.key_d = true; break;
+    case  8: event.key_f = true; break;
+    case  9: event.key_g = true; break;
+    case 10: event.key_z = true; break;
+    case 11: event.key_x = true; break;
+    case 12: event.key_c = true; break;
+    case 13: event.key_v = true; break;
+    case 14: event.key_b = true; break;
+    }
+    return event;
+}
+
+Command Command_FromOverview(const Overview overview)
+{
+    static Command zero;
+    Command command = zero;
+    const Event event = overview.event;
+    if(event.mouse_lu)
+    {
+        if(event.key_left_shift)
+            command.flags |= COMMAND_SPAWN;
+        else
+        {
+            command.flags |= COMMAND_SELECT;
+            if(Overview_IsSelectionBoxBigEnough(overview))
+                command.flags |= COMMAND_BOX;
+            if(event.key_left_ctrl)
+                command.flags |= COMMAND_SIMILAR;
+        }
+    }
+    if(event.mouse_ru)
+        command.flags |= COMMAND_MOVE;
+    command.selection_box = overview.selection_box;
+    command.pan = overview.pan;
+    command.cursor = overview.mouse_cursor;
+    command.motive = overview.share.motive;
+    command.bits = overview.share.bits;
+    command.color = overview.share.color;
+    command.age = overview.share.status.age;
+    command.civ = overview.share.status.civ;
+    command.xres = overview.xres;
+    command.yres = overview.yres;
+    command.hotkey = GetHotkey(event);
+    command.sequence = overview.sequence;
+    return command;
+}
+
+Overview Command_ToOverview(const Command command)
+{
+    static Overview zero;
+    Overview overview = zero;
+    overview.event.mouse_lu = (command.flags & (COMMAND_SELECT | COMMAND_SPAWN)) != 0;
+    overview.event.mouse_ru = (command.flags & COMMAND_MOVE) != 0;
+    overview.event.key_left_shift = (command.flags & COMMAND_SPAWN) != 0;
+    overview.event.key_left_ctrl = (command.flags & COMMAND_SIMILAR) != 0;
+    overview.event = SetHotkey(overview.event, command.hotkey);
+    overview.selection_box = command.selection_box;
+    overview.pan = command.pan;
+    overview.mouse_cursor = command.cursor;
+    overview.share.motive = command.motive;
+    overview.share.bits = command.bits;
+    overview.share.color = command.color;
+    overview.share.status.age = command.age;
+    overview.share.status.civ = command.civ;
+    overview.xres = command.xres;
+    overview.yres = command.yres;
+    overview.sequence = command.sequence;
+    return overview;
+}
+
+static void PutPoint(Bytes* const bytes, const Point point)
+{
+    Bytes_PutZigzag(bytes, point.x);
+    Bytes_PutZigzag(bytes, point.y);
+}
+
+// INITIALIZER LISTS ARE NOT SEQUENCED, SO EACH FIELD IS READ IN ITS OWN STATEMENT.
+static Point GetPoint(Bytes* const bytes)
+{
+    Point point;
+    point.x = (int32_t) Bytes_GetZigzag(bytes);
+    point.y = (int32_t) Bytes_GetZigzag(bytes);
+    return point;
+}
+
+// THE VIEWPORT, TRIGGER CONTEXT, AND SEQUENCE ALWAYS GO OUT. THE BOX GOES OUT ONLY WHEN IT WAS DRAGGED,
+// AND THE BUTTON STATE ONLY WHEN SOMETHING IS SPAWNED.
+void Command_Encode(const Command command, Bytes* const bytes)
+{
+    Bytes_PutVarint(bytes, (uint64_t) command.flags);
+    Bytes_PutVarint(bytes, (uint64_t) command.color);
+    Bytes_PutVarint(bytes, (uint64_t) command.age);
+    Bytes_PutVarint(bytes, (uint64_t) command.civ);
+    Bytes_PutVarint(bytes, (uint64_t) command.xres);
+    Bytes_PutVarint(bytes, (uint64_t) command.yres);
+    PutPoint(bytes, command.pan);
+    PutPoint(bytes, command.cursor);
+    Bytes_PutVarint(bytes, (uint64_t) command.sequence);
+    if(command.flags & COMMAND_BOX)
+    {
+        PutPoint(bytes, command.selection_box.a);
+        PutPoint(bytes, command.selection_box.b);
+    }
+    if(command.flags & COMMAND_SPAWN)
+    {
+        Bytes_PutZigzag(bytes, command.hotkey);
+        Bytes_PutZigzag(bytes, command.motive.action);
+        Bytes_PutZigzag(bytes, command.motive.type);
+        Bytes_PutVarint(bytes, (uint64_t) command.bits);
+    }
+}
+
+Command Command_Decode(Bytes* const bytes)
+{
+    static Command zero;
+    Command command = zero;
+    command.flags = (int32_t) Bytes_GetVarint(bytes);
+    command.color = (Color) Bytes_GetVarint(bytes);
+    command.age = (Age) Bytes_GetVarint(bytes);
+    command.civ = (Civ) Bytes_GetVarint(bytes);
+    command.xres = (int32_t) Bytes_GetVarint(bytes);
+    command.yres = (int32_t) Bytes_GetVarint(bytes);
+    command.pan = GetPoint(bytes);
+    command.cursor = GetPoint(bytes);
+    command.sequence = (int32_t) Bytes_GetVarint(bytes);
+    command.hotkey = -1;
+    if(command.flags & COMMAND_BOX)
+    {
+        command.selection_box.a = GetPoint(bytes);
+        command.selection_box.b = GetPoint(bytes);
+    }
+    if(command.flags & COMMAND_SPAWN)
+    {
+        command.hotkey = (int32_t) Bytes_GetZigzag(bytes);
+        command.motive.action = (Action) Bytes_GetZigzag(bytes);
+        command.motive.type = (Type) Bytes_GetZigzag(bytes);
+        command.bits = (Bits) Bytes_GetVarint(bytes);
+    }
+    if(command.color >= COLOR_COUNT)
+        bytes->is_bad = true;
+    return command;
+}
+
+// WHAT COMMAND_DECODE GIVES BACK: THE BOX ONLY WHEN IT WAS DRAGGED, AND THE BUTTON STATE ONLY WHEN
+// SOMETHING WAS SPAWNED.
+Command Command_Trim(Command command)
+{
+    static Rect box;
+    static Motive motive;
+    if(!(command.flags & COMMAND_BOX))
+        command.selection_box = box;
+    if(!(command.flags & COMMAND_SPAWN))
+    {
+        command.hotkey = -1;
+        command.motive = motive;
+        command.bits = 0;
+    }
+    return command;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Overview.h"
+#include "Bytes.h"
+
+#include <stdint.h>
+
+// THE DISCRETE ACTION A PLAYER TOOK. ONLY THE OVERVIEW FIELDS THE SIMULATION READS WHEN SERVICING
+// THAT ACTION ARE CARRIED - THE VIEWPORT TO RESOLVE THE CURSOR, THE BOX FOR A BOX SELECT, AND THE
+// HOTKEY, MOTIVE, AND TRIGGER BITS FOR A SPAWN. EVERYTHING ELSE STAYS ON THE CLIENT. THE SEQUENCE
+// COUNTS THE COMMANDS A CLIENT SENT, SO THE CLIENT CAN TELL WHICH OF ITS COMMANDS A TURN CARRIES.
+
+#define COMMAND_SELECT  (1 << 0)
+#define COMMAND_SIMILAR (1 << 1)
+#define COMMAND_BOX     (1 << 2)
+#define COMMAND_MOVE    (1 << 3)
+#define COMMAND_SPAWN   (1 << 4)
+
+typedef struct
+{
+    Rect selection_box;
+    Point pan;
+    Point cursor;
+    Motive motive;
+    Bits bits;
+    Color color;
+    Age age;
+    Civ civ;
+    int32_t xres;
+    int32_t yres;
+    int32_t hotkey;
+    int32_t flags;
+    int32_t sequence;
+}
+Command;
+
+Command Command_FromOverview(const Overview);
+
+Overview Command_ToOverview(const Command);
+
+void Command_Encode(const Command, Bytes* const);
+
+Command Command_Decode(Bytes* const);
+
+Command Command_Trim(Command);
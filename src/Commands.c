@@ -0,0 +1,77 @@
+#include "Commands.h"
+
+#include "Command.h"
+#include "Config.h"
+#include "Util.h"
+
+Commands Commands_Init(void)
+{
+    static Commands zero;
+    Commands commands = zero;
+    commands.overview = UTIL_ALLOC(Overview, CONFIG_SOCKETS_COMMANDS_MAX);
+    return commands;
+}
+
+// A MOVE UNDOES THE MOVE BEFORE IT, AS BOTH SEND THE SAME SELECTION, AND A SELECTION CLEARS THE
+// SELECTION BEFORE IT, UNLESS IT SELECTS THINGS LIKE WHAT IS ALREADY SELECTED.
+static bool Supersedes(const Overview later, const Overview earlier)
+{
+    const int32_t a = Command_FromOverview(later).flags;
+    const int32_t b = Command_FromOverview(earlier).flags;
+    const int32_t select = COMMAND_SELECT | COMMAND_BOX;
+    return (a == COMMAND_MOVE && b == COMMAND_MOVE)
+        || ((a & COMMAND_SELECT) && (a & ~select) == 0 && (b & COMMAND_SELECT) && (b & ~(select | COMMAND_SIMILAR)) == 0);
+}
+
+static bool IsSuperseding(const Commands commands, const Overview overview)
+{
+    return Commands_Active(commands)
+        && Supersedes(overview, commands.overview[UTIL_WRAP(commands.b - 1, CONFIG_SOCKETS_COMMANDS_MAX)]);
+}
+
+// A COMMAND THAT DOES NOT FIT IS NOT QUEUED.
+Commands Commands_Queue(Commands commands, const Overview overview)
+{
+    if(IsSuperseding(commands, overview))
+        commands.overview[UTIL_WRAP(commands.b - 1, CONFIG_SOCKETS_COMMANDS_MAX)] = overview;
+    else if(Commands_Size(commands) < CONFIG_SOCKETS_COMMANDS_MAX)
+        commands.overview[UTIL_WRAP(commands.b++, CONFIG_SOCKETS_COMMANDS_MAX)] = overview;
+    return commands;
+}
+
+// AN EMPTY QUEUE PEEKS AN OVERVIEW WITHOUT AN ACTION.
+Overview Commands_Peek(const Commands commands)
+{
+    static Overview zero;
+    if(!Commands_Active(commands))
+        return zero;
+    return commands.overview[UTIL_WRAP(commands.a, CONFIG_SOCKETS_COMMANDS_MAX)];
+}
+
+Commands Commands_Pop(Commands commands)
+{
+    if(Commands_Active(commands))
+        commands.a++;
+    return commands;
+}
+
+void Commands_Free(const Commands commands)
+{
+    free(commands.overview);
+}
+
+int32_t Commands_Size(const Commands commands)
+{
+    return commands.b - commands.a;
+}
+
+bool Commands_Active(const Commands commands)
+{
+    return Commands_Size(commands) > 0;
+}
+
+bool Commands_Fits(const Commands commands, const Overview overview)
+{
+    return Commands_Size(commands) < CONFIG_SOCKETS_COMMANDS_MAX
+        || IsSuperseding(commands, overview);
+}
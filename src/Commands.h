@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Overview.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// THE COMMANDS A CLIENT SENT THE SERVER, IN THE ORDER THEY ARRIVED, EACH AN OVERVIEW AS A TURN
+// CARRIES IT. A TURN HOLDS ONE COMMAND PER SLOT, SO COMMANDS ARRIVING FASTER THAN TURNS LEAVE
+// WAIT HERE. A COMMAND THAT SUPERSEDES THE ONE QUEUED LAST TAKES ITS PLACE, SO A BURST OF MOVES OR
+// OF SELECTIONS COSTS ONE TURN. THE QUEUE HOLDS CONFIG_SOCKETS_COMMANDS_MAX COMMANDS, AND ONE THAT
+// ARRIVES WHILE IT IS FULL IS DROPPED, SO A CLIENT FLOODING THE SERVER NEITHER GROWS ITS MEMORY NOR
+// DELAYS ITS OWN COMMANDS PAST THAT MANY TURNS.
+
+typedef struct
+{
+    Overview* overview;
+    int32_t a;
+    int32_t b;
+}
+Commands;
+
+Commands Commands_Init(void);
+
+Commands Commands_Queue(Commands, const Overview);
+
+Overview Commands_Peek(const Commands);
+
+Commands Commands_Pop(Commands);
+
+void Commands_Free(const Commands);
+
+int32_t Commands_Size(const Commands);
+
+bool Commands_Active(const Commands);
+
+bool Commands_Fits(const Commands, const Overview);
@@ -42,9 +42,13 @@
 
 #define CONFIG_UNITS_REPATH_SLICE_SIZE (10)
 
-#define CONFIG_UNITS_MAX (65536)
+#define CONFIG_UNITS_ENTROPY_BATCH (256)
+
+#define CONFIG_UNITS_FLOCK_SIZE (64)
 
-#define CONFIG_UNITS_CLEANUP_FIRE (6000)
+#define CONFIG_UNITS_SELECTION_SIZE (64)
+
+#define CONFIG_UNITS_MAX (65536)
 
 #define CONFIG_UNITS_CLEANUP_RUBBLE (12000)
 
@@ -56,6 +60,10 @@
 
 #define CONFIG_UNITS_FLOAT_BUFFER (16)
 
+#define CONFIG_EFFECTS_MAX (8192)
+
+#define CONFIG_EFFECTS_CLEANUP_FIRE (6000)
+
 #define CONFIG_SOCKETS_SERVER_TIMEOUT_MS (1)
 
 #define CONFIG_MAIN_LOOP_SPEED_MS (15)
@@ -64,8 +72,58 @@
 
 #define CONFIG_SOCKETS_LATENCY_WINDOW (3)
 
+#define CONFIG_SOCKETS_HEARTBEAT_MS (100)
+
+#define CONFIG_LEAD_WINDOW (64)
+
+#define CONFIG_LEAD_PERCENTILE (95)
+
+#define CONFIG_LEAD_SHRINK_TURNS (20)
+
+#define CONFIG_SOCKETS_REJOIN_PATIENCE (50)
+
+#define CONFIG_SOCKETS_REJOIN_CHUNKS (32)
+
+#define CONFIG_SOCKETS_REJOIN_QUEUED (16384)
+
+#define CONFIG_SOCKETS_REJOIN_BEHIND (8)
+
+#define CONFIG_SOCKETS_COMMANDS_MAX (16)
+
+#define CONFIG_SPECTATORS_KEYFRAME_TURNS (300)
+
+#define CONFIG_SPECTATORS_KEYFRAME_BYTES (1 << 18)
+
+#define CONFIG_SPECTATORS_BEHIND_TURNS (100)
+
+#define CONFIG_ROLLBACK_LEAD (1)
+
+#define CONFIG_ROLLBACK_WINDOW (24)
+
+#define CONFIG_ROLLBACK_RESIM_MS (10)
+
+#define CONFIG_ROLLBACK_REPORT_MS (5000)
+
+#define CONFIG_SWARM_REPORT_MS (10000)
+
+#define CONFIG_TELEMETRY_MS (1000)
+
+#define CONFIG_PARITY_INTERVAL (8)
+
+#define CONFIG_PARITY_HISTORY (512)
+
+#define CONFIG_PARITY_PATIENCE (30)
+
+#define CONFIG_HOST_MATCHES_PER_SHARD (64)
+
+#define CONFIG_HOST_PENDING (64)
+
+#define CONFIG_HOST_SWEEP_MS (1000)
+
+#define CONFIG_HOST_JOIN_TIMEOUT_MS (5000)
+
 #if SANITIZE_ADDRESS == 1 || SANITIZE_THREAD  == 1
-    #define CONFIG_SOCKETS_SERVER_UPDATE_SPEED_CYCLES (1000)
+    #define CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS (1000)
 #else
-    #define CONFIG_SOCKETS_SERVER_UPDATE_SPEED_CYCLES (100)
+    #define CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS (100)
 #endif
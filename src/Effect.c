@@ -0,0 +1,30 @@
+#include "Effect.h"
+
+#include "Config.h"
+
+static int32_t GetExpire(const Graphics file, const Registrar graphics)
+{
+    const Animation animation = graphics.animation[COLOR_GAIA][file];
+    return Graphics_GetExpire(file)
+        ? animation.count * CONFIG_ANIMATION_DIVISOR - 1
+        : CONFIG_EFFECTS_CLEANUP_FIRE;
+}
+
+Effect Effect_Make(Point cart, const Point offset, const Grid grid, const Graphics file, const Registrar graphics)
+{
+    static Effect zero;
+    Effect effect = zero;
+    const Point center = Point_Div(Graphics_GetDimensions(file), 2);
+    cart = Point_Sub(cart, center);
+    const Point cell = Point_Add(Grid_CartToCell(grid, cart), Grid_OffsetToCell(offset));
+    effect.cart = Grid_CellToCart(grid, cell);
+    effect.cart_grid_offset = Grid_CellToOffset(grid, cell);
+    effect.file = file;
+    effect.expire = GetExpire(file, graphics);
+    return effect;
+}
+
+bool Effect_IsExpired(const Effect effect)
+{
+    return effect.timer >= effect.expire;
+}
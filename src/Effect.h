@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Point.h"
+#include "Grid.h"
+#include "Graphics.h"
+#include "Registrar.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// COSMETIC ONLY - EFFECTS NEVER TOUCH THE SIMULATION, THE UNIT STACKS, OR PARITY.
+
+typedef struct
+{
+    Point cart;
+    Point cart_grid_offset;
+    Graphics file;
+    int32_t timer;
+    int32_t expire;
+}
+Effect;
+
+Effect Effect_Make(Point cart, const Point offset, const Grid, const Graphics file, const Registrar graphics);
+
+bool Effect_IsExpired(const Effect);
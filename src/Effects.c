@@ -0,0 +1,64 @@
+#include "Effects.h"
+
+#include "Util.h"
+
+Effects Effects_New(const int32_t max)
+{
+    static Effects zero;
+    Effects effects = zero;
+    effects.effect = UTIL_ALLOC(Effect, max);
+    effects.max = max;
+    effects.seed = 1;
+    return effects;
+}
+
+void Effects_Free(const Effects effects)
+{
+    free(effects.effect);
+}
+
+static Effects Append(Effects effects, const Effect effect)
+{
+    if(effects.count < effects.max)
+        effects.effect[effects.count++] = effect;
+    return effects;
+}
+
+Effects Effects_SpawnParts(Effects effects, const Point cart, const Point offset, const Grid grid, const Registrar graphics, const Parts parts)
+{
+    if(effects.is_quiet)
+        return effects;
+    for(int32_t i = 0; i < parts.count; i++)
+    {
+        const Part part = parts.part[i];
+        const Point cart_part = Point_Add(cart, part.cart);
+        effects = Append(effects, Effect_Make(cart_part, offset, grid, part.file, graphics));
+    }
+    return effects;
+}
+
+// EFFECTS KEEP THEIR OWN SEED SO THAT A BURNING BUILDING NEVER SHIFTS THE SIMULATION RANDOM SEQUENCE.
+Effects Effects_SpawnFire(Effects effects, const Point cart, const Grid grid, const Registrar graphics)
+{
+    if(effects.is_quiet)
+        return effects;
+    const int32_t w = grid.tile_cart_width;
+    const int32_t h = grid.tile_cart_height;
+    const Point offset = {
+        Util_RandNext(&effects.seed) % w - w / 2,
+        Util_RandNext(&effects.seed) % h - h / 2,
+    };
+    const Parts parts = Parts_GetFire(Util_RandNext(&effects.seed));
+    return Effects_SpawnParts(effects, cart, offset, grid, graphics, parts);
+}
+
+// ORDER DOES NOT MATTER - EXPIRED EFFECTS ARE SWAPPED WITH THE LAST EFFECT.
+Effects Effects_Caretake(Effects effects)
+{
+    for(int32_t i = 0; i < effects.count; i++)
+        effects.effect[i].timer++;
+    for(int32_t i = 0; i < effects.count; i++)
+        while(i < effects.count && Effect_IsExpired(effects.effect[i]))
+            effects.effect[i] = effects.effect[--effects.count];
+    return effects;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Effect.h"
+#include "Parts.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A FIXED SIZE POOL. WHEN FULL, NEW EFFECTS ARE DROPPED - NOTHING DEPENDS ON THEM. A QUIET POOL
+// SPAWNS NOTHING, SO THAT CYCLES SIMULATED AGAIN AFTER A ROLLBACK, OR TICKED HEADLESS TO CATCH UP,
+// NEVER SPAWN WHAT WAS ALREADY SPAWNED OR WILL NEVER BE SEEN. THE POOL IS NOT PART OF A SNAPSHOT, SO
+// THE EFFECTS OF THE FIRST TIME THROUGH SURVIVE A REWIND.
+
+typedef struct
+{
+    Effect* effect;
+    int32_t count;
+    int32_t max;
+    uint32_t seed;
+    bool is_quiet;
+}
+Effects;
+
+Effects Effects_New(const int32_t max);
+
+void Effects_Free(const Effects);
+
+Effects Effects_SpawnParts(Effects, const Point cart, const Point offset, const Grid, const Registrar, const Parts);
+
+Effects Effects_SpawnFire(Effects, const Point cart, const Grid, const Registrar);
+
+Effects Effects_Caretake(Effects);
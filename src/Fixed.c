@@ -0,0 +1,215 @@
+#include "Fixed.h"
+
+#include "Util.h"
+
+#if SIMD == 1 && defined(__SSE2__)
+    #include <immintrin.h>
+#endif
+
+#define SATURATE(root) ((root) > INT32_MAX ? INT32_MAX : (int32_t) (root))
+
+// DIGIT BY DIGIT - NO DIVISIONS, NO FLOATING POINT, NO DATA DEPENDENT BRANCHES IN THE MAIN LOOP.
+static uint64_t SqrtScalar(uint64_t value)
+{
+    int32_t shift = 62;
+    while(shift > 0 && (value >> shift) == 0)
+        shift -= 2;
+    uint64_t root = 0;
+    for(uint64_t bit = (uint64_t) 1 << shift; bit != 0; bit >>= 2)
+    {
+        const uint64_t trial = root + bit;
+        const uint64_t mask = (uint64_t) 0 - (uint64_t) (value >= trial);
+        value -= trial & mask;
+        root = (root >> 1) + (bit & mask);
+    }
+    return root;
+}
+
+int32_t Fixed_Sqrt(const uint64_t value)
+{
+    const uint64_t root = SqrtScalar(value);
+    return SATURATE(root);
+}
+
+static Point Scale(const Point point, const int32_t normal, const int32_t magnitude)
+{
+    static Point zero;
+    if(magnitude == 0)
+        return zero;
+    const Point out = {
+        (int32_t) ((int64_t) point.x * normal / magnitude),
+        (int32_t) ((int64_t) point.y * normal / magnitude),
+    };
+    return out;
+}
+
+#if SIMD == 1 && defined(__SSE2__)
+
+// THE DOUBLE PRECISION ESTIMATE IS NEVER MORE THAN ONE AWAY FROM THE TRUE ROOT FOR
+// INPUTS BELOW 2^64. THE INTEGER FIXUP THAT FOLLOWS MAKES THE RESULT EXACT.
+
+static __m128i GreaterThanU64(const __m128i a, const __m128i b)
+{
+    const __m128i bias = _mm_set1_epi32(INT32_MIN);
+    const __m128i aa = _mm_xor_si128(a, bias);
+    const __m128i bb = _mm_xor_si128(b, bias);
+    const __m128i gt = _mm_cmpgt_epi32(aa, bb);
+    const __m128i eq = _mm_cmpeq_epi32(aa, bb);
+    const __m128i hi = _mm_or_si128(gt, _mm_and_si128(eq, _mm_slli_epi64(gt, 32)));
+    return _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+static __m128i FixupSse2(__m128i root, const __m128i square)
+{
+    const __m128i one = _mm_set_epi32(0, 1, 0, 1);
+    const __m128i over = GreaterThanU64(_mm_mul_epu32(root, root), square);
+    root = _mm_add_epi64(root, over);
+    const __m128i next = _mm_add_epi64(root, one);
+    const __m128i under = GreaterThanU64(_mm_mul_epu32(next, next), square);
+    root = _mm_add_epi64(root, _mm_andnot_si128(under, one));
+    const __m128i max = _mm_set_epi32(0, INT32_MAX, 0, INT32_MAX);
+    const __m128i saturate = GreaterThanU64(root, max);
+    return _mm_or_si128(_mm_and_si128(saturate, max), _mm_andnot_si128(saturate, root));
+}
+
+static __m128i ToU64Sse2(const __m128d value)
+{
+    const __m128d magic = _mm_set1_pd(4503599627370496.0); // 2^52.
+    return _mm_sub_epi64(_mm_castpd_si128(_mm_add_pd(value, magic)), _mm_castpd_si128(magic));
+}
+
+static __m128i AbsSse2(const __m128i a)
+{
+    const __m128i sign = _mm_srai_epi32(a, 31);
+    return _mm_sub_epi32(_mm_xor_si128(a, sign), sign);
+}
+
+// TWO POINTS PER ITERATION: X0 Y0 X1 Y1.
+static __m128i MagSse2(const __m128i xy)
+{
+    const __m128i abs = AbsSse2(xy);
+    const __m128i xx = _mm_mul_epu32(abs, abs);
+    const __m128i yy = _mm_mul_epu32(_mm_srli_epi64(abs, 32), _mm_srli_epi64(abs, 32));
+    const __m128i square = _mm_add_epi64(xx, yy);
+    const __m128i split = _mm_shuffle_epi32(xy, _MM_SHUFFLE(3, 1, 2, 0));
+    const __m128d dx = _mm_cvtepi32_pd(split);
+    const __m128d dy = _mm_cvtepi32_pd(_mm_srli_si128(split, 8));
+    const __m128d estimate = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+    const __m128i root = FixupSse2(ToU64Sse2(estimate), square);
+    return _mm_shuffle_epi32(root, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+#endif
+
+#if SIMD == 1 && defined(__AVX2__)
+
+static __m256i GreaterThanU64Avx2(const __m256i a, const __m256i b)
+{
+    const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+    return _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+}
+
+// FOUR POINTS PER ITERATION: X0 Y0 X1 Y1 X2 Y2 X3 Y3.
+static __m128i MagAvx2(const __m256i xy)
+{
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i max = _mm256_set1_epi64x(INT32_MAX);
+    const __m256i abs = _mm256_abs_epi32(xy);
+    const __m256i xx = _mm256_mul_epu32(abs, abs);
+    const __m256i yy = _mm256_mul_epu32(_mm256_srli_epi64(abs, 32), _mm256_srli_epi64(abs, 32));
+    const __m256i square = _mm256_add_epi64(xx, yy);
+    const __m256i split = _mm256_permutevar8x32_epi32(xy, _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7));
+    const __m256d dx = _mm256_cvtepi32_pd(_mm256_castsi256_si128(split));
+    const __m256d dy = _mm256_cvtepi32_pd(_mm256_extracti128_si256(split, 1));
+    const __m256d estimate = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+    const __m256d magic = _mm256_set1_pd(4503599627370496.0); // 2^52.
+    __m256i root = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(estimate, magic)), _mm256_castpd_si256(magic));
+    root = _mm256_add_epi64(root, GreaterThanU64Avx2(_mm256_mul_epu32(root, root), square));
+    const __m256i next = _mm256_add_epi64(root, one);
+    root = _mm256_add_epi64(root, _mm256_andnot_si256(GreaterThanU64Avx2(_mm256_mul_epu32(next, next), square), one));
+    root = _mm256_blendv_epi8(root, max, GreaterThanU64Avx2(root, max));
+    const __m256i packed = _mm256_permutevar8x32_epi32(root, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6));
+    return _mm256_castsi256_si128(packed);
+}
+
+#endif
+
+int32_t Fixed_Mag(const Point point)
+{
+#if SIMD == 1 && defined(__SSE2__)
+    const __m128i xy = _mm_set_epi32(0, 0, point.y, point.x);
+    return _mm_cvtsi128_si32(MagSse2(xy));
+#else
+    return Fixed_Sqrt(
+            (uint64_t) point.x * (uint64_t) point.x +
+            (uint64_t) point.y * (uint64_t) point.y);
+#endif
+}
+
+Point Fixed_Normalize(const Point point, const int32_t normal)
+{
+    return Scale(point, normal, Fixed_Mag(point));
+}
+
+Point Fixed_Clamp(const Point point, const int32_t max)
+{
+    const int32_t magnitude = Fixed_Mag(point);
+    return magnitude > max
+        ? Scale(point, max, magnitude)
+        : point;
+}
+
+void Fixed_MagBatch(const Point in[], int32_t out[], const int32_t count)
+{
+    int32_t i = 0;
+#if SIMD == 1 && defined(__AVX2__)
+    for(; i + 4 <= count; i += 4)
+    {
+        const __m256i xy = _mm256_loadu_si256((const __m256i*) &in[i]);
+        _mm_storeu_si128((__m128i*) &out[i], MagAvx2(xy));
+    }
+#endif
+#if SIMD == 1 && defined(__SSE2__)
+    for(; i + 2 <= count; i += 2)
+    {
+        const __m128i xy = _mm_loadu_si128((const __m128i*) &in[i]);
+        _mm_storel_epi64((__m128i*) &out[i], MagSse2(xy));
+    }
+#endif
+    for(; i < count; i++)
+        out[i] = Fixed_Mag(in[i]);
+}
+
+void Fixed_NormalizeBatch(const Point in[], Point out[], const int32_t normal[], const int32_t count)
+{
+    if(count == 0)
+        return;
+    int32_t* const magnitude = UTIL_ALLOC(int32_t, count);
+    Fixed_MagBatch(in, magnitude, count);
+    for(int32_t i = 0; i < count; i++)
+        out[i] = Scale(in[i], normal[i], magnitude[i]);
+    free(magnitude);
+}
+
+void Fixed_ClampBatch(Point point[], const int32_t max[], const int32_t count)
+{
+    if(count == 0)
+        return;
+    int32_t* const magnitude = UTIL_ALLOC(int32_t, count);
+    Fixed_MagBatch(point, magnitude, count);
+    for(int32_t i = 0; i < count; i++)
+        if(magnitude[i] > max[i])
+            point[i] = Scale(point[i], max[i], magnitude[i]);
+    free(magnitude);
+}
+
+const char* Fixed_GetPath(void)
+{
+#if SIMD == 1 && defined(__AVX2__)
+    return "AVX2";
+#elif SIMD == 1 && defined(__SSE2__)
+    return "SSE2";
+#else
+    return "SCALAR";
+#endif
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Point.h"
+
+#include <stdint.h>
+
+// DETERMINISTIC FIXED POINT VECTOR MATH. THE SCALAR, SSE2, AND AVX2 PATHS ALL COMPUTE THE
+// EXACT FLOOR OF THE SQUARE ROOT (SATURATED TO INT32_MAX), SO EVERY PATH IS BIT IDENTICAL
+// AND LOCKSTEP PARITY HOLDS NO MATTER WHICH PATH A CLIENT WAS BUILT WITH.
+
+int32_t Fixed_Sqrt(const uint64_t);
+
+int32_t Fixed_Mag(const Point);
+
+Point Fixed_Normalize(const Point, const int32_t normal);
+
+Point Fixed_Clamp(const Point, const int32_t max);
+
+void Fixed_MagBatch(const Point in[], int32_t out[], const int32_t count);
+
+void Fixed_NormalizeBatch(const Point in[], Point out[], const int32_t normal[], const int32_t count);
+
+void Fixed_ClampBatch(Point point[], const int32_t max[], const int32_t count);
+
+const char* Fixed_GetPath(void);
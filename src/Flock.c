@@ -0,0 +1,202 @@
+#include "Flock.h"
+
+#include "Fixed.h"
+#include "Config.h"
+#include "Util.h"
+
+#if SIMD == 1 && defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+// THE AVX2 KERNEL NORMALIZES WITH DOUBLES. THE PRODUCT DIFF * WIDTH IS EXACT AND THE TRUNCATED
+// QUOTIENT CANNOT ROUND ACROSS AN INTEGER AS LONG AS THE WIDTH STAYS BELOW 2^26.
+#define EXACT_WIDTH (1 << 26)
+
+Flock Flock_Make(const int32_t max)
+{
+    static Flock zero;
+    Flock flock = zero;
+    flock.diff = UTIL_ALLOC(Point, max);
+    flock.velocity = UTIL_ALLOC(Point, max);
+    flock.width = UTIL_ALLOC(int32_t, max);
+    flock.command_group = UTIL_ALLOC(int32_t, max);
+    flock.color = UTIL_ALLOC(int32_t, max);
+    flock.mag = UTIL_ALLOC(int32_t, max);
+    flock.max = max;
+    return flock;
+}
+
+void Flock_Free(const Flock flock)
+{
+    free(flock.diff);
+    free(flock.velocity);
+    free(flock.width);
+    free(flock.command_group);
+    free(flock.color);
+    free(flock.mag);
+}
+
+static Flock Grow(Flock flock)
+{
+    flock.max *= 2;
+    flock.diff = UTIL_REALLOC(flock.diff, Point, flock.max);
+    flock.velocity = UTIL_REALLOC(flock.velocity, Point, flock.max);
+    flock.width = UTIL_REALLOC(flock.width, int32_t, flock.max);
+    flock.command_group = UTIL_REALLOC(flock.command_group, int32_t, flock.max);
+    flock.color = UTIL_REALLOC(flock.color, int32_t, flock.max);
+    flock.mag = UTIL_REALLOC(flock.mag, int32_t, flock.max);
+    return flock;
+}
+
+static Flock Append(Flock flock, Unit* const unit, Unit* const other)
+{
+    if(flock.count == flock.max)
+        flock = Grow(flock);
+    const int32_t i = flock.count++;
+    flock.diff[i] = Point_Sub(other->cell, unit->cell);
+    flock.velocity[i] = other->velocity;
+    flock.width[i] = other->trait.width;
+    flock.command_group[i] = other->command_group;
+    flock.color[i] = (int32_t) other->color;
+    flock.width_max = UTIL_MAX(flock.width_max, other->trait.width);
+    return flock;
+}
+
+// THE NEIGHBORHOOD IS CLIPPED TO THE MAP ONCE, SO EACH STACK IS READ WITHOUT A BOUNDS CHECK.
+Flock Flock_Gather(Flock flock, const Units units, Unit* const unit)
+{
+    flock.count = 0;
+    flock.width_max = 0;
+    const int32_t width = 1;
+    const int32_t x0 = UTIL_MAX(unit->cart.x - width, 0);
+    const int32_t y0 = UTIL_MAX(unit->cart.y - width, 0);
+    const int32_t x1 = UTIL_MIN(unit->cart.x + width, units.cols - 1);
+    const int32_t y1 = UTIL_MIN(unit->cart.y + width, units.rows - 1);
+    for(int32_t y = y0; y <= y1; y++)
+    for(int32_t x = x0; x <= x1; x++)
+    {
+        const Stack stack = units.stack[x + y * units.cols];
+        for(int32_t i = 0; i < stack.count; i++)
+        {
+            Unit* const other = stack.reference[i];
+            if(!Unit_IsExempt(other) && Unit_IsDifferent(unit, other))
+                flock = Append(flock, unit, other);
+        }
+    }
+    Fixed_MagBatch(flock.diff, flock.mag, flock.count);
+    return flock;
+}
+
+typedef struct
+{
+    Point separation;
+    Point alignment;
+    int32_t nudges;
+}
+Sum;
+
+static Sum SteerScalar(const Flock flock, Unit* const unit, Sum sum, const int32_t start)
+{
+    for(int32_t i = start; i < flock.count; i++)
+    {
+        const Point diff = flock.diff[i];
+        if(Point_IsZero(diff))
+            sum.nudges += 1;
+        else
+        {
+            const int32_t width = UTIL_MAX(unit->trait.width, flock.width[i]);
+            if(flock.mag[i] < width)
+            {
+                const Point force = Point_Sub(Fixed_Normalize(diff, width), diff);
+                sum.separation = Point_Sub(sum.separation, force);
+            }
+        }
+        if(flock.command_group[i] == unit->command_group
+        && flock.color[i] == (int32_t) unit->color)
+            sum.alignment = Point_Add(sum.alignment, flock.velocity[i]);
+    }
+    return sum;
+}
+
+#if SIMD == 1 && defined(__AVX2__)
+
+static int32_t Total(const __m128i a)
+{
+    const __m128i b = _mm_add_epi32(a, _mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2)));
+    const __m128i c = _mm_add_epi32(b, _mm_shuffle_epi32(b, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(c);
+}
+
+// FOUR NEIGHBORS PER ITERATION. POINTS ARE SPLIT INTO X AND Y LANES, AND EVERY BRANCH OF THE
+// SCALAR PATH BECOMES A MASK. INTEGER SUMS WRAP THE SAME WAY IN ANY ORDER.
+static Sum SteerAvx2(const Flock flock, Unit* const unit, Sum sum, int32_t* const start)
+{
+    const __m256i split = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i unit_width = _mm_set1_epi32(unit->trait.width);
+    const __m128i unit_command_group = _mm_set1_epi32(unit->command_group);
+    const __m128i unit_color = _mm_set1_epi32((int32_t) unit->color);
+    __m128i separation_x = zero;
+    __m128i separation_y = zero;
+    __m128i alignment_x = zero;
+    __m128i alignment_y = zero;
+    __m128i nudges = zero;
+    int32_t i = 0;
+    for(; i + 4 <= flock.count; i += 4)
+    {
+        const __m256i diff = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &flock.diff[i]), split);
+        const __m256i velocity = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &flock.velocity[i]), split);
+        const __m128i dx = _mm256_castsi256_si128(diff);
+        const __m128i dy = _mm256_extracti128_si256(diff, 1);
+        const __m128i mag = _mm_loadu_si128((const __m128i*) &flock.mag[i]);
+        const __m128i width = _mm_max_epi32(unit_width, _mm_loadu_si128((const __m128i*) &flock.width[i]));
+        const __m128i is_zero = _mm_and_si128(_mm_cmpeq_epi32(dx, zero), _mm_cmpeq_epi32(dy, zero));
+        const __m128i is_near = _mm_andnot_si128(is_zero, _mm_cmplt_epi32(mag, width));
+        const __m256d w = _mm256_cvtepi32_pd(width);
+        const __m256d m = _mm256_cvtepi32_pd(_mm_max_epi32(mag, one));
+        const __m128i nx = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(dx), w), m));
+        const __m128i ny = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(dy), w), m));
+        separation_x = _mm_sub_epi32(separation_x, _mm_and_si128(is_near, _mm_sub_epi32(nx, dx)));
+        separation_y = _mm_sub_epi32(separation_y, _mm_and_si128(is_near, _mm_sub_epi32(ny, dy)));
+        nudges = _mm_sub_epi32(nudges, is_zero);
+        const __m128i command_group = _mm_loadu_si128((const __m128i*) &flock.command_group[i]);
+        const __m128i color = _mm_loadu_si128((const __m128i*) &flock.color[i]);
+        const __m128i in_platoon = _mm_and_si128(_mm_cmpeq_epi32(command_group, unit_command_group), _mm_cmpeq_epi32(color, unit_color));
+        alignment_x = _mm_add_epi32(alignment_x, _mm_and_si128(in_platoon, _mm256_castsi256_si128(velocity)));
+        alignment_y = _mm_add_epi32(alignment_y, _mm_and_si128(in_platoon, _mm256_extracti128_si256(velocity, 1)));
+    }
+    const Point separation = { Total(separation_x), Total(separation_y) };
+    const Point alignment = { Total(alignment_x), Total(alignment_y) };
+    sum.separation = Point_Add(sum.separation, separation);
+    sum.alignment = Point_Add(sum.alignment, alignment);
+    sum.nudges += Total(nudges);
+    *start = i;
+    return sum;
+}
+
+#endif
+
+void Flock_Steer(const Flock flock, Unit* const unit, Point* const separation, Point* const alignment)
+{
+    static Sum zero;
+    Sum sum = zero;
+    int32_t start = 0;
+#if SIMD == 1 && defined(__AVX2__)
+    if(UTIL_MAX(flock.width_max, unit->trait.width) < EXACT_WIDTH)
+        sum = SteerAvx2(flock, unit, sum, &start);
+#endif
+    sum = SteerScalar(flock, unit, sum, start);
+    const Point nudge = Point_Mul(Unit_Nudge(unit), sum.nudges);
+    *separation = Point_Div(Point_Sub(sum.separation, nudge), CONFIG_UNITS_SEPARATION_DIVISOR);
+    *alignment = Point_Div(sum.alignment, CONFIG_UNITS_ALIGN_DIVISOR);
+}
+
+const char* Flock_GetPath(void)
+{
+#if SIMD == 1 && defined(__AVX2__)
+    return "AVX2";
+#else
+    return "SCALAR";
+#endif
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Units.h"
+
+#include <stdint.h>
+
+// A SMALL STRUCTURE OF ARRAYS HOLDING THE 3X3 NEIGHBORHOOD OF A SINGLE UNIT.
+// SEPARATION AND ALIGNMENT ARE BOTH COMPUTED FROM ONE GATHER, AND THE AVX2 KERNEL
+// MATCHES THE SCALAR PATH EXACTLY SO THAT LOCKSTEP PARITY IS KEPT ACROSS BUILDS.
+
+typedef struct
+{
+    Point* diff;
+    Point* velocity;
+    int32_t* width;
+    int32_t* command_group;
+    int32_t* color;
+    int32_t* mag;
+    int32_t width_max;
+    int32_t count;
+    int32_t max;
+}
+Flock;
+
+Flock Flock_Make(const int32_t max);
+
+void Flock_Free(const Flock);
+
+Flock Flock_Gather(Flock, const Units, Unit* const);
+
+void Flock_Steer(const Flock, Unit* const, Point* const separation, Point* const alignment);
+
+const char* Flock_GetPath(void);
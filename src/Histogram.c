@@ -0,0 +1,67 @@
+#include "Histogram.h"
+
+#include "Util.h"
+
+#define OCTAVE (6)
+
+static int32_t GetOctave(const int32_t ms)
+{
+    int32_t octave = 0;
+    while((ms >> (octave + 1)) > 0)
+        octave++;
+    return octave;
+}
+
+int32_t Histogram_GetBucket(const int32_t ms)
+{
+    if(ms < HISTOGRAM_EXACT)
+        return UTIL_MAX(0, ms);
+    const int32_t octave = GetOctave(ms);
+    const int32_t step = (ms >> (octave - 3)) & (HISTOGRAM_STEPS - 1);
+    return UTIL_MIN(HISTOGRAM_BUCKETS - 1, HISTOGRAM_EXACT + (octave - OCTAVE) * HISTOGRAM_STEPS + step);
+}
+
+int32_t Histogram_GetEdge(const int32_t bucket)
+{
+    if(bucket < HISTOGRAM_EXACT)
+        return bucket;
+    const int32_t octave = OCTAVE + (bucket - HISTOGRAM_EXACT) / HISTOGRAM_STEPS;
+    const int32_t step = (bucket - HISTOGRAM_EXACT) % HISTOGRAM_STEPS;
+    return (HISTOGRAM_STEPS + step) << (octave - 3);
+}
+
+void Histogram_Add(Histogram* const histogram, const int32_t ms)
+{
+    histogram->bucket[Histogram_GetBucket(ms)]++;
+    histogram->count++;
+    histogram->max = UTIL_MAX(histogram->max, ms);
+    histogram->sum += ms;
+}
+
+void Histogram_Merge(Histogram* const histogram, const Histogram* const other)
+{
+    for(int32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+        histogram->bucket[i] += other->bucket[i];
+    histogram->count += other->count;
+    histogram->max = UTIL_MAX(histogram->max, other->max);
+    histogram->sum += other->sum;
+}
+
+// ZERO WHEN EMPTY.
+int32_t Histogram_Percentile(const Histogram* const histogram, const int32_t percent)
+{
+    const int64_t rank = ((int64_t) histogram->count * percent + 99) / 100;
+    int64_t seen = 0;
+    for(int32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        seen += histogram->bucket[i];
+        if(seen >= rank && seen > 0)
+            return UTIL_MIN(Histogram_GetEdge(i), histogram->max);
+    }
+    return 0;
+}
+
+double Histogram_Mean(const Histogram* const histogram)
+{
+    return histogram->count > 0 ? (double) histogram->sum / histogram->count : 0.0;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+
+// MILLISECONDS COUNTED INTO BUCKETS: ONE PER MILLISECOND UP TO THE EXACT LIMIT, AND THEN EIGHT PER
+// DOUBLING, SO A PERCENTILE IS NEVER MORE THAN AN EIGHTH OFF HOWEVER LONG THE TAIL. PERCENTILES ARE
+// THE LOWER EDGE OF THEIR BUCKET. THE MAXIMUM AND THE SUM ARE EXACT.
+
+#define HISTOGRAM_EXACT (64)
+
+#define HISTOGRAM_STEPS (8)
+
+#define HISTOGRAM_BUCKETS (HISTOGRAM_EXACT + 12 * HISTOGRAM_STEPS)
+
+typedef struct
+{
+    int32_t bucket[HISTOGRAM_BUCKETS];
+    int32_t count;
+    int32_t max;
+    int64_t sum;
+}
+Histogram;
+
+int32_t Histogram_GetBucket(const int32_t ms);
+
+int32_t Histogram_GetEdge(const int32_t bucket);
+
+void Histogram_Add(Histogram* const, const int32_t ms);
+
+void Histogram_Merge(Histogram* const, const Histogram* const);
+
+int32_t Histogram_Percentile(const Histogram* const, const int32_t percent);
+
+double Histogram_Mean(const Histogram* const);
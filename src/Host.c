@@ -0,0 +1,163 @@
+#include "Host.h"
+
+#include "Config.h"
+#include "Util.h"
+
+#include <SDL2/SDL_timer.h>
+
+#define TAG_LISTEN (0)
+#define TAG_PENDING (1)
+
+static TCPsocket Listen(const int32_t port)
+{
+    IPaddress ip;
+    SDLNet_ResolveHost(&ip, NULL, port);
+    const TCPsocket socket = SDLNet_TCP_Open(&ip);
+    if(socket == NULL)
+        Util_Bomb("HOST - COULD NOT LISTEN ON PORT %d\n", port);
+    return socket;
+}
+
+static void Reject(Host* const host, const int32_t index)
+{
+    Wire* const wire = host->pending[index];
+    Poll_Unwatch(host->poll, wire->socket);
+    TCPsocket socket = wire->socket;
+    Wire_Free(wire);
+    SDLNet_TCP_Close(socket);
+    host->pending[index] = NULL;
+}
+
+// WITH EVERY PENDING SLOT TAKEN THE CONNECTION IS CLOSED AND THE CLIENT SIMPLY RETRIES.
+static void Accept(Host* const host)
+{
+    const TCPsocket client = SDLNet_TCP_Accept(host->self);
+    if(client)
+    {
+        for(int32_t i = 0; i < CONFIG_HOST_PENDING; i++)
+            if(host->pending[i] == NULL)
+            {
+                host->pending[i] = Wire_Make(client);
+                host->pending_since[i] = SDL_GetTicks();
+                Poll_Watch(host->poll, client, TAG_PENDING + i);
+                return;
+            }
+        SDLNet_TCP_Close(client);
+    }
+}
+
+static void Answer(Wire* const wire, const Match match)
+{
+    static Join zero;
+    Join assign = zero;
+    assign.match = match.id;
+    assign.users = match.users;
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Join_Encode(assign, PROTOCOL_ASSIGN, &bytes);
+    Wire_Push(wire, &bytes);
+    Wire_Flush(wire);
+}
+
+// A CLIENT MUST OPEN WITH A JOIN. ANYTHING ELSE, OR NO SEAT, ENDS THE CONNECTION.
+static void Handshake(Host* const host, const int32_t index)
+{
+    Wire* const wire = host->pending[index];
+    if(wire == NULL)
+        return;
+    Wire_Fill(wire);
+    Bytes bytes;
+    if(Wire_Pop(wire, &bytes))
+    {
+        const Join join = Join_Decode(&bytes, PROTOCOL_JOIN);
+        static Match zero;
+        const Match match = Bytes_IsDone(&bytes)
+            ? Matches_Assign(host->matches, join)
+            : zero;
+        Answer(wire, match);
+        if(match.id != 0 && !wire->is_closed)
+        {
+            Poll_Unwatch(host->poll, wire->socket);
+            host->pending[index] = NULL;
+            Shard_Hand(host->shard[match.shard], wire, match);
+            return;
+        }
+        if(match.id != 0)
+            Matches_Leave(host->matches, match.id);
+        Reject(host, index);
+    }
+    else if(wire->is_closed)
+        Reject(host, index);
+}
+
+static void Sweep(Host* const host)
+{
+    const int32_t now = SDL_GetTicks();
+    for(int32_t i = 0; i < CONFIG_HOST_PENDING; i++)
+        if(host->pending[i] && now - host->pending_since[i] > CONFIG_HOST_JOIN_TIMEOUT_MS)
+            Reject(host, i);
+}
+
+static int32_t Run(void* const data)
+{
+    Host* const host = (Host*) data;
+    while(!SDL_AtomicGet(&host->done))
+    {
+        int32_t tags[POLL_EVENTS_MAX];
+        const int32_t count = Poll_Wait(host->poll, tags);
+        for(int32_t i = 0; i < count; i++)
+        {
+            const int32_t tag = tags[i];
+            if(tag == POLL_TIMER)
+                Sweep(host);
+            else if(tag == TAG_LISTEN)
+                Accept(host);
+            else if(tag >= TAG_PENDING)
+                Handshake(host, tag - TAG_PENDING);
+        }
+    }
+    return 0;
+}
+
+Host* Host_Start(const int32_t port, const int32_t shards)
+{
+    Host* const host = UTIL_ALLOC(Host, 1);
+    host->shards = shards;
+    host->matches = Matches_Make(shards, CONFIG_HOST_MATCHES_PER_SHARD);
+    host->shard = UTIL_ALLOC(Shard*, shards);
+    for(int32_t i = 0; i < shards; i++)
+        host->shard[i] = Shard_Start(host->matches, CONFIG_HOST_MATCHES_PER_SHARD);
+    host->poll = Poll_Make(CONFIG_HOST_SWEEP_MS);
+    host->self = Listen(port);
+    Poll_Watch(host->poll, host->self, TAG_LISTEN);
+    host->pending = UTIL_ALLOC(Wire*, CONFIG_HOST_PENDING);
+    host->pending_since = UTIL_ALLOC(int32_t, CONFIG_HOST_PENDING);
+    host->thread = SDL_CreateThread(Run, "N/A", host);
+    return host;
+}
+
+void Host_Wait(Host* const host)
+{
+    SDL_WaitThread(host->thread, NULL);
+    host->thread = NULL;
+}
+
+void Host_Stop(Host* const host)
+{
+    SDL_AtomicSet(&host->done, true);
+    Poll_Wake(host->poll);
+    if(host->thread)
+        SDL_WaitThread(host->thread, NULL);
+    for(int32_t i = 0; i < CONFIG_HOST_PENDING; i++)
+        if(host->pending[i])
+            Reject(host, i);
+    for(int32_t i = 0; i < host->shards; i++)
+        Shard_Stop(host->shard[i]);
+    SDLNet_TCP_Close(host->self);
+    Poll_Free(host->poll);
+    Matches_Free(host->matches);
+    free(host->pending);
+    free(host->pending_since);
+    free(host->shard);
+    free(host);
+}
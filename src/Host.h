@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Shard.h"
+
+// A DEDICATED SERVER FOR MANY MATCHES AT ONCE. ONE THREAD ACCEPTS CONNECTIONS, READS EACH CLIENT'S
+// JOIN, ASSIGNS IT A MATCH FROM THE REGISTRY, ANSWERS, AND HANDS THE CONNECTION TO THE SHARD THAT
+// RUNS THE MATCH. MATCHES ARE SPREAD ACROSS THE SHARDS BY LOAD.
+
+typedef struct
+{
+    Matches* matches;
+    Shard** shard;
+    int32_t shards;
+    Poll poll;
+    TCPsocket self;
+    Wire** pending;
+    int32_t* pending_since;
+    SDL_Thread* thread;
+    SDL_atomic_t done;
+}
+Host;
+
+Host* Host_Start(const int32_t port, const int32_t shards);
+
+void Host_Wait(Host* const);
+
+void Host_Stop(Host* const);
@@ -0,0 +1,111 @@
+#include "Huffman.h"
+
+// CODE LENGTHS BY BYTE VALUE, FROM THE DELTAS OF --bench compress.
+static const uint8_t sizes[HUFFMAN_SYMBOLS] = {
+     7,  4,  3,  3,  4,  5,  5,  5,  5,  6,  6,  7,  6,  8,  8,  5,
+     6, 10, 10, 10, 10,  8,  9, 10, 10, 10, 10, 10, 10, 10, 10, 11,
+    10, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+    11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+    10, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,
+    11, 11, 11, 11, 11, 11, 11, 12, 11, 11, 11, 11, 11, 11, 11, 11,
+    11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 12, 11, 11, 11,
+    11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 11,  9, 11, 11, 11,  6,
+     8,  9,  9,  7,  9,  9,  9,  5,  9,  9,  9,  9,  9,  9,  9,  9,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,
+     9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  9,  6,
+};
+
+// CODES OF EACH LENGTH ARE CONSECUTIVE, IN THE ORDER OF THEIR BYTES, AND START WHERE THE CODES
+// ONE BIT SHORTER LEFT OFF, SHIFTED UP A BIT.
+Huffman Huffman_Make(void)
+{
+    static Huffman zero;
+    Huffman huffman = zero;
+    for(int32_t i = 0; i < HUFFMAN_SYMBOLS; i++)
+    {
+        huffman.size[i] = sizes[i];
+        huffman.count[sizes[i]]++;
+    }
+    int32_t next[HUFFMAN_BITS + 1];
+    int32_t offset[HUFFMAN_BITS + 1];
+    int32_t code = 0;
+    next[0] = 0;
+    offset[0] = 0;
+    for(int32_t bits = 1; bits <= HUFFMAN_BITS; bits++)
+    {
+        code = (code + huffman.count[bits - 1]) << 1;
+        next[bits] = code;
+        offset[bits] = offset[bits - 1] + huffman.count[bits - 1];
+    }
+    for(int32_t i = 0; i < HUFFMAN_SYMBOLS; i++)
+    {
+        const int32_t bits = huffman.size[i];
+        huffman.code[i] = (uint16_t) next[bits]++;
+        huffman.symbol[offset[bits]++] = (uint8_t) i;
+    }
+    return huffman;
+}
+
+// MOST SIGNIFICANT BIT FIRST. THE LAST BYTE IS PADDED WITH ZEROS.
+void Huffman_Pack(const Huffman* const huffman, const Bytes* const in, Bytes* const out)
+{
+    uint32_t buffer = 0;
+    int32_t bits = 0;
+    for(int32_t i = 0; i < in->size; i++)
+    {
+        const uint8_t byte = in->byte[i];
+        buffer = (buffer << huffman->size[byte]) | huffman->code[byte];
+        bits += huffman->size[byte];
+        while(bits >= 8)
+        {
+            bits -= 8;
+            Bytes_PutU8(out, (uint8_t) (buffer >> bits));
+        }
+    }
+    if(bits > 0)
+        Bytes_PutU8(out, (uint8_t) (buffer << (8 - bits)));
+}
+
+// WALKS THE CODE A BIT AT A TIME: A CODE OF SOME LENGTH IS FOUND ONCE WHAT WAS READ SO FAR FALLS
+// AMONG THE CODES OF THAT LENGTH. READS ONLY THE BYTES THE SIZE BYTES TAKE.
+void Huffman_Unpack(const Huffman* const huffman, Bytes* const in, Bytes* const out, const int32_t size)
+{
+    Bytes_Clear(out);
+    uint8_t byte = 0;
+    int32_t left = 0;
+    for(int32_t i = 0; i < size && !in->is_bad; i++)
+    {
+        int32_t code = 0;
+        int32_t first = 0;
+        int32_t index = 0;
+        bool is_found = false;
+        for(int32_t bits = 1; bits <= HUFFMAN_BITS && !is_found; bits++)
+        {
+            if(left == 0)
+            {
+                byte = Bytes_GetU8(in);
+                left = 8;
+            }
+            left--;
+            code |= (byte >> left) & 1;
+            const int32_t count = huffman->count[bits];
+            if(code - first < count)
+            {
+                Bytes_PutU8(out, huffman->symbol[index + code - first]);
+                is_found = true;
+            }
+            index += count;
+            first = (first + count) << 1;
+            code <<= 1;
+        }
+        if(!is_found)
+            in->is_bad = true;
+    }
+    if(out->is_bad)
+        in->is_bad = true;
+}
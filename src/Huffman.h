@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Bytes.h"
+
+#include <stdint.h>
+
+// A STATIC CANONICAL HUFFMAN CODE OVER BYTES, SHARED BY SERVER AND CLIENTS. THE CODE LENGTHS ARE
+// BUILT IN, SO NOTHING ABOUT THE CODE GOES OVER THE WIRE AND EVERY MESSAGE DECODES ON ITS OWN.
+// THEY WERE TRAINED ON DELTA TURNS OF AN EIGHT PLAYER MATCH, SO SMALL VALUES AND THE VARINT
+// CONTINUATION BYTES OF SCREEN COORDINATES ARE CHEAP. EVERY BYTE HAS A CODE.
+
+#define HUFFMAN_SYMBOLS (256)
+
+#define HUFFMAN_BITS (12)
+
+typedef struct
+{
+    uint16_t code[HUFFMAN_SYMBOLS];
+    uint8_t size[HUFFMAN_SYMBOLS];
+    int32_t count[HUFFMAN_BITS + 1];
+    uint8_t symbol[HUFFMAN_SYMBOLS];
+}
+Huffman;
+
+Huffman Huffman_Make(void);
+
+void Huffman_Pack(const Huffman* const, const Bytes* const, Bytes* const);
+
+void Huffman_Unpack(const Huffman* const, Bytes* const, Bytes* const, const int32_t size);
@@ -0,0 +1,11 @@
+#include "Impair.h"
+
+bool Impair_IsActive(const Impair impair)
+{
+    return impair.delay_ms > 0
+        || impair.jitter_ms > 0
+        || impair.loss > 0
+        || impair.duplicate > 0
+        || impair.reorder > 0
+        || impair.rate_kbps > 0;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// HOW BADLY THE SHIM TREATS OUTGOING TRAFFIC. CHANCES ARE IN PARTS PER THOUSAND,
+// THE RATE IS IN KILOBITS PER SECOND, AND ZERO TURNS A KNOB OFF.
+
+typedef struct
+{
+    int32_t delay_ms;
+    int32_t jitter_ms;
+    int32_t loss;
+    int32_t duplicate;
+    int32_t reorder;
+    int32_t rate_kbps;
+    uint32_t seed;
+}
+Impair;
+
+bool Impair_IsActive(const Impair);
@@ -0,0 +1,30 @@
+#include "Join.h"
+
+#include "Color.h"
+
+void Join_Encode(const Join join, const Protocol protocol, Bytes* const bytes)
+{
+    Bytes_PutU8(bytes, PROTOCOL_VERSION);
+    Bytes_PutU8(bytes, (uint8_t) protocol);
+    Bytes_PutVarint(bytes, (uint64_t) join.match);
+    Bytes_PutVarint(bytes, (uint64_t) join.users);
+    Bytes_PutVarint(bytes, join.token);
+}
+
+Join Join_Decode(Bytes* const bytes, const Protocol protocol)
+{
+    static Join zero;
+    if(Bytes_GetU8(bytes) != PROTOCOL_VERSION
+    || Bytes_GetU8(bytes) != protocol)
+    {
+        bytes->is_bad = true;
+        return zero;
+    }
+    Join join = zero;
+    join.match = (int32_t) Bytes_GetVarint(bytes);
+    join.users = (int32_t) Bytes_GetVarint(bytes);
+    join.token = (uint32_t) Bytes_GetVarint(bytes);
+    if(join.match < 0 || join.users < 1 || join.users > COLOR_COUNT)
+        bytes->is_bad = true;
+    return join;
+}
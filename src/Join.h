@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Bytes.h"
+#include "Protocol.h"
+
+#include <stdint.h>
+
+// THE MATCH ASSIGNMENT HANDSHAKE. A CLIENT FIRST SENDS A JOIN NAMING THE MATCH IT WANTS (ZERO FOR
+// ANY OPEN LOBBY OF ITS SIZE) AND THE SERVER ANSWERS WITH AN ASSIGN NAMING THE MATCH IT WAS PLACED
+// IN. AN ASSIGN WITH MATCH ZERO IS A REJECTION. AN ASSIGN WITH A TOKEN MOVES THE UPLINKS ONTO UDP,
+// WHERE THE TOKEN NAMES THE CLIENT. THE TURNS FOLLOW ONCE THE SERVER SENDS A HANDOFF, THE LAST
+// MESSAGE OF THEIR STREAM ON THE WIRE.
+
+typedef struct
+{
+    int32_t match;
+    int32_t users;
+    uint32_t token;
+}
+Join;
+
+void Join_Encode(const Join, const Protocol, Bytes* const);
+
+Join Join_Decode(Bytes* const, const Protocol);
@@ -0,0 +1,65 @@
+#include "Keyframe.h"
+
+#include "Config.h"
+#include "Util.h"
+#include "Wire.h"
+
+Keyframe Keyframe_Start(Keyframe keyframe, const int32_t donor, const int32_t cycles, const int32_t offset, const int32_t turn)
+{
+    keyframe.size = 0;
+    keyframe.donor = donor;
+    keyframe.cycles = cycles;
+    keyframe.taken = 0;
+    keyframe.received = 0;
+    keyframe.offset = offset;
+    keyframe.turn = turn;
+    keyframe.waited = 0;
+    keyframe.is_active = true;
+    keyframe.is_done = false;
+    return keyframe;
+}
+
+// THE FRAMES' MEMORY IS KEPT FOR THE NEXT KEYFRAME.
+Keyframe Keyframe_Stop(Keyframe keyframe)
+{
+    keyframe.is_active = false;
+    return keyframe;
+}
+
+// A SNAPSHOT DONATED FOR A REJOIN AT A LATER CYCLE SERVES JUST AS WELL.
+Keyframe Keyframe_Take(Keyframe keyframe, const int32_t i, const Chunk chunk, const Bytes* const bytes)
+{
+    if(!keyframe.is_active
+    || i != keyframe.donor
+    || chunk.cycles < keyframe.cycles
+    || chunk.offset != keyframe.received
+    || (keyframe.received > 0 && chunk.cycles != keyframe.taken))
+        return keyframe;
+    if(keyframe.size + WIRE_PREFIX + bytes->size > keyframe.max)
+    {
+        keyframe.max = UTIL_MAX(2 * keyframe.max, keyframe.size + WIRE_PREFIX + bytes->size);
+        keyframe.frames = UTIL_REALLOC(keyframe.frames, uint8_t, keyframe.max);
+    }
+    keyframe.size += Wire_Frame(&keyframe.frames[keyframe.size], bytes);
+    keyframe.taken = chunk.cycles;
+    keyframe.received += chunk.count;
+    keyframe.waited = 0;
+    if(keyframe.received == chunk.size)
+    {
+        keyframe.is_done = true;
+        keyframe.is_active = false;
+    }
+    return keyframe;
+}
+
+Keyframe Keyframe_Wait(Keyframe keyframe)
+{
+    if(keyframe.is_active && ++keyframe.waited > CONFIG_SOCKETS_REJOIN_PATIENCE)
+        keyframe = Keyframe_Stop(keyframe);
+    return keyframe;
+}
+
+void Keyframe_Free(const Keyframe keyframe)
+{
+    free(keyframe.frames);
+}
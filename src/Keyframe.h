@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Bytes.h"
+#include "Chunk.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A SNAPSHOT KEPT FOR SPECTATORS JUST AS THE DONOR SENT IT, ITS CHUNKS FRAMED BACK TO BACK AS ON THE
+// WIRE, SO IT GOES OUT TO EVERY SPECTATOR AS IS. IT IS ASKED FOR LIKE A REJOIN, AT A CYCLE NO TURN
+// SENT SO FAR EXECUTES AT, AND THE OFFSET IS WHERE THE TURN STREAM STOOD WHEN IT WAS: THE SNAPSHOT
+// PLUS THE STREAM FROM THERE ON IS THE WHOLE MATCH. A DONOR THAT GOES QUIET IS GIVEN UP ON.
+
+typedef struct
+{
+    uint8_t* frames;
+    int32_t size;
+    int32_t max;
+    int32_t donor;
+    int32_t cycles;
+    int32_t taken;
+    int32_t received;
+    int32_t offset;
+    int32_t turn;
+    int32_t waited;
+    bool is_active;
+    bool is_done;
+}
+Keyframe;
+
+Keyframe Keyframe_Start(Keyframe, const int32_t donor, const int32_t cycles, const int32_t offset, const int32_t turn);
+
+Keyframe Keyframe_Stop(Keyframe);
+
+Keyframe Keyframe_Take(Keyframe, const int32_t i, const Chunk, const Bytes* const);
+
+Keyframe Keyframe_Wait(Keyframe);
+
+void Keyframe_Free(const Keyframe);
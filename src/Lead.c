@@ -0,0 +1,87 @@
+#include "Lead.h"
+
+#include "Util.h"
+
+static int32_t GetBudget(const int32_t cycles)
+{
+    return cycles * CONFIG_MAIN_LOOP_SPEED_MS;
+}
+
+static int32_t GetCycles(const int32_t rtt)
+{
+    const int32_t ms = rtt + CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS;
+    return (ms + CONFIG_MAIN_LOOP_SPEED_MS - 1) / CONFIG_MAIN_LOOP_SPEED_MS;
+}
+
+// STARTS AS IF EVERY CLIENT WERE NEXT DOOR.
+Lead* Lead_Make(void)
+{
+    Lead* const lead = UTIL_ALLOC(Lead, 1);
+    lead->cycles = GetCycles(0);
+    return lead;
+}
+
+void Lead_Free(Lead* const lead)
+{
+    free(lead);
+}
+
+void Lead_Sample(Lead* const lead, const int32_t client, const int32_t rtt)
+{
+    if(rtt < 0)
+        return;
+    lead->rtt[client][lead->count[client] % CONFIG_LEAD_WINDOW] = rtt;
+    lead->count[client] += 1;
+    lead->samples += 1;
+    if(rtt + CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS > GetBudget(lead->cycles))
+        lead->late += 1;
+}
+
+void Lead_Forget(Lead* const lead, const int32_t client)
+{
+    lead->count[client] = 0;
+}
+
+static int CompareInt(const void* const a, const void* const b)
+{
+    return *(const int32_t*) a - *(const int32_t*) b;
+}
+
+static int32_t GetPercentile(const Lead* const lead, const int32_t client)
+{
+    const int32_t count = UTIL_MIN(lead->count[client], CONFIG_LEAD_WINDOW);
+    int32_t sorted[CONFIG_LEAD_WINDOW];
+    for(int32_t i = 0; i < count; i++)
+        sorted[i] = lead->rtt[client][i];
+    UTIL_SORT(sorted, count, CompareInt);
+    return sorted[(count * CONFIG_LEAD_PERCENTILE - 1) / 100];
+}
+
+int32_t Lead_Update(Lead* const lead)
+{
+    int32_t worst = 0;
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(lead->count[i] > 0)
+            worst = UTIL_MAX(worst, GetPercentile(lead, i));
+    lead->percentile = worst;
+    const int32_t target = GetCycles(worst);
+    if(target >= lead->cycles)
+    {
+        lead->cycles = target;
+        lead->calm = 0;
+    }
+    else if(++lead->calm >= CONFIG_LEAD_SHRINK_TURNS)
+    {
+        lead->cycles -= 1;
+        lead->calm = 0;
+    }
+    return lead->cycles;
+}
+
+// IN PARTS PER THOUSAND OF ALL SAMPLES SO FAR.
+int32_t Lead_GetLateRate(const Lead* const lead)
+{
+    return lead->samples > 0
+        ? (int32_t) ((1000LL * lead->late) / lead->samples)
+        : 0;
+}
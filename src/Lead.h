@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Color.h"
+#include "Config.h"
+
+#include <stdint.h>
+
+// THE COMMAND DELAY: HOW MANY CYCLES AHEAD OF THE FURTHEST CLIENT A TURN IS SCHEDULED TO EXECUTE.
+// EACH CLIENT'S LAST FEW RTT SAMPLES ARE KEPT, ONE PER TURN, AND THE DELAY COVERS THE WORST CLIENT'S
+// PERCENTILE RTT PLUS ONE TURN INTERVAL. IT GROWS AT ONCE, BUT ONLY SHRINKS, A CYCLE AT A TIME, AFTER
+// THE PERCENTILE HAS STAYED A WHOLE CYCLE BELOW IT FOR SEVERAL TURNS IN A ROW, SO ONE SPIKE IS
+// FORGOTTEN ONCE IT LEAVES THE WINDOW AND THE DELAY DOES NOT FLAP.
+//
+// A SAMPLE IS COUNTED LATE WHEN THE DELAY IN PLACE WHEN IT ARRIVED DID NOT COVER IT, WHICH IS HOW OFTEN
+// A TURN WOULD HAVE REACHED THAT CLIENT AFTER ITS EXECUTION CYCLE.
+
+typedef struct
+{
+    int32_t rtt[COLOR_COUNT][CONFIG_LEAD_WINDOW];
+    int32_t count[COLOR_COUNT];
+    int32_t cycles;
+    int32_t percentile;
+    int32_t calm;
+    int32_t samples;
+    int32_t late;
+}
+Lead;
+
+Lead* Lead_Make(void);
+
+void Lead_Free(Lead* const);
+
+void Lead_Sample(Lead* const, const int32_t client, const int32_t rtt);
+
+void Lead_Forget(Lead* const, const int32_t client);
+
+int32_t Lead_Update(Lead* const);
+
+int32_t Lead_GetLateRate(const Lead* const);
@@ -0,0 +1,393 @@
+#include "Link.h"
+
+#include "Protocol.h"
+#include "Shim.h"
+#include "Util.h"
+
+#include <SDL2/SDL_timer.h>
+#include <string.h>
+
+#define SLOT(seq) ((seq) % LINK_WINDOW)
+
+// VERSION, KIND, TOKEN, ACK, ACK BITS, AND MESSAGE COUNT AT THEIR WIDEST.
+#define HEADER_MAX (1 + 1 + 5 + 5 + 10 + 2)
+
+// SEQUENCE AND SIZE AT THEIR WIDEST.
+#define MESSAGE_OVERHEAD (5 + 2)
+
+#define PIECE_MAX (BYTES_MAX - HEADER_MAX - MESSAGE_OVERHEAD)
+
+Link* Link_Make(UDPsocket socket, const uint32_t token, const uint32_t host)
+{
+    Link* const link = UTIL_ALLOC(Link, 1);
+    link->socket = socket;
+    link->packet = SDLNet_AllocPacket(BYTES_MAX);
+    link->host = host;
+    link->token = token;
+    link->out = UTIL_ALLOC(Bytes, LINK_WINDOW);
+    link->out_time = UTIL_ALLOC(uint32_t, LINK_WINDOW);
+    link->out_first = UTIL_ALLOC(uint32_t, LINK_WINDOW);
+    link->out_sends = UTIL_ALLOC(int32_t, LINK_WINDOW);
+    link->out_acked = UTIL_ALLOC(bool, LINK_WINDOW);
+    link->out_resent = UTIL_ALLOC(bool, LINK_WINDOW);
+    link->out_more = UTIL_ALLOC(bool, LINK_WINDOW);
+    link->in = UTIL_ALLOC(Bytes, LINK_WINDOW);
+    link->in_has = UTIL_ALLOC(bool, LINK_WINDOW);
+    link->in_more = UTIL_ALLOC(bool, LINK_WINDOW);
+    link->srtt = 100;
+    link->rttvar = 50;
+    return link;
+}
+
+void Link_Free(Link* const link)
+{
+    SDLNet_FreePacket(link->packet);
+    free(link->out);
+    free(link->out_time);
+    free(link->out_first);
+    free(link->out_sends);
+    free(link->out_acked);
+    free(link->out_resent);
+    free(link->out_more);
+    free(link->held);
+    free(link->held_more);
+    free(link->in);
+    free(link->in_has);
+    free(link->in_more);
+    free(link);
+}
+
+void Link_Connect(Link* const link, const IPaddress peer)
+{
+    link->peer = peer;
+    link->has_peer = true;
+}
+
+void Link_Open(Link* const link)
+{
+    link->is_open = true;
+}
+
+int32_t Link_GetRto(const Link* const link)
+{
+    const int32_t rto = link->srtt + 4 * link->rttvar;
+    return UTIL_MIN(UTIL_MAX(rto, LINK_RTO_MIN_MS), LINK_RTO_MAX_MS);
+}
+
+// THE HELD PIECES ARE MOVED BACK TO THE FRONT BEFORE THE BACKLOG EVER GROWS.
+static void Hold(Link* const link, const Bytes* const piece, const bool more)
+{
+    if(link->held_b == link->held_max)
+    {
+        const int32_t size = link->held_b - link->held_a;
+        if(link->held_a > 0)
+        {
+            memmove(link->held, &link->held[link->held_a], sizeof(*link->held) * (size_t) size);
+            memmove(link->held_more, &link->held_more[link->held_a], sizeof(*link->held_more) * (size_t) size);
+        }
+        else
+        {
+            link->held_max = UTIL_MIN(UTIL_MAX(16, 2 * link->held_max), LINK_BACKLOG_MAX);
+            link->held = UTIL_REALLOC(link->held, Bytes, link->held_max);
+            link->held_more = UTIL_REALLOC(link->held_more, bool, link->held_max);
+        }
+        link->held_a = 0;
+        link->held_b = size;
+    }
+    link->held[link->held_b] = *piece;
+    link->held_more[link->held_b] = more;
+    link->held_b++;
+}
+
+static void Admit(Link* const link)
+{
+    while(link->held_a != link->held_b && link->out_next - link->out_base < LINK_WINDOW)
+    {
+        const uint32_t i = SLOT(link->out_next);
+        link->out[i] = link->held[link->held_a];
+        link->out_more[i] = link->held_more[link->held_a];
+        link->out_sends[i] = 0;
+        link->out_acked[i] = false;
+        link->out_resent[i] = false;
+        link->out_next++;
+        link->held_a++;
+    }
+    if(link->held_a == link->held_b)
+        link->held_a = link->held_b = 0;
+}
+
+// FALSE ONLY WHEN THE BACKLOG IS FULL, AS THE PEER HAS STOPPED ACKING. THE MESSAGE IS THEN LOST, AND
+// SO IS THE STREAM.
+bool Link_Push(Link* const link, const Bytes* const bytes)
+{
+    const int32_t pieces = UTIL_MAX(1, (bytes->size + PIECE_MAX - 1) / PIECE_MAX);
+    if(link->held_b - link->held_a + pieces > LINK_BACKLOG_MAX)
+        return false;
+    for(int32_t i = 0; i < pieces; i++)
+    {
+        const int32_t start = i * PIECE_MAX;
+        const int32_t end = UTIL_MIN(start + PIECE_MAX, bytes->size);
+        Bytes piece;
+        Bytes_Clear(&piece);
+        for(int32_t j = start; j < end; j++)
+            Bytes_PutU8(&piece, bytes->byte[j]);
+        Hold(link, &piece, i < pieces - 1);
+    }
+    Admit(link);
+    return true;
+}
+
+static bool IsRecent(const Link* const link, const uint32_t seq)
+{
+    return link->out_next - 1 - seq < LINK_REDUNDANCY;
+}
+
+static bool IsLate(const Link* const link, const uint32_t i, const uint32_t now)
+{
+    return link->out_sends[i] == 0
+        || (int32_t) (now - link->out_time[i]) >= Link_GetRto(link);
+}
+
+bool Link_IsDue(const Link* const link)
+{
+    if(!link->has_peer)
+        return false;
+    const uint32_t now = SDL_GetTicks();
+    if(link->owes_ack && (int32_t) (now - link->last_send) >= LINK_ACK_DELAY_MS)
+        return true;
+    for(uint32_t seq = link->out_base; seq != link->out_next; seq++)
+    {
+        const uint32_t i = SLOT(seq);
+        if(!link->out_acked[i] && IsLate(link, i, now))
+            return true;
+    }
+    return false;
+}
+
+static void PutHeader(const Link* const link, Bytes* const bytes)
+{
+    uint64_t bits = 0;
+    for(uint32_t i = 0; i < LINK_WINDOW - 1; i++)
+        if(link->in_has[SLOT(link->in_next + 1 + i)])
+            bits |= (uint64_t) 1 << i;
+    Bytes_PutU8(bytes, PROTOCOL_VERSION);
+    Bytes_PutU8(bytes, PROTOCOL_DATAGRAM);
+    Bytes_PutVarint(bytes, link->token);
+    Bytes_PutVarint(bytes, link->in_next);
+    Bytes_PutVarint(bytes, bits);
+}
+
+static void Send(Link* const link, const Bytes* const bytes)
+{
+    for(int32_t i = 0; i < bytes->size; i++)
+        link->packet->data[i] = bytes->byte[i];
+    link->packet->len = bytes->size;
+    link->packet->address = link->peer;
+    Shim_SendUdp(link->socket, link->packet);
+}
+
+// NEWEST FIRST: THE LAST FEW UNACKED MESSAGES RIDE ALONG THE FIRST DATAGRAM, OLDER ONES ONLY WHEN
+// THEIR TIMEOUT HAS EXPIRED. FALSE WHEN THERE IS NEITHER A MESSAGE NOR AN ACK TO DELIVER.
+static bool Pack(Link* const link, const uint32_t now, const bool is_first)
+{
+    uint32_t chosen[LINK_WINDOW];
+    int32_t count = 0;
+    int32_t room = BYTES_MAX - HEADER_MAX;
+    for(uint32_t seq = link->out_next; seq != link->out_base;)
+    {
+        seq--;
+        const uint32_t i = SLOT(seq);
+        const int32_t cost = MESSAGE_OVERHEAD + link->out[i].size;
+        const bool is_due = is_first
+            ? IsRecent(link, seq) || IsLate(link, i, now)
+            : link->out_sends[i] == 0;
+        if(!link->out_acked[i] && is_due && cost <= room)
+        {
+            chosen[count++] = seq;
+            room -= cost;
+        }
+    }
+    if(count == 0 && !link->owes_ack)
+        return false;
+    Bytes datagram;
+    Bytes_Clear(&datagram);
+    PutHeader(link, &datagram);
+    Bytes_PutVarint(&datagram, (uint64_t) count);
+    for(int32_t j = 0; j < count; j++)
+    {
+        const uint32_t i = SLOT(chosen[j]);
+        Bytes_PutVarint(&datagram, chosen[j]);
+        Bytes_PutVarint(&datagram, ((uint64_t) link->out[i].size << 1) | link->out_more[i]);
+        Bytes_PutBytes(&datagram, &link->out[i]);
+        if(link->out_sends[i] == 0)
+            link->out_first[i] = now;
+        else if(!IsRecent(link, chosen[j]))
+        {
+            link->out_resent[i] = true;
+            link->resends++;
+        }
+        link->out_sends[i]++;
+        link->out_time[i] = now;
+    }
+    Send(link, &datagram);
+    link->last_send = now;
+    link->owes_ack = false;
+    return true;
+}
+
+// MORE DATAGRAMS FOLLOW THE FIRST UNTIL EVERY MESSAGE IN THE WINDOW HAS GONE OUT AT LEAST ONCE, SO
+// A MESSAGE SPLIT INTO PIECES, OR A WINDOW OPENED BY AN ACK, LEAVES IN ONE FLUSH.
+void Link_Flush(Link* const link)
+{
+    if(!link->has_peer)
+        return;
+    const uint32_t now = SDL_GetTicks();
+    bool is_first = true;
+    while(Pack(link, now, is_first))
+        is_first = false;
+}
+
+// AN ACK ALONE, SO THE PEER BINDS THE LINK BEFORE THERE IS ANYTHING TO SEND IT.
+void Link_Greet(Link* const link)
+{
+    link->owes_ack = true;
+    Link_Flush(link);
+}
+
+bool Link_Recv(UDPsocket socket, UDPpacket* const packet, Bytes* const bytes)
+{
+    Bytes_Clear(bytes);
+    if(SDLNet_UDP_Recv(socket, packet) <= 0)
+        return false;
+    const int32_t size = UTIL_MIN(packet->len, BYTES_MAX);
+    for(int32_t i = 0; i < size; i++)
+        bytes->byte[i] = packet->data[i];
+    bytes->size = size;
+    return true;
+}
+
+// ZERO WHEN THE DATAGRAM IS NOT ONE OF OURS. THE DATAGRAM IS REWOUND FOR TAKING.
+uint32_t Link_GetToken(Bytes* const bytes)
+{
+    Bytes_Rewind(bytes);
+    const bool is_ours = Bytes_GetU8(bytes) == PROTOCOL_VERSION
+                      && Bytes_GetU8(bytes) == PROTOCOL_DATAGRAM;
+    const uint32_t token = (uint32_t) Bytes_GetVarint(bytes);
+    const bool is_bad = bytes->is_bad;
+    Bytes_Rewind(bytes);
+    return (is_ours && !is_bad) ? token : 0;
+}
+
+static void Sample(Link* const link, const int32_t rtt)
+{
+    const int32_t error = rtt - link->srtt;
+    link->rttvar += ((error < 0 ? -error : error) - link->rttvar) / 4;
+    link->srtt += error / 8;
+}
+
+// KARN'S RULE: THE ACK OF A MESSAGE RESENT ON A TIMEOUT MAY BE FOR ANY COPY, SO IT IS NO SAMPLE.
+// REDUNDANT COPIES LEAVE WITHIN A FEW FLUSHES OF THE FIRST AND STILL SAMPLE FROM IT.
+static void Acknowledge(Link* const link, const uint32_t seq, const uint32_t now)
+{
+    if(seq - link->out_base >= link->out_next - link->out_base)
+        return;
+    const uint32_t i = SLOT(seq);
+    if(!link->out_acked[i])
+    {
+        link->out_acked[i] = true;
+        if(!link->out_resent[i])
+            Sample(link, (int32_t) (now - link->out_first[i]));
+    }
+}
+
+static void Ack(Link* const link, const uint32_t ack, const uint64_t bits)
+{
+    const uint32_t now = SDL_GetTicks();
+    for(uint32_t seq = link->out_base; seq != link->out_next && (int32_t) (ack - seq) > 0; seq++)
+        Acknowledge(link, seq, now);
+    for(uint32_t i = 0; i < LINK_WINDOW - 1; i++)
+        if(bits & ((uint64_t) 1 << i))
+            Acknowledge(link, ack + 1 + i, now);
+    while(link->out_base != link->out_next && link->out_acked[SLOT(link->out_base)])
+        link->out_base++;
+    Admit(link);
+}
+
+static bool IsPeer(const Link* const link, const IPaddress from)
+{
+    return from.host == link->peer.host && from.port == link->peer.port;
+}
+
+// DUPLICATES AND MESSAGES BEYOND THE WINDOW ARE DROPPED, BUT STILL EARN AN ACK. A DATAGRAM FROM
+// ANYWHERE BUT THE PEER, OR BEFORE THERE IS ONE, FROM ANYWHERE BUT THE EXPECTED HOST, IS IGNORED.
+void Link_Take(Link* const link, Bytes* const bytes, const IPaddress from)
+{
+    Bytes_Rewind(bytes);
+    if(Bytes_GetU8(bytes) != PROTOCOL_VERSION
+    || Bytes_GetU8(bytes) != PROTOCOL_DATAGRAM
+    || Bytes_GetVarint(bytes) != link->token)
+        return;
+    const uint32_t ack = (uint32_t) Bytes_GetVarint(bytes);
+    const uint64_t bits = Bytes_GetVarint(bytes);
+    const int32_t count = (int32_t) Bytes_GetVarint(bytes);
+    if(bytes->is_bad)
+        return;
+    if(!link->has_peer && from.host == link->host)
+        Link_Connect(link, from);
+    if(!link->has_peer || !IsPeer(link, from))
+        return;
+    Ack(link, ack, bits);
+    for(int32_t j = 0; j < count; j++)
+    {
+        const uint32_t seq = (uint32_t) Bytes_GetVarint(bytes);
+        const uint64_t field = Bytes_GetVarint(bytes);
+        const int32_t size = (int32_t) (field >> 1);
+        Bytes message;
+        Bytes_GetBytes(bytes, &message, size);
+        if(bytes->is_bad)
+            return;
+        const uint32_t i = SLOT(seq);
+        if(seq - link->in_next < LINK_WINDOW && !link->in_has[i])
+        {
+            link->in[i] = message;
+            link->in_has[i] = true;
+            link->in_more[i] = field & 1;
+        }
+        link->owes_ack = true;
+    }
+}
+
+void Link_Fill(Link* const link)
+{
+    Bytes bytes;
+    while(Link_Recv(link->socket, link->packet, &bytes))
+        Link_Take(link, &bytes, link->packet->address);
+}
+
+// ONLY ONCE EVERY PIECE OF THE NEXT MESSAGE IS IN. PIECES ADDING UP TO MORE THAN A MESSAGE CAN
+// HOLD ARE POPPED AS AN EMPTY ONE, WHICH DECODES AS NOTHING.
+bool Link_Pop(Link* const link, Bytes* const bytes)
+{
+    if(!link->is_open)
+        return false;
+    int32_t pieces = 0;
+    int32_t size = 0;
+    for(bool more = true; more; pieces++)
+    {
+        const uint32_t i = SLOT(link->in_next + (uint32_t) pieces);
+        if(pieces == LINK_WINDOW || !link->in_has[i])
+            return false;
+        size += link->in[i].size;
+        more = link->in_more[i];
+    }
+    Bytes_Clear(bytes);
+    for(int32_t j = 0; j < pieces; j++)
+    {
+        const uint32_t i = SLOT(link->in_next);
+        if(size <= BYTES_MAX)
+            Bytes_PutBytes(bytes, &link->in[i]);
+        link->in_has[i] = false;
+        link->in_next++;
+    }
+    return true;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Bytes.h"
+
+#include <SDL2/SDL_net.h>
+
+// A RELIABLE, ORDERED MESSAGE CHANNEL OVER UDP. EVERY MESSAGE GETS A SEQUENCE NUMBER AND EVERY
+// DATAGRAM ACKS THE PEER WITH THE NEXT SEQUENCE IT EXPECTS AND A BITFIELD OF WHAT ARRIVED AFTER IT.
+// EACH DATAGRAM CARRIES THE LAST FEW UNACKED MESSAGES AGAIN, SO A LOST DATAGRAM IS USUALLY REPAIRED
+// BY THE NEXT ONE, AND OLDER UNACKED MESSAGES ARE RESENT ONE BY ONE ONCE THEIR TIMEOUT EXPIRES.
+// A LOST DATAGRAM NEVER HOLDS BACK MESSAGES ALREADY DELIVERED TO THE PEER'S WINDOW.
+//
+// NOTHING IS POPPED UNTIL THE LINK IS OPENED, SO A STREAM THAT STARTED ON ANOTHER TRANSPORT IS READ
+// THERE UP TO THE POINT IT MOVED, HOWEVER LATE THAT ARRIVES.
+//
+// A LINK NEVER TURNS A MESSAGE AWAY, SO NOTHING OF ITS STREAM EVER TAKES ANOTHER WAY AND OVERTAKES
+// IT. MESSAGES TOO BIG FOR A DATAGRAM GO AS PIECES ON CONSECUTIVE SEQUENCES AND ARE POPPED WHOLE.
+// PIECES BEYOND A FULL WINDOW ARE HELD UNTIL ACKS MAKE ROOM, AND ONLY A PEER THAT STOPPED ACKING
+// FOR A WHOLE BACKLOG FAILS A PUSH.
+//
+// THE TOKEN NAMES THE LINK TO A SERVER SHARING ONE UDP SOCKET AMONG ALL CLIENTS. THE PEER IS BOUND
+// BY THE FIRST DATAGRAM CARRYING THE TOKEN FROM THE EXPECTED HOST, AND DATAGRAMS FROM ANYWHERE ELSE
+// ARE IGNORED FROM THEN ON. RESENDS COUNTS
+// ONLY TIMEOUT RESENDS, NOT THE REDUNDANT COPIES, AND A MESSAGE RESENT ON A TIMEOUT IS NO RTT SAMPLE.
+
+#define LINK_WINDOW (64)
+
+#define LINK_REDUNDANCY (4)
+
+#define LINK_ACK_DELAY_MS (20)
+
+#define LINK_RTO_MIN_MS (30)
+
+#define LINK_RTO_MAX_MS (1000)
+
+#define LINK_BACKLOG_MAX (4096)
+
+typedef struct
+{
+    UDPsocket socket;
+    UDPpacket* packet;
+    IPaddress peer;
+    uint32_t host;
+    uint32_t token;
+    bool has_peer;
+    bool is_open;
+    bool owes_ack;
+    uint32_t last_send;
+    Bytes* out;
+    uint32_t* out_time;
+    uint32_t* out_first;
+    int32_t* out_sends;
+    bool* out_acked;
+    bool* out_resent;
+    bool* out_more;
+    uint32_t out_base;
+    uint32_t out_next;
+    Bytes* held;
+    bool* held_more;
+    int32_t held_a;
+    int32_t held_b;
+    int32_t held_max;
+    Bytes* in;
+    bool* in_has;
+    bool* in_more;
+    uint32_t in_next;
+    int32_t srtt;
+    int32_t rttvar;
+    int32_t resends;
+}
+Link;
+
+Link* Link_Make(UDPsocket, const uint32_t token, const uint32_t host);
+
+void Link_Free(Link* const);
+
+void Link_Connect(Link* const, const IPaddress);
+
+void Link_Open(Link* const);
+
+bool Link_Push(Link* const, const Bytes* const);
+
+bool Link_IsDue(const Link* const);
+
+void Link_Flush(Link* const);
+
+void Link_Greet(Link* const);
+
+bool Link_Recv(UDPsocket, UDPpacket* const, Bytes* const);
+
+uint32_t Link_GetToken(Bytes* const);
+
+void Link_Take(Link* const, Bytes* const, const IPaddress);
+
+void Link_Fill(Link* const);
+
+bool Link_Pop(Link* const, Bytes* const);
+
+int32_t Link_GetRto(const Link* const);
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// ONE ROW OF THE MATCH REGISTRY. SEATS COUNTS EVERY CLIENT ASSIGNED TO THE MATCH, INCLUDING
+// THOSE STILL BEING HANDED TO ITS SHARD. AN ID OF ZERO IS A FREE ROW.
+
+typedef struct
+{
+    int32_t id;
+    int32_t users;
+    int32_t seats;
+    int32_t shard;
+    bool is_running;
+}
+Match;
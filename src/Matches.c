@@ -0,0 +1,127 @@
+#include "Matches.h"
+
+#include "Util.h"
+
+Matches* Matches_Make(const int32_t shards, const int32_t per_shard)
+{
+    Matches* const matches = UTIL_ALLOC(Matches, 1);
+    matches->shards = shards;
+    matches->per_shard = per_shard;
+    matches->max = shards * per_shard;
+    matches->match = UTIL_ALLOC(Match, matches->max);
+    matches->load = UTIL_ALLOC(int32_t, shards);
+    matches->next = 1;
+    matches->mutex = SDL_CreateMutex();
+    return matches;
+}
+
+void Matches_Free(Matches* const matches)
+{
+    SDL_DestroyMutex(matches->mutex);
+    free(matches->match);
+    free(matches->load);
+    free(matches);
+}
+
+static Match* Find(Matches* const matches, const int32_t id)
+{
+    for(int32_t i = 0; i < matches->max; i++)
+        if(matches->match[i].id == id)
+            return &matches->match[i];
+    return NULL;
+}
+
+static bool HasSeat(const Match* const match)
+{
+    return match->seats < match->users;
+}
+
+// QUICK JOINS FILL THE OLDEST OPEN LOBBY OF THE SAME SIZE BEFORE A NEW MATCH IS MADE.
+static Match* FindLobby(Matches* const matches, const int32_t users)
+{
+    for(int32_t i = 0; i < matches->max; i++)
+    {
+        Match* const match = &matches->match[i];
+        if(match->id != 0 && !match->is_running && match->users == users && HasSeat(match))
+            return match;
+    }
+    return NULL;
+}
+
+static int32_t NextId(Matches* const matches)
+{
+    while(matches->next == 0 || Find(matches, matches->next))
+        matches->next = (matches->next + 1) & 0x7FFFFFFF;
+    return matches->next++;
+}
+
+// NEW MATCHES GO TO THE LEAST LOADED SHARD.
+static Match* Create(Matches* const matches, const int32_t id, const int32_t users)
+{
+    int32_t shard = 0;
+    for(int32_t i = 1; i < matches->shards; i++)
+        if(matches->load[i] < matches->load[shard])
+            shard = i;
+    if(matches->load[shard] == matches->per_shard)
+        return NULL;
+    Match* const match = Find(matches, 0);
+    static Match zero;
+    *match = zero;
+    match->id = (id == 0) ? NextId(matches) : id;
+    match->users = users;
+    match->shard = shard;
+    matches->load[shard]++;
+    return match;
+}
+
+// A RETURNED ID OF ZERO MEANS THE CLIENT WAS TURNED AWAY: THE NAMED MATCH IS FULL OR EVERY SHARD IS.
+Match Matches_Assign(Matches* const matches, const Join join)
+{
+    static Match zero;
+    Match out = zero;
+    SDL_LockMutex(matches->mutex);
+    Match* match = (join.match == 0)
+        ? FindLobby(matches, join.users)
+        : Find(matches, join.match);
+    if(match == NULL)
+        match = Create(matches, join.match, join.users);
+    if(match && HasSeat(match))
+    {
+        match->seats++;
+        out = *match;
+    }
+    SDL_UnlockMutex(matches->mutex);
+    return out;
+}
+
+void Matches_Leave(Matches* const matches, const int32_t id)
+{
+    SDL_LockMutex(matches->mutex);
+    Match* const match = Find(matches, id);
+    if(match && --match->seats == 0)
+    {
+        static Match zero;
+        matches->load[match->shard]--;
+        *match = zero;
+    }
+    SDL_UnlockMutex(matches->mutex);
+}
+
+void Matches_Start(Matches* const matches, const int32_t id)
+{
+    SDL_LockMutex(matches->mutex);
+    Match* const match = Find(matches, id);
+    if(match)
+        match->is_running = true;
+    SDL_UnlockMutex(matches->mutex);
+}
+
+int32_t Matches_Count(Matches* const matches)
+{
+    int32_t count = 0;
+    SDL_LockMutex(matches->mutex);
+    for(int32_t i = 0; i < matches->shards; i++)
+        count += matches->load[i];
+    SDL_UnlockMutex(matches->mutex);
+    return count;
+}
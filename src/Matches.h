@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Match.h"
+#include "Join.h"
+
+#include <SDL2/SDL_mutex.h>
+
+// THE REGISTRY OF EVERY MATCH A HOST RUNS. THE ACCEPTING THREAD ASSIGNS CLIENTS TO MATCHES AND THE
+// SHARDS REPORT CLIENTS LEAVING AND GAMES STARTING. EACH CALL TAKES THE LOCK BRIEFLY, AND NONE ARE
+// MADE ON THE PATH OF A TURN OR AN UPLINK.
+
+typedef struct
+{
+    Match* match;
+    int32_t* load;
+    int32_t shards;
+    int32_t per_shard;
+    int32_t max;
+    int32_t next;
+    SDL_mutex* mutex;
+}
+Matches;
+
+Matches* Matches_Make(const int32_t shards, const int32_t per_shard);
+
+void Matches_Free(Matches* const);
+
+Match Matches_Assign(Matches* const, const Join);
+
+void Matches_Leave(Matches* const, const int32_t id);
+
+void Matches_Start(Matches* const, const int32_t id);
+
+int32_t Matches_Count(Matches* const);
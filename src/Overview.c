@@ -2,6 +2,8 @@
 
 #include "Config.h"
 #include "Util.h"
+#include "Command.h"
+#include "Protocol.h"
 
 #include <SDL2/SDL.h>
 #include <stdbool.h>
@@ -72,13 +74,14 @@ static Overview UpdatePan(Overview overview)
     return overview;
 }
 
-Overview Overview_Update(Overview overview, const Input input, const uint64_t parity, const int32_t cycles, const int32_t queue_size, const Share share, const int32_t ping)
+Overview Overview_Update(Overview overview, const Input input, const Parity parity, const int32_t cycles, const int32_t queue_size, const Share share, const int32_t ping)
 {
     overview = UpdateMouse(overview, input);
     overview = UpdateKeys(overview, input);
     overview = UpdatePan(overview);
     overview = UpdateSelectionBox(overview);
-    overview.parity = parity;
+    overview.parity = parity.root;
+    overview.parity_cycles = parity.cycles;
     overview.cycles = cycles;
     overview.queue_size = queue_size;
     overview.share = share;
@@ -173,3 +176,55 @@ bool Overview_UsedAction(const Overview overview)
 {
     return overview.event.mouse_lu || overview.event.mouse_ru;
 }
+
+// THE HEARTBEAT CARRIES THE CLIENT STATE THE SERVER PACES AND CHECKS PARITY WITH.
+void Overview_Encode(const Overview overview, Bytes* const bytes)
+{
+    Bytes_PutU8(bytes, PROTOCOL_VERSION);
+    Bytes_PutU8(bytes, PROTOCOL_UPLINK);
+    Bytes_PutVarint(bytes, (uint64_t) overview.cycles);
+    Bytes_PutVarint(bytes, overview.parity);
+    Bytes_PutZigzag(bytes, overview.parity_cycles);
+    Bytes_PutVarint(bytes, (uint64_t) overview.queue_size);
+    Bytes_PutZigzag(bytes, overview.ping);
+    Bytes_PutVarint(bytes, overview.stamp);
+}
+
+Overview Overview_Decode(Bytes* const bytes)
+{
+    static Overview zero;
+    Overview overview = zero;
+    if(Bytes_GetU8(bytes) != PROTOCOL_VERSION
+    || Bytes_GetU8(bytes) != PROTOCOL_UPLINK)
+    {
+        bytes->is_bad = true;
+        return zero;
+    }
+    overview.cycles = (int32_t) Bytes_GetVarint(bytes);
+    overview.parity = Bytes_GetVarint(bytes);
+    overview.parity_cycles = (int32_t) Bytes_GetZigzag(bytes);
+    overview.queue_size = (int32_t) Bytes_GetVarint(bytes);
+    overview.ping = (int32_t) Bytes_GetZigzag(bytes);
+    overview.stamp = (uint32_t) Bytes_GetVarint(bytes);
+    return overview;
+}
+
+// SENT ONLY WHEN THE PLAYER ACTED.
+void Overview_EncodeCommand(const Overview overview, Bytes* const bytes)
+{
+    Bytes_PutU8(bytes, PROTOCOL_VERSION);
+    Bytes_PutU8(bytes, PROTOCOL_COMMAND);
+    Command_Encode(Command_FromOverview(overview), bytes);
+}
+
+Overview Overview_DecodeCommand(Bytes* const bytes)
+{
+    static Overview zero;
+    if(Bytes_GetU8(bytes) != PROTOCOL_VERSION
+    || Bytes_GetU8(bytes) != PROTOCOL_COMMAND)
+    {
+        bytes->is_bad = true;
+        return zero;
+    }
+    return Command_ToOverview(Command_Decode(bytes));
+}
@@ -10,6 +10,8 @@
 #include "Quad.h"
 #include "Status.h"
 #include "Share.h"
+#include "Bytes.h"
+#include "Parity.h"
 
 #include <SDL2/SDL_net.h>
 
@@ -22,16 +24,19 @@ typedef struct
     Point mouse_cursor;
     Event event;
     uint64_t parity;
+    int32_t parity_cycles;
     int32_t cycles;
     int32_t queue_size;
     int32_t ping;
+    uint32_t stamp;
+    int32_t sequence;
     Share share;
 }
 Overview;
 
 Overview Overview_Init(const int32_t xres, const int32_t yres);
 
-Overview Overview_Update(Overview, const Input, const uint64_t parity, const int32_t cycles, const int32_t queue_size, const Share, const int32_t ping);
+Overview Overview_Update(Overview, const Input, const Parity, const int32_t cycles, const int32_t queue_size, const Share, const int32_t ping);
 
 Point Overview_IsoToCart(const Overview, const Grid, const Point, const bool raw);
 
@@ -44,3 +49,11 @@ Point Overview_IsoSnapTo(const Overview, const Grid, const Point);
 bool Overview_IsSelectionBoxBigEnough(const Overview);
 
 bool Overview_UsedAction(const Overview);
+
+void Overview_Encode(const Overview, Bytes* const);
+
+Overview Overview_Decode(Bytes* const);
+
+void Overview_EncodeCommand(const Overview, Bytes* const);
+
+Overview Overview_DecodeCommand(Bytes* const);
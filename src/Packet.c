@@ -1,19 +1,85 @@
 #include "Packet.h"
 
+#include "Command.h"
+#include "Chunk.h"
+#include "Protocol.h"
 #include "Util.h"
 
+#include <SDL2/SDL_timer.h>
+
+#define PACKET_STABLE (1 << 0)
+#define PACKET_RUNNING (1 << 1)
+#define PACKET_ROLLBACK (1 << 2)
+
+// THE WIRE COMES FIRST, AS THE LINK STAYS CLOSED UNTIL THE HANDOFF, THE LAST TURN MESSAGE THE WIRE
+// CARRIES.
+static bool Next(const Sock sock, Bytes* const bytes, int32_t* const channel)
+{
+    *channel = CODEC_WIRE;
+    if(Wire_Pop(sock.wire, bytes))
+        return true;
+    if(SDLNet_CheckSockets(sock.set, 0) && SDLNet_SocketReady(sock.server))
+    {
+        Wire_Fill(sock.wire);
+        if(Wire_Pop(sock.wire, bytes))
+            return true;
+    }
+    if(sock.link)
+    {
+        Link_Fill(sock.link);
+        if(Link_IsDue(sock.link))
+            Link_Flush(sock.link);
+        *channel = CODEC_LINK;
+        return Link_Pop(sock.link, bytes);
+    }
+    return false;
+}
+
+// RETURNS ONE BUFFERED PACKET PER CALL. A ZERO TURN MEANS NOTHING IS LEFT TO DRAIN. TURNS COME
+// WHOLE OR AS DELTAS, WHICHEVER THE SERVER SENDS. A HANDOFF OPENS THE LINK TO THE TURNS AFTER IT.
+// EVERY PACKET ECHOING AN UPLINK STAMP IS AN RTT SAMPLE. SNAPSHOT CHUNKS ARE TAKEN INTO THE
+// TRANSFER, AND THE LAST ONE ENDS THE DRAIN, SO THE TURNS BEHIND IT WAIT FOR THE RESTORED UNITS.
 Packet Packet_Get(const Sock sock)
 {
     static Packet zero;
-    if(SDLNet_CheckSockets(sock.set, 0))
+    Bytes bytes;
+    int32_t channel;
+    while(Next(sock, &bytes, &channel))
     {
-        if(SDLNet_SocketReady(sock.server))
+        Packet packet = zero;
+        switch(Protocol_GetKind(&bytes))
+        {
+        case PROTOCOL_TURN:
+            packet = Packet_Decode(&bytes);
+            break;
+        case PROTOCOL_DELTA:
+        case PROTOCOL_SQUEEZE:
+            packet = Packet_DecodeDelta(&bytes, &sock.codec[channel], sock.huffman);
+            break;
+        case PROTOCOL_CHUNK:
+        {
+            const Chunk chunk = Chunk_Decode(&bytes);
+            if(Bytes_IsDone(&bytes))
+            {
+                *sock.transfer = Transfer_Take(*sock.transfer, chunk);
+                if(Transfer_IsDone(*sock.transfer))
+                    return zero;
+            }
+            continue;
+        }
+        case PROTOCOL_HANDOFF:
+            Join_Decode(&bytes, PROTOCOL_HANDOFF);
+            if(Bytes_IsDone(&bytes) && sock.link)
+                Link_Open(sock.link);
+            continue;
+        default:
+            continue;
+        }
+        if(Bytes_IsDone(&bytes))
         {
-            Packet packet = zero;
-            const int32_t size = sizeof(packet);
-            const int32_t bytes = SDLNet_TCP_Recv(sock.server, &packet, size);
-            if(bytes == size)
-                return packet;
+            if(packet.echo != 0)
+                Rtt_Sample(sock.rtt, (int32_t) (SDL_GetTicks() - packet.echo) - packet.hold);
+            return packet;
         }
     }
     return zero;
@@ -31,3 +97,316 @@ bool Packet_IsStable(const Packet packet)
 {
     return packet.turn > 0 && packet.is_stable;
 }
+
+void Packet_Encode(const Packet packet, Bytes* const bytes)
+{
+    Bytes_PutU8(bytes, PROTOCOL_VERSION);
+    Bytes_PutU8(bytes, PROTOCOL_TURN);
+    Bytes_PutU8(bytes, (packet.is_stable ? PACKET_STABLE : 0)
+        | (packet.game_running ? PACKET_RUNNING : 0)
+        | (packet.is_rollback ? PACKET_ROLLBACK : 0));
+    Bytes_PutVarint(bytes, (uint64_t) packet.turn);
+    Bytes_PutVarint(bytes, (uint64_t) packet.setpoint);
+    Bytes_PutVarint(bytes, (uint64_t) packet.exec_cycle);
+    Bytes_PutVarint(bytes, (uint64_t) packet.client_id);
+    Bytes_PutVarint(bytes, (uint64_t) packet.users_connected);
+    Bytes_PutVarint(bytes, (uint64_t) packet.users);
+    Bytes_PutVarint(bytes, packet.echo);
+    Bytes_PutVarint(bytes, (uint64_t) packet.hold);
+    Bytes_PutVarint(bytes, (uint64_t) packet.probe);
+    Bytes_PutVarint(bytes, (uint64_t) packet.desync);
+    Bytes_PutVarint(bytes, packet.desync_regions);
+    Bytes_PutVarint(bytes, (uint64_t) packet.snapshot);
+    Bytes_PutVarint(bytes, (uint64_t) packet.dropped);
+    int32_t count = 0;
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(Overview_UsedAction(packet.overview[i]))
+            count++;
+    Bytes_PutVarint(bytes, (uint64_t) count);
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(Overview_UsedAction(packet.overview[i]))
+        {
+            Bytes_PutVarint(bytes, (uint64_t) i);
+            Command_Encode(Command_FromOverview(packet.overview[i]), bytes);
+        }
+}
+
+Packet Packet_Decode(Bytes* const bytes)
+{
+    static Packet zero;
+    Packet packet = zero;
+    if(Bytes_GetU8(bytes) != PROTOCOL_VERSION
+    || Bytes_GetU8(bytes) != PROTOCOL_TURN)
+    {
+        bytes->is_bad = true;
+        return zero;
+    }
+    const uint8_t flags = Bytes_GetU8(bytes);
+    packet.is_stable = (flags & PACKET_STABLE) != 0;
+    packet.game_running = (flags & PACKET_RUNNING) != 0;
+    packet.is_rollback = (flags & PACKET_ROLLBACK) != 0;
+    packet.turn = (int32_t) Bytes_GetVarint(bytes);
+    packet.setpoint = (int32_t) Bytes_GetVarint(bytes);
+    packet.exec_cycle = (int32_t) Bytes_GetVarint(bytes);
+    packet.client_id = (int32_t) Bytes_GetVarint(bytes);
+    packet.users_connected = (int32_t) Bytes_GetVarint(bytes);
+    packet.users = (int32_t) Bytes_GetVarint(bytes);
+    packet.echo = (uint32_t) Bytes_GetVarint(bytes);
+    packet.hold = (int32_t) Bytes_GetVarint(bytes);
+    packet.probe = (int32_t) Bytes_GetVarint(bytes);
+    packet.desync = (int32_t) Bytes_GetVarint(bytes);
+    packet.desync_regions = (uint32_t) Bytes_GetVarint(bytes);
+    packet.snapshot = (int32_t) Bytes_GetVarint(bytes);
+    packet.dropped = (int32_t) Bytes_GetVarint(bytes);
+    const int32_t count = (int32_t) Bytes_GetVarint(bytes);
+    for(int32_t i = 0; i < count && !bytes->is_bad; i++)
+    {
+        const uint64_t slot = Bytes_GetVarint(bytes);
+        const Command command = Command_Decode(bytes);
+        if(slot >= COLOR_COUNT)
+            bytes->is_bad = true;
+        else
+            packet.overview[slot] = Command_ToOverview(command);
+    }
+    return packet;
+}
+
+// THE FIELDS THAT CHANGE EVERY TURN COME FIRST, SO THE MASK OF A TURN WITHOUT SURPRISES IS ONE BYTE.
+// THE TURN, THE CYCLES AND THE ECHO TICK ALONG, SO THEY ARE PREDICTED TO MOVE AS MUCH AS LAST TIME.
+static void GetHeaderFields(const Packet packet, int64_t field[])
+{
+    field[ 0] = packet.setpoint;
+    field[ 1] = packet.exec_cycle;
+    field[ 2] = packet.echo;
+    field[ 3] = packet.hold;
+    field[ 4] = packet.turn;
+    field[ 5] = (packet.is_stable ? PACKET_STABLE : 0)
+        | (packet.game_running ? PACKET_RUNNING : 0)
+        | (packet.is_rollback ? PACKET_ROLLBACK : 0);
+    field[ 6] = packet.client_id;
+    field[ 7] = packet.users_connected;
+    field[ 8] = packet.users;
+    field[ 9] = packet.probe;
+    field[10] = packet.desync;
+    field[11] = packet.desync_regions;
+    field[12] = packet.snapshot;
+    field[13] = packet.dropped;
+}
+
+static Packet SetHeaderFields(Packet packet, const int64_t field[])
+{
+    packet.setpoint = (int32_t) field[0];
+    packet.exec_cycle = (int32_t) field[1];
+    packet.echo = (uint32_t) field[2];
+    packet.hold = (int32_t) field[3];
+    packet.turn = (int32_t) field[4];
+    packet.is_stable = (field[5] & PACKET_STABLE) != 0;
+    packet.game_running = (field[5] & PACKET_RUNNING) != 0;
+    packet.is_rollback = (field[5] & PACKET_ROLLBACK) != 0;
+    packet.client_id = (int32_t) field[6];
+    packet.users_connected = (int32_t) field[7];
+    packet.users = (int32_t) field[8];
+    packet.probe = (int32_t) field[9];
+    packet.desync = (int32_t) field[10];
+    packet.desync_regions = (uint32_t) field[11];
+    packet.snapshot = (int32_t) field[12];
+    packet.dropped = (int32_t) field[13];
+    return packet;
+}
+
+// THE CURSOR AND THE BOX OF A CLICK CHANGE MOST, SO THEY COME FIRST, AND THE MASK OF A COMMAND THAT
+// ONLY MOVED THEM IS ONE BYTE. COMMANDS ARE TRIMMED, SO THE DECODED COMMAND MATCHES COMMAND_DECODE.
+static void GetCommandFields(const Command command, int64_t field[])
+{
+    field[ 0] = command.cursor.x;
+    field[ 1] = command.cursor.y;
+    field[ 2] = command.flags;
+    field[ 3] = command.selection_box.a.x;
+    field[ 4] = command.selection_box.a.y;
+    field[ 5] = command.selection_box.b.x;
+    field[ 6] = command.selection_box.b.y;
+    field[ 7] = command.pan.x;
+    field[ 8] = command.pan.y;
+    field[ 9] = command.hotkey;
+    field[10] = command.motive.action;
+    field[11] = command.motive.type;
+    field[12] = command.bits;
+    field[13] = command.color;
+    field[14] = command.age;
+    field[15] = command.civ;
+    field[16] = command.xres;
+    field[17] = command.yres;
+    field[18] = command.sequence;
+}
+
+static Command SetCommandFields(const int64_t field[])
+{
+    static Command zero;
+    Command command = zero;
+    command.cursor.x = (int32_t) field[0];
+    command.cursor.y = (int32_t) field[1];
+    command.flags = (int32_t) field[2];
+    command.selection_box.a.x = (int32_t) field[3];
+    command.selection_box.a.y = (int32_t) field[4];
+    command.selection_box.b.x = (int32_t) field[5];
+    command.selection_box.b.y = (int32_t) field[6];
+    command.pan.x = (int32_t) field[7];
+    command.pan.y = (int32_t) field[8];
+    command.hotkey = (int32_t) field[9];
+    command.motive.action = (Action) field[10];
+    command.motive.type = (Type) field[11];
+    command.bits = (Bits) field[12];
+    command.color = (Color) field[13];
+    command.age = (Age) field[14];
+    command.civ = (Civ) field[15];
+    command.xres = (int32_t) field[16];
+    command.yres = (int32_t) field[17];
+    command.sequence = (int32_t) field[18];
+    return command;
+}
+
+// A MASK OF THE FIELDS THAT MISSED THEIR PREDICTION, THEN BY HOW MUCH EACH MISSED.
+static void PutFields(Bytes* const bytes, const int64_t field[], const int64_t predict[], const int32_t count)
+{
+    uint32_t mask = 0;
+    for(int32_t i = 0; i < count; i++)
+        if(field[i] != predict[i])
+            mask |= 1u << i;
+    Bytes_PutVarint(bytes, mask);
+    for(int32_t i = 0; i < count; i++)
+        if(mask & (1u << i))
+            Bytes_PutZigzag(bytes, field[i] - predict[i]);
+}
+
+static void GetFields(Bytes* const bytes, int64_t field[], const int64_t predict[], const int32_t count)
+{
+    const uint32_t mask = (uint32_t) Bytes_GetVarint(bytes);
+    if(mask >> count)
+        bytes->is_bad = true;
+    for(int32_t i = 0; i < count; i++)
+        field[i] = predict[i] + ((mask & (1u << i)) ? Bytes_GetZigzag(bytes) : 0);
+}
+
+static void Predict(const Codec* const codec, int64_t predict[])
+{
+    for(int32_t i = 0; i < CODEC_FIELDS; i++)
+    {
+        const bool is_stepped = i == 0 || i == 1 || i == 2 || i == 4;
+        predict[i] = codec->field[i] + (is_stepped ? codec->step[i] : 0);
+    }
+}
+
+static void Advance(Codec* const codec, const int64_t field[])
+{
+    for(int32_t i = 0; i < CODEC_FIELDS; i++)
+    {
+        codec->step[i] = field[i] - codec->field[i];
+        codec->field[i] = field[i];
+    }
+}
+
+// THE HEADER FIELDS, THEN A MASK OF THE SLOTS THAT ACTED AND THEIR COMMANDS AS DELTAS AGAINST THE
+// LAST ONES FROM THE SAME SLOTS.
+static void Delta(const Packet packet, Codec* const codec, Bytes* const bytes)
+{
+    int64_t field[CODEC_FIELDS];
+    int64_t predict[CODEC_FIELDS];
+    GetHeaderFields(packet, field);
+    Predict(codec, predict);
+    PutFields(bytes, field, predict, CODEC_FIELDS);
+    Advance(codec, field);
+    uint32_t acted = 0;
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(Overview_UsedAction(packet.overview[i]))
+            acted |= 1u << i;
+    Bytes_PutVarint(bytes, acted);
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(acted & (1u << i))
+        {
+            int64_t command[CODEC_COMMAND_FIELDS];
+            GetCommandFields(Command_Trim(Command_FromOverview(packet.overview[i])), command);
+            PutFields(bytes, command, codec->command[i], CODEC_COMMAND_FIELDS);
+            for(int32_t j = 0; j < CODEC_COMMAND_FIELDS; j++)
+                codec->command[i][j] = command[j];
+        }
+}
+
+static Packet Undelta(Bytes* const bytes, Codec* const codec)
+{
+    static Packet zero;
+    int64_t field[CODEC_FIELDS];
+    int64_t predict[CODEC_FIELDS];
+    Predict(codec, predict);
+    GetFields(bytes, field, predict, CODEC_FIELDS);
+    Advance(codec, field);
+    Packet packet = SetHeaderFields(zero, field);
+    const uint32_t acted = (uint32_t) Bytes_GetVarint(bytes);
+    if(acted >> COLOR_COUNT)
+        bytes->is_bad = true;
+    for(int32_t i = 0; i < COLOR_COUNT && !bytes->is_bad; i++)
+        if(acted & (1u << i))
+        {
+            int64_t command[CODEC_COMMAND_FIELDS];
+            GetFields(bytes, command, codec->command[i], CODEC_COMMAND_FIELDS);
+            const Command decoded = SetCommandFields(command);
+            if(decoded.color >= COLOR_COUNT)
+                bytes->is_bad = true;
+            packet.overview[i] = Command_ToOverview(decoded);
+            for(int32_t j = 0; j < CODEC_COMMAND_FIELDS; j++)
+                codec->command[i][j] = command[j];
+        }
+    return packet;
+}
+
+// THE CODEC MOVES ON WITH EVERY TURN ENCODED, SO EVERY ONE MUST BE SENT, ON THE CHANNEL IT WAS
+// ENCODED FOR.
+void Packet_EncodeDelta(const Packet packet, Codec* const codec, const Huffman* const huffman, Bytes* const bytes)
+{
+    Bytes delta;
+    Bytes_Clear(&delta);
+    Delta(packet, codec, &delta);
+    Bytes_PutU8(bytes, PROTOCOL_VERSION);
+    if(huffman)
+    {
+        Bytes squeezed;
+        Bytes_Clear(&squeezed);
+        Bytes_PutVarint(&squeezed, (uint64_t) delta.size);
+        Huffman_Pack(huffman, &delta, &squeezed);
+        if(squeezed.size < delta.size)
+        {
+            Bytes_PutU8(bytes, PROTOCOL_SQUEEZE);
+            Bytes_PutBytes(bytes, &squeezed);
+            return;
+        }
+    }
+    Bytes_PutU8(bytes, PROTOCOL_DELTA);
+    Bytes_PutBytes(bytes, &delta);
+}
+
+// THE CODEC ONLY MOVES ON ONCE THE WHOLE MESSAGE DECODED.
+Packet Packet_DecodeDelta(Bytes* const bytes, Codec* const codec, const Huffman* const huffman)
+{
+    static Packet zero;
+    Packet packet = zero;
+    Codec next = *codec;
+    if(Bytes_GetU8(bytes) != PROTOCOL_VERSION)
+        bytes->is_bad = true;
+    const uint8_t kind = Bytes_GetU8(bytes);
+    if(kind == PROTOCOL_DELTA)
+        packet = Undelta(bytes, &next);
+    else if(kind == PROTOCOL_SQUEEZE && huffman)
+    {
+        const int32_t size = (int32_t) Bytes_GetVarint(bytes);
+        Bytes delta;
+        Huffman_Unpack(huffman, bytes, &delta, size);
+        packet = Undelta(&delta, &next);
+        if(!Bytes_IsDone(&delta))
+            bytes->is_bad = true;
+    }
+    else
+        bytes->is_bad = true;
+    if(!Bytes_IsDone(bytes))
+        return zero;
+    *codec = next;
+    return packet;
+}
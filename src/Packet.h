@@ -3,26 +3,42 @@
 #include "Overview.h"
 #include "Sock.h"
 #include "Color.h"
+#include "Bytes.h"
+#include "Codec.h"
+#include "Huffman.h"
 
 #include <stdbool.h>
 #include <SDL2/SDL_net.h>
 
-#define PACKET_CONTROL_SPEED_UP ('+')
-#define PACKET_CONTROL_STEADY ('*')
-
-// NO POINTERS ANYWHERE IN HERE! PERFECT FOR TCP...
+// ON THE WIRE A PACKET IS ENCODED WITH PACKET_ENCODE AND ONLY CARRIES THE COMMANDS OF PLAYERS WHO ACTED.
+// THE SETPOINT IS THE CYCLE THE SERVER BELIEVES THE MATCH IS AT WHEN THE TURN LEAVES.
+// WHILE THE SERVER HUNTS A DESYNC, THE PROBE IS THE CYCLE IT WANTS EVERY CLIENT'S PARITY FOR. ONCE
+// FOUND, THE DESYNC IS THE FIRST CYCLE THAT DIFFERS, AND THE REGIONS ARE WHERE IT DIFFERS.
+// WHILE A CLIENT REJOINS, THE SNAPSHOT IS THE CYCLE ITS DONOR IS ASKED TO TAKE ONE AT.
+// DROPPED IS THE SEQUENCE OF THE LAST OF THE CLIENT'S COMMANDS THE SERVER DROPPED.
+// A SERVER RUNNING WITH ROLLBACK FLAGS EVERY TURN SO, AND CLIENTS PREDICT INSTEAD OF WAITING.
+// A COMPRESSING SERVER SENDS EVERY TURN AS A DELTA AGAINST THE LAST ONE ON THE SAME CHANNEL, AND
+// MAY SQUEEZE THE DELTA WITH THE SHARED HUFFMAN CODE, WHICHEVER IS SMALLER.
 
 typedef struct
 {
     Overview overview[COLOR_COUNT];
-    char control;
+    int32_t setpoint;
     int32_t turn;
     int32_t exec_cycle;
     int32_t client_id;
     bool is_stable;
     bool game_running;
+    bool is_rollback;
     int32_t users_connected;
     int32_t users;
+    uint32_t echo;
+    int32_t hold;
+    int32_t probe;
+    int32_t desync;
+    uint32_t desync_regions;
+    int32_t snapshot;
+    int32_t dropped;
 }
 Packet;
 
@@ -31,3 +47,11 @@ Packet Packet_Get(const Sock);
 Packet Packet_ZeroOverviews(Packet);
 
 bool Packet_IsStable(const Packet);
+
+void Packet_Encode(const Packet, Bytes* const);
+
+Packet Packet_Decode(Bytes* const);
+
+void Packet_EncodeDelta(const Packet, Codec* const, const Huffman* const, Bytes* const);
+
+Packet Packet_DecodeDelta(Bytes* const, Codec* const, const Huffman* const);
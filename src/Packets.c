@@ -12,28 +12,59 @@ Packets Packets_Init(void)
     return packets;
 }
 
-Packets Packets_Queue(Packets packets, Packet packet)
+// THE RING IS UNWRAPPED INTO THE FRONT OF THE LARGER ONE.
+static Packets Grow(Packets packets)
 {
+    const int32_t size = Packets_Size(packets);
+    const int32_t max = 2 * packets.max;
+    Packet* const packet = UTIL_ALLOC(Packet, max);
+    for(int32_t i = 0; i < size; i++)
+        packet[i] = packets.packet[UTIL_WRAP(packets.a + i, packets.max)];
+    free(packets.packet);
+    packets.packet = packet;
+    packets.a = 0;
+    packets.b = size;
+    packets.max = max;
+    return packets;
+}
+
+Packets Packets_Queue(Packets packets, const Packet* const packet)
+{
+    if(Packets_Size(packets) == packets.max)
+        packets = Grow(packets);
     const int32_t index = UTIL_WRAP(packets.b, packets.max);
-    packets.packet[index] = packet;
+    packets.packet[index] = *packet;
     packets.b++;
-    if(UTIL_WRAP(packets.b, packets.max)
-    == UTIL_WRAP(packets.a, packets.max))
-        packets.a++;
     return packets;
 }
 
-Packet Packets_Peek(const Packets packets)
+const Packet* Packets_Peek(const Packets packets)
 {
+    if(!Packets_Active(packets))
+        return NULL;
     const int32_t index = UTIL_WRAP(packets.a, packets.max);
-    return packets.packet[index];
+    return &packets.packet[index];
 }
 
-Packets Packets_Dequeue(Packets packets, Packet* packet)
+// THE FRONT TURN IF IT EXECUTES AT THE CYCLE. ONLY EXACT ONCE OLDER TURNS ARE SKIPPED.
+const Packet* Packets_Find(const Packets packets, const int32_t cycles)
 {
-    const int32_t index = UTIL_WRAP(packets.a, packets.max);
-    *packet = packets.packet[index];
-    packets.a++;
+    const Packet* const peek = Packets_Peek(packets);
+    return (peek && peek->exec_cycle == cycles) ? peek : NULL;
+}
+
+Packets Packets_Pop(Packets packets)
+{
+    if(Packets_Active(packets))
+        packets.a++;
+    return packets;
+}
+
+// TURNS FOR CYCLES ALREADY SIMULATED, AS AFTER REJOINING, ARE DROPPED.
+Packets Packets_Skip(Packets packets, const int32_t cycles)
+{
+    for(const Packet* peek = Packets_Peek(packets); peek && peek->exec_cycle < cycles; peek = Packets_Peek(packets))
+        packets = Packets_Pop(packets);
     return packets;
 }
 
@@ -4,6 +4,13 @@
 
 #include <stdint.h>
 
+// STABLE TURNS WAITING FOR THEIR CYCLE, IN THE ORDER THEY ARRIVED. THE SERVER RELAYS TURNS WITH
+// EXEC CYCLES THAT NEVER GO DOWN, SO THE QUEUE IS SORTED BY EXEC CYCLE AND THE TURNS FOR ANY CYCLE
+// ARE A RUN AT THE FRONT ONCE THE OLDER ONES ARE SKIPPED. A FULL QUEUE GROWS RATHER THAN DROP A TURN.
+//
+// A PACKET IS COPIED ONCE, WHEN QUEUED, AND IS READ IN PLACE AFTER. A PEEKED POINTER LASTS UNTIL THE
+// NEXT QUEUE, WHICH MAY GROW THE RING.
+
 typedef struct
 {
     Packet* packet;
@@ -15,11 +22,15 @@ Packets;
 
 Packets Packets_Init(void);
 
-Packets Packets_Queue(Packets, Packet);
+Packets Packets_Queue(Packets, const Packet* const);
+
+const Packet* Packets_Peek(const Packets);
+
+const Packet* Packets_Find(const Packets, const int32_t cycles);
 
-Packet Packets_Peek(const Packets);
+Packets Packets_Pop(Packets);
 
-Packets Packets_Dequeue(Packets, Packet*);
+Packets Packets_Skip(Packets, const int32_t cycles);
 
 void Packets_Free(const Packets);
 
@@ -0,0 +1,30 @@
+#include "Parities.h"
+
+#include "Util.h"
+
+Parities Parities_Make(const int32_t max)
+{
+    static Parities zero;
+    Parities parities = zero;
+    parities.parity = UTIL_ALLOC(Parity, max);
+    parities.max = max;
+    for(int32_t i = 0; i < max; i++)
+        parities.parity[i].cycles = -1;
+    return parities;
+}
+
+void Parities_Free(const Parities parities)
+{
+    free(parities.parity);
+}
+
+void Parities_Put(const Parities parities, const Parity parity)
+{
+    parities.parity[UTIL_WRAP(parity.cycles, parities.max)] = parity;
+}
+
+// A CYCLE NEVER SIMULATED OR ALREADY OVERWRITTEN COMES BACK WITH SOME OTHER CYCLE.
+Parity Parities_Get(const Parities parities, const int32_t cycles)
+{
+    return parities.parity[UTIL_WRAP(UTIL_MAX(cycles, 0), parities.max)];
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Parity.h"
+
+// THE PARITY OF EVERY RECENT CYCLE, SO THAT A CLIENT CAN STILL ANSWER FOR A CYCLE IT HAS ALREADY
+// SIMULATED PAST WHILE THE SERVER HUNTS FOR WHERE A DESYNC BEGAN.
+
+typedef struct
+{
+    Parity* parity;
+    int32_t max;
+}
+Parities;
+
+Parities Parities_Make(const int32_t max);
+
+void Parities_Free(const Parities);
+
+void Parities_Put(const Parities, const Parity);
+
+Parity Parities_Get(const Parities, const int32_t cycles);
@@ -0,0 +1,134 @@
+#include "Parity.h"
+
+#include "Config.h"
+#include "Protocol.h"
+#include "Util.h"
+
+#include <stdio.h>
+
+// FOLDS TWO MORE FIELDS INTO A HASH WITH ONE MULTIPLY. CHEAP, BUT WEAK UNTIL FINISHED.
+uint64_t Parity_Mix(const uint64_t hash, const int32_t a, const int32_t b)
+{
+    const uint64_t x = (hash ^ (((uint64_t) (uint32_t) a << 32) | (uint32_t) b)) * 0x9E3779B97F4A7C15;
+    return x ^ (x >> 29);
+}
+
+// THE SPLITMIX64 FINALIZER, SO THAT SUMMED HASHES DO NOT CANCEL BY ACCIDENT.
+uint64_t Parity_Finish(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EB;
+    x ^= x >> 31;
+    return x;
+}
+
+int32_t Parity_GetRegion(const Point cart, const int32_t cols, const int32_t rows)
+{
+    const int32_t x = (cart.x * PARITY_SIDE) / UTIL_MAX(1, cols);
+    const int32_t y = (cart.y * PARITY_SIDE) / UTIL_MAX(1, rows);
+    return PARITY_SIDE * UTIL_MIN(UTIL_MAX(y, 0), PARITY_SIDE - 1)
+                       + UTIL_MIN(UTIL_MAX(x, 0), PARITY_SIDE - 1);
+}
+
+void Parity_Add(Parity* const parity, const int32_t region, const uint64_t aspect[ASPECT_COUNT])
+{
+    for(int32_t i = 0; i < ASPECT_COUNT; i++)
+    {
+        parity->aspect[i] += aspect[i];
+        parity->region[region] += aspect[i];
+    }
+}
+
+Parity Parity_Seal(Parity parity)
+{
+    uint64_t root = 0;
+    for(int32_t i = 0; i < ASPECT_COUNT; i++)
+        root = Parity_Finish(Parity_Mix(root ^ parity.aspect[i], i, parity.cycles));
+    parity.root = root;
+    return parity;
+}
+
+// CLIENTS REPORT THE PARITY OF THE LAST CHECKPOINT THEY PASSED RATHER THAN OF THEIR CURRENT CYCLE,
+// SO THAT TWO CLIENTS A CYCLE OR TWO APART STILL REPORT THE SAME CYCLE MOST OF THE TIME.
+int32_t Parity_GetCheckpoint(const int32_t cycles)
+{
+    return cycles - cycles % CONFIG_PARITY_INTERVAL;
+}
+
+bool Parity_IsCheckpoint(const int32_t cycles)
+{
+    return cycles % CONFIG_PARITY_INTERVAL == 0;
+}
+
+uint32_t Parity_DiffAspects(const Parity a, const Parity b)
+{
+    uint32_t mask = 0;
+    for(int32_t i = 0; i < ASPECT_COUNT; i++)
+        if(a.aspect[i] != b.aspect[i])
+            mask |= 1u << i;
+    return mask;
+}
+
+uint32_t Parity_DiffRegions(const Parity a, const Parity b)
+{
+    uint32_t mask = 0;
+    for(int32_t i = 0; i < PARITY_REGIONS; i++)
+        if(a.region[i] != b.region[i])
+            mask |= 1u << i;
+    return mask;
+}
+
+const char* Parity_GetAspectName(const Aspect aspect)
+{
+    switch(aspect)
+    {
+    case ASPECT_POSITION: return "POSITION";
+    case ASPECT_HEALTH: return "HEALTH";
+    case ASPECT_PATH: return "PATH";
+    case ASPECT_TIMER: return "TIMER";
+    default: return "NONE";
+    }
+}
+
+void Parity_Print(const Parity parity)
+{
+    printf("PARITY AT CYCLE %d :: 0x%016lX\n", parity.cycles, parity.root);
+    for(int32_t i = 0; i < ASPECT_COUNT; i++)
+        printf("%-8s :: 0x%016lX\n", Parity_GetAspectName((Aspect) i), parity.aspect[i]);
+    for(int32_t i = 0; i < PARITY_REGIONS; i++)
+        printf("REGION %2d :: 0x%016lX\n", i, parity.region[i]);
+}
+
+// ONLY SENT WHEN THE SERVER PROBES A CYCLE WHILE HUNTING A DESYNC.
+void Parity_Encode(const Parity parity, Bytes* const bytes)
+{
+    Bytes_PutU8(bytes, PROTOCOL_VERSION);
+    Bytes_PutU8(bytes, PROTOCOL_PARITY);
+    Bytes_PutZigzag(bytes, parity.cycles);
+    Bytes_PutVarint(bytes, parity.root);
+    for(int32_t i = 0; i < ASPECT_COUNT; i++)
+        Bytes_PutVarint(bytes, parity.aspect[i]);
+    for(int32_t i = 0; i < PARITY_REGIONS; i++)
+        Bytes_PutVarint(bytes, parity.region[i]);
+}
+
+Parity Parity_Decode(Bytes* const bytes)
+{
+    static Parity zero;
+    Parity parity = zero;
+    if(Bytes_GetU8(bytes) != PROTOCOL_VERSION
+    || Bytes_GetU8(bytes) != PROTOCOL_PARITY)
+    {
+        bytes->is_bad = true;
+        return zero;
+    }
+    parity.cycles = (int32_t) Bytes_GetZigzag(bytes);
+    parity.root = Bytes_GetVarint(bytes);
+    for(int32_t i = 0; i < ASPECT_COUNT; i++)
+        parity.aspect[i] = Bytes_GetVarint(bytes);
+    for(int32_t i = 0; i < PARITY_REGIONS; i++)
+        parity.region[i] = Bytes_GetVarint(bytes);
+    return parity;
+}
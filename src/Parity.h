@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Aspect.h"
+#include "Point.h"
+#include "Bytes.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A HASH OF THE SIMULATION AT ONE CYCLE, KEPT PER ASPECT AND PER REGION OF THE MAP. EVERY UNIT HASHES
+// EACH ASPECT ON ITS OWN AND THE UNIT HASHES ARE SUMMED, SO THE ORDER OF THE UNITS DOES NOT MATTER.
+// THE ROOT FOLDS THE ASPECTS, AND IS WHAT CLIENTS COMPARE. WHEN TWO ROOTS DIFFER, THE ASPECTS SAY
+// WHAT DIFFERS AND THE REGIONS SAY WHERE.
+//
+// HASHING EVERY UNIT IS A PASS OVER THE WHOLE SIMULATION, SO IT IS ONLY DONE AT CHECKPOINTS. THOSE
+// ARE THE ONLY CYCLES A CLIENT EVER REPORTS OR IS PROBED FOR.
+
+#define PARITY_SIDE (4)
+
+#define PARITY_REGIONS (PARITY_SIDE * PARITY_SIDE)
+
+typedef struct
+{
+    uint64_t aspect[ASPECT_COUNT];
+    uint64_t region[PARITY_REGIONS];
+    uint64_t root;
+    int32_t cycles;
+}
+Parity;
+
+uint64_t Parity_Mix(const uint64_t hash, const int32_t a, const int32_t b);
+
+uint64_t Parity_Finish(uint64_t);
+
+int32_t Parity_GetRegion(const Point cart, const int32_t cols, const int32_t rows);
+
+void Parity_Add(Parity* const, const int32_t region, const uint64_t aspect[ASPECT_COUNT]);
+
+Parity Parity_Seal(Parity);
+
+int32_t Parity_GetCheckpoint(const int32_t cycles);
+
+bool Parity_IsCheckpoint(const int32_t cycles);
+
+uint32_t Parity_DiffAspects(const Parity, const Parity);
+
+uint32_t Parity_DiffRegions(const Parity, const Parity);
+
+const char* Parity_GetAspectName(const Aspect);
+
+void Parity_Print(const Parity);
+
+void Parity_Encode(const Parity, Bytes* const);
+
+Parity Parity_Decode(Bytes* const);
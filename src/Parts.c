@@ -169,11 +169,11 @@ Parts Parts_GetSmoke(void)
     return parts;
 }
 
-Parts Parts_GetFire(void)
+Parts Parts_GetFire(const int32_t variant)
 {
     // NOTICE THE 1 PART - RANDOM FIRE IS CHOSEN.
     Parts parts = { NULL, 1 };
-    switch(Util_Rand() % 5)
+    switch(variant % 5)
     {
         case 0: parts.part = fire_a; break;
         case 1: parts.part = fire_b; break;
@@ -18,7 +18,7 @@ Parts Parts_GetRedArrows(void);
 
 Parts Parts_GetSmoke(void);
 
-Parts Parts_GetFire(void);
+Parts Parts_GetFire(const int32_t variant);
 
 Parts Parts_FromButton(const Button, const Age, const Civ);
 
@@ -1,6 +1,6 @@
 #include "Point.h"
 
-#include "Util.h"
+#include "Fixed.h"
 #include "Config.h"
 
 #include <stdio.h>
@@ -79,16 +79,12 @@ bool Point_IsZero(const Point point)
 
 int32_t Point_Mag(const Point point)
 {
-    return Util_Sqrt(
-            (uint64_t) point.x * (uint64_t) point.x +
-            (uint64_t) point.y * (uint64_t) point.y);
+    return Fixed_Mag(point);
 }
 
 Point Point_Normalize(const Point point, const int32_t normal)
 {
-    const int32_t magnitude = Point_Mag(point);
-    const Point elongated = Point_Mul(point, normal);
-    return Point_Div(elongated, magnitude);
+    return Fixed_Normalize(point, normal);
 }
 
 Point Point_Dot(const Point a, const Point b)
@@ -106,15 +102,6 @@ int32_t Point_Slope(const Point point)
     return point.y / (point.x == 0 ? 1 : point.x);
 }
 
-Point Point_Rand(void)
-{
-    const Point point = {
-        Util_Rand(),
-        Util_Rand(),
-    };
-    return point;
-}
-
 Point Point_Wrap(const int32_t index, const int32_t width, const int32_t res)
 {
     const int32_t x = (index * width ) % res;
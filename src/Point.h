@@ -36,8 +36,6 @@ Point Point_Dot(const Point a, const Point b);
 
 int32_t Point_Slope(const Point);
 
-Point Point_Rand(void);
-
 Point Point_Wrap(const int32_t index, const int32_t width, const int32_t res);
 
 Point Point_Layout(const int32_t index, const int32_t xres, const int32_t yres);
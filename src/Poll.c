@@ -0,0 +1,198 @@
+// CLOCK_MONOTONIC IS POSIX, NOT C11.
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "Poll.h"
+
+#include "Util.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+
+// SDL_NET DOES NOT EXPOSE DESCRIPTORS, BUT EVERY SDL_NET 2 SOCKET STARTS WITH ITS READY FLAG
+// FOLLOWED BY ITS DESCRIPTOR (SEE SDLNETSYS.H). NO OTHER MAJOR VERSION IS KNOWN TO KEEP THAT
+// LAYOUT, SO THE BUILD STOPS ON ONE, POLL_MAKE STOPS ON A MISMATCHED LIBRARY, AND EVERY WATCHED
+// DESCRIPTOR IS CHECKED TO BE A SOCKET OF THE EXPECTED TYPE BEFORE IT IS TRUSTED.
+#if SDL_NET_MAJOR_VERSION != 2
+#error "POLL - SDL_NET SOCKET LAYOUT IS ONLY KNOWN FOR SDL_NET 2"
+#endif
+
+typedef struct
+{
+    int ready;
+    int channel;
+}
+Generic;
+
+static int GetDescriptor(void* const socket)
+{
+    return ((Generic*) socket)->channel;
+}
+
+static int Verify(void* const socket, const int type)
+{
+    const int fd = GetDescriptor(socket);
+    int actual = 0;
+    socklen_t size = sizeof(actual);
+    if(getsockopt(fd, SOL_SOCKET, SO_TYPE, &actual, &size) == -1 || actual != type)
+        Util_Bomb("POLL - DESCRIPTOR %d IS NOT THE EXPECTED SOCKET; SDL_NET LAYOUT CHANGED\n", fd);
+    return fd;
+}
+
+static void Add(const Poll poll, const int fd, const int32_t tag)
+{
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.u64 = (uint32_t) tag;
+    if(epoll_ctl(poll.epoll, EPOLL_CTL_ADD, fd, &event) == -1)
+        Util_Bomb("POLL - COULD NOT WATCH DESCRIPTOR %d\n", fd);
+}
+
+Poll Poll_Make(const int32_t interval_ms)
+{
+    static Poll zero;
+    Poll poll = zero;
+    const int32_t linked = SDLNet_Linked_Version()->major;
+    if(linked != SDL_NET_MAJOR_VERSION)
+        Util_Bomb("POLL - BUILT FOR SDL_NET %d BUT LINKED TO SDL_NET %d\n", SDL_NET_MAJOR_VERSION, linked);
+    poll.epoll = epoll_create1(EPOLL_CLOEXEC);
+    poll.timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    poll.wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(poll.epoll == -1 || poll.timer == -1 || poll.wake == -1)
+        Util_Bomb("POLL - COULD NOT CREATE EPOLL, TIMERFD, OR EVENTFD\n");
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = interval_ms / 1000;
+    spec.it_interval.tv_nsec = (interval_ms % 1000) * 1000000L;
+    spec.it_value = spec.it_interval;
+    timerfd_settime(poll.timer, 0, &spec, NULL);
+    Add(poll, poll.timer, POLL_TIMER);
+    Add(poll, poll.wake, POLL_WAKE);
+    return poll;
+}
+
+void Poll_Free(const Poll poll)
+{
+    close(poll.wake);
+    close(poll.timer);
+    close(poll.epoll);
+}
+
+void Poll_Watch(const Poll poll, TCPsocket socket, const int32_t tag)
+{
+    Add(poll, Verify(socket, SOCK_STREAM), tag);
+}
+
+void Poll_WatchUdp(const Poll poll, UDPsocket socket, const int32_t tag)
+{
+    Add(poll, Verify(socket, SOCK_DGRAM), tag);
+}
+
+void Poll_Unwatch(const Poll poll, TCPsocket socket)
+{
+    epoll_ctl(poll.epoll, EPOLL_CTL_DEL, GetDescriptor(socket), NULL);
+}
+
+void Poll_Wake(const Poll poll)
+{
+    const uint64_t one = 1;
+    if(write(poll.wake, &one, sizeof(one)) != sizeof(one))
+        return;
+}
+
+// THE TIMER AND WAKE COUNTERS ARE DRAINED HERE. EXPIRATIONS MISSED WHILE THE SERVER
+// WAS BUSY COLLAPSE INTO ONE TURN, AND SEVERAL WAKES COLLAPSE INTO ONE.
+int32_t Poll_Wait(const Poll poll, int32_t tags[POLL_EVENTS_MAX])
+{
+    struct epoll_event events[POLL_EVENTS_MAX];
+    const int32_t count = epoll_wait(poll.epoll, events, POLL_EVENTS_MAX, -1);
+    if(count == -1)
+    {
+        if(errno != EINTR)
+            Util_Bomb("POLL - EPOLL_WAIT FAILED\n");
+        return 0;
+    }
+    int32_t ready = 0;
+    for(int32_t i = 0; i < count; i++)
+    {
+        const int32_t tag = (int32_t) (uint32_t) events[i].data.u64;
+        if(tag == POLL_TIMER || tag == POLL_WAKE)
+        {
+            uint64_t counter;
+            const int fd = (tag == POLL_TIMER) ? poll.timer : poll.wake;
+            if(read(fd, &counter, sizeof(counter)) != sizeof(counter))
+                continue;
+        }
+        tags[ready++] = tag;
+    }
+    return ready;
+}
+
+// A FULL SOCKET TAKES NOTHING, AND A PEER THAT IS GONE RAISES NO SIGPIPE.
+int32_t Poll_Offer(TCPsocket socket, const void* const data, const int32_t size)
+{
+    const ssize_t sent = send(GetDescriptor(socket), data, (size_t) size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if(sent >= 0)
+        return (int32_t) sent;
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+}
+
+#else
+
+Poll Poll_Make(const int32_t interval_ms)
+{
+    (void) interval_ms;
+    Util_Bomb("POLL - EPOLL IS ONLY AVAILABLE ON LINUX\n");
+    static Poll zero;
+    return zero;
+}
+
+void Poll_Free(const Poll poll)
+{
+    (void) poll;
+}
+
+void Poll_Watch(const Poll poll, TCPsocket socket, const int32_t tag)
+{
+    (void) poll;
+    (void) socket;
+    (void) tag;
+}
+
+void Poll_WatchUdp(const Poll poll, UDPsocket socket, const int32_t tag)
+{
+    (void) poll;
+    (void) socket;
+    (void) tag;
+}
+
+void Poll_Unwatch(const Poll poll, TCPsocket socket)
+{
+    (void) poll;
+    (void) socket;
+}
+
+void Poll_Wake(const Poll poll)
+{
+    (void) poll;
+}
+
+int32_t Poll_Wait(const Poll poll, int32_t tags[POLL_EVENTS_MAX])
+{
+    (void) poll;
+    (void) tags;
+    return 0;
+}
+
+int32_t Poll_Offer(TCPsocket socket, const void* const data, const int32_t size)
+{
+    return (SDLNet_TCP_Send(socket, data, size) < size) ? -1 : size;
+}
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <SDL2/SDL_net.h>
+#include <stdint.h>
+
+// WAITS ON EVERY SERVER SOCKET AND A WALL CLOCK TURN TIMER AT ONCE WITH EPOLL AND A TIMERFD.
+// THE SERVER SLEEPS UNTIL A SOCKET IS READABLE OR A TURN IS DUE, SO AN IDLE SERVER USES NO CPU
+// AND TURNS GO OUT ON SCHEDULE NO MATTER HOW MUCH TRAFFIC ARRIVES. LINUX ONLY - ELSEWHERE THE
+// SERVER POLLS WITH SDLNET_CHECKSOCKETS. ANOTHER THREAD CAN INTERRUPT THE WAIT WITH A WAKE.
+//
+// AN OFFER SENDS AS MUCH AS A SOCKET TAKES WITHOUT WAITING, OR -1 ONCE THE PEER IS GONE. ELSEWHERE
+// AN OFFER IS AN ORDINARY BLOCKING SEND.
+
+#define POLL_TIMER (-1)
+
+#define POLL_WAKE (-2)
+
+#define POLL_EVENTS_MAX (32)
+
+typedef struct
+{
+    int32_t epoll;
+    int32_t timer;
+    int32_t wake;
+}
+Poll;
+
+Poll Poll_Make(const int32_t interval_ms);
+
+void Poll_Free(const Poll);
+
+void Poll_Watch(const Poll, TCPsocket, const int32_t tag);
+
+void Poll_WatchUdp(const Poll, UDPsocket, const int32_t tag);
+
+void Poll_Unwatch(const Poll, TCPsocket);
+
+void Poll_Wake(const Poll);
+
+int32_t Poll_Wait(const Poll, int32_t tags[POLL_EVENTS_MAX]);
+
+int32_t Poll_Offer(TCPsocket, const void* const data, const int32_t size);
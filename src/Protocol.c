@@ -0,0 +1,7 @@
+#include "Protocol.h"
+
+// MINUS ONE FOR A MESSAGE TOO SHORT OR OF ANOTHER VERSION.
+int32_t Protocol_GetKind(const Bytes* const bytes)
+{
+    return (bytes->size >= 2 && bytes->byte[0] == PROTOCOL_VERSION) ? bytes->byte[1] : -1;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Bytes.h"
+
+#include <stdint.h>
+
+// EVERY MESSAGE STARTS WITH THE PROTOCOL VERSION AND THE MESSAGE KIND.
+// A PEER DROPS ANY MESSAGE WITH A VERSION IT DOES NOT SPEAK. A RECEIVER READS THE KIND ONCE AND
+// HANDS THE MESSAGE TO THE ONE DECODER FOR IT, WHICH CHECKS BOTH BYTES AGAIN.
+
+#define PROTOCOL_VERSION (4)
+
+typedef enum
+{
+    PROTOCOL_UPLINK,
+    PROTOCOL_TURN,
+    PROTOCOL_JOIN,
+    PROTOCOL_ASSIGN,
+    PROTOCOL_DATAGRAM,
+    PROTOCOL_COMMAND,
+    PROTOCOL_PARITY,
+    PROTOCOL_CHUNK,
+    PROTOCOL_DELTA,
+    PROTOCOL_SQUEEZE,
+    PROTOCOL_HANDOFF,
+}
+Protocol;
+
+int32_t Protocol_GetKind(const Bytes* const);
@@ -0,0 +1,12 @@
+#pragma once
+
+// EVERY DRAW FROM THE SIMULATION RANDOM STREAM NAMES ITS PURPOSE SO THAT
+// TWO DIFFERENT USES FOR THE SAME UNIT ON THE SAME CYCLE NEVER SHARE A VALUE.
+
+typedef enum
+{
+    PURPOSE_ENTROPY_X,
+    PURPOSE_ENTROPY_Y,
+    PURPOSE_ENTROPY_STATIC,
+}
+Purpose;
@@ -0,0 +1,36 @@
+#include "Rand.h"
+
+// See: https://nullprogram.com/blog/2018/07/31/ (lowbias32).
+static uint32_t Mix(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7FEB352D;
+    x ^= x >> 15;
+    x *= 0x846CA68B;
+    x ^= x >> 16;
+    return x;
+}
+
+static uint32_t Key(const int32_t cycles, const Purpose purpose)
+{
+    const uint32_t golden = 0x9E3779B9;
+    return Mix(Mix((uint32_t) purpose + golden) ^ (uint32_t) cycles);
+}
+
+static uint16_t Draw(const uint32_t key, const int32_t id)
+{
+    return (uint16_t) (Mix(key ^ (uint32_t) id) & RAND_MAX_VALUE);
+}
+
+uint16_t Rand_Get(const int32_t id, const int32_t cycles, const Purpose purpose)
+{
+    return Draw(Key(cycles, purpose), id);
+}
+
+// BRANCH FREE WITH A LOOP INVARIANT KEY - GCC AND CLANG VECTORIZE THIS AT -O3 -march=native.
+void Rand_Batch(const int32_t id[], uint16_t out[], const int32_t count, const int32_t cycles, const Purpose purpose)
+{
+    const uint32_t key = Key(cycles, purpose);
+    for(int32_t i = 0; i < count; i++)
+        out[i] = Draw(key, id[i]);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Purpose.h"
+
+#include <stdint.h>
+
+// COUNTER BASED - EACH VALUE IS A PURE FUNCTION OF (ID, CYCLES, PURPOSE), SO VALUES
+// CAN BE DRAWN FROM ANY THREAD IN ANY ORDER AND REMAIN IDENTICAL ACROSS CLIENTS.
+
+#define RAND_MAX_VALUE (32767)
+
+uint16_t Rand_Get(const int32_t id, const int32_t cycles, const Purpose);
+
+void Rand_Batch(const int32_t id[], uint16_t out[], const int32_t count, const int32_t cycles, const Purpose);
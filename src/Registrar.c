@@ -5,6 +5,7 @@
 #include "Interfac.h"
 #include "Terrain.h"
 
+#include "Config.h"
 #include "Util.h"
 
 static Registrar New(const int32_t count, const int32_t files[], const int32_t file_count)
@@ -116,6 +117,42 @@ Registrar Registrar_LoadInterfac(const char* const path)
     return Registrar_Load(path, "interfac.drs", 1, (int32_t*) interfac, UTIL_LEN(interfac));
 }
 
+// AN ANIMATION WITH FRAMES OF THE GIVEN SIZE BUT NO PIXELS. THE SIMULATION ONLY EVER READS THE FRAME
+// COUNT, AND SELECTING WITH A BOX ONLY THE HOTSPOTS.
+static Animation Blank(const int32_t count, const int32_t width, const int32_t height)
+{
+    static Animation zero;
+    Animation animation = zero;
+    animation.surface = UTIL_ALLOC(SDL_Surface*, count);
+    animation.frame = UTIL_ALLOC(Frame, count);
+    animation.image = UTIL_ALLOC(Image, count);
+    animation.count = count;
+    for(int32_t i = 0; i < count; i++)
+    {
+        animation.frame[i].width = width;
+        animation.frame[i].height = height;
+        animation.frame[i].hotspot_x = width / 2;
+        animation.frame[i].hotspot_y = height / 2;
+    }
+    return animation;
+}
+
+static Registrar Stub(const int32_t files[], const int32_t file_count, const int32_t count, const int32_t width, const int32_t height)
+{
+    int32_t max = 0;
+    for(int32_t i = 0; i < file_count; i++)
+        max = UTIL_MAX(max, files[i] + 1);
+    const Registrar registrar = New(max, files, file_count);
+    for(int32_t i = 0; i < file_count; i++)
+    {
+        const int32_t file = files[i];
+        if(file != FILE_NONE)
+            for(int32_t j = 0; j < (int32_t) COLOR_COUNT; j++)
+                registrar.animation[j][file] = Blank(count, width, height);
+    }
+    return registrar;
+}
+
 Registrar Registrar_LoadTerrain(const char* const path)
 {
     static const Terrain terrain[] = {
@@ -135,3 +172,24 @@ Registrar Registrar_LoadGraphics(const char* const path)
     };
     return Registrar_Load(path, "graphics.drs", 0, (int32_t*) graphics, UTIL_LEN(graphics));
 }
+
+// STAND INS FOR THE GAME DATA, FOR RUNNING THE SIMULATION WITHOUT IT.
+Registrar Registrar_StubTerrain(void)
+{
+    static const Terrain terrain[] = {
+#define FILE_X(name, file, upgrade, prio, walkable, type, max_speed, health, attack, width, single_frame, multi_state, expire, inanimate, dimensions, action, detail, midding) name,
+        FILE_X_TERRAIN
+#undef FILE_X
+    };
+    return Stub((int32_t*) terrain, UTIL_LEN(terrain), 1, 96, 48);
+}
+
+Registrar Registrar_StubGraphics(void)
+{
+    static const Graphics graphics[] = {
+#define FILE_X(name, file, upgrade, prio, walkable, type, max_speed, health, attack, width, single_frame, multi_state, expire, inanimate, dimensions, action, detail, midding) name,
+        FILE_X_GRAPHICS
+#undef FILE_X
+    };
+    return Stub((int32_t*) graphics, UTIL_LEN(graphics), 10 * CONFIG_DIRECTION_COUNT_NOT_MIRRORED, 64, 64);
+}
@@ -21,3 +21,7 @@ Registrar Registrar_LoadInterfac(const char* const path);
 Registrar Registrar_LoadTerrain(const char* const path);
 
 Registrar Registrar_LoadGraphics(const char* const path);
+
+Registrar Registrar_StubTerrain(void);
+
+Registrar Registrar_StubGraphics(void);
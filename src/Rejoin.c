@@ -0,0 +1,65 @@
+#include "Rejoin.h"
+
+#include "Config.h"
+#include "Util.h"
+
+Rejoin Rejoin_Start(Rejoin rejoin, const int32_t slot, const int32_t donor, const int32_t cycles)
+{
+    rejoin.count = 0;
+    rejoin.sent = 0;
+    rejoin.chunks = 0;
+    rejoin.paced = 0;
+    rejoin.slot = slot;
+    rejoin.donor = donor;
+    rejoin.cycles = cycles;
+    rejoin.taken = 0;
+    rejoin.relayed = 0;
+    rejoin.waited = 0;
+    rejoin.is_taken = false;
+    rejoin.is_active = true;
+    return rejoin;
+}
+
+// THE BACKLOG'S AND CHUNKS' MEMORY IS KEPT FOR THE NEXT CLIENT TO COME BACK.
+Rejoin Rejoin_Stop(Rejoin rejoin)
+{
+    rejoin.count = 0;
+    rejoin.chunks = 0;
+    rejoin.is_active = false;
+    return rejoin;
+}
+
+Rejoin Rejoin_Keep(Rejoin rejoin, const Bytes* const bytes)
+{
+    if(rejoin.count == rejoin.max)
+    {
+        rejoin.max = (rejoin.max == 0) ? 64 : 2 * rejoin.max;
+        rejoin.backlog = UTIL_REALLOC(rejoin.backlog, Bytes, rejoin.max);
+    }
+    rejoin.backlog[rejoin.count++] = *bytes;
+    return rejoin;
+}
+
+Rejoin Rejoin_Hold(Rejoin rejoin, const Bytes* const bytes)
+{
+    if(rejoin.chunks == rejoin.chunks_max)
+    {
+        rejoin.chunks_max = (rejoin.chunks_max == 0) ? 64 : 2 * rejoin.chunks_max;
+        rejoin.chunk = UTIL_REALLOC(rejoin.chunk, Bytes, rejoin.chunks_max);
+    }
+    rejoin.chunk[rejoin.chunks++] = *bytes;
+    return rejoin;
+}
+
+Rejoin Rejoin_Wait(Rejoin rejoin)
+{
+    if(++rejoin.waited > CONFIG_SOCKETS_REJOIN_PATIENCE)
+        rejoin = Rejoin_Stop(rejoin);
+    return rejoin;
+}
+
+void Rejoin_Free(const Rejoin rejoin)
+{
+    free(rejoin.backlog);
+    free(rejoin.chunk);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Bytes.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// THE SERVER'S SIDE OF BRINGING A CLIENT BACK INTO A RUNNING MATCH. THE DONOR, A CLIENT IN STEP, IS
+// ASKED FOR A SNAPSHOT AT A CYCLE NO TURN SENT SO FAR EXECUTES AT, SO THE SNAPSHOT PLUS THE TURNS
+// SENT FROM THEN ON IS THE WHOLE MATCH. THE DONOR'S CHUNKS ARE HELD AS THEY ARRIVE AND PACED OUT TO
+// THE CLIENT AS FAST AS IT TAKES THEM, AND THE CLIENT'S OWN TURNS ARE KEPT IN THE BACKLOG, ALREADY
+// ENCODED, AND PACED OUT BEHIND THE LAST CHUNK. PACED COUNTS THE CHUNKS AND SENT THE BACKLOGGED
+// TURNS GONE SO FAR.
+// THE DONOR MAY SNAPSHOT A LITTLE LATER THAN ASKED IF IT WAS ALREADY PAST THE CYCLE, AND TAKEN IS
+// THE CYCLE ITS FIRST CHUNK CAME FROM. A REJOIN MAKING NO HEADWAY FOR TOO MANY TURNS, AS ITS DONOR
+// WENT QUIET OR ITS CLIENT TAKES NOTHING, IS GIVEN UP, AND THE SERVER ASKS AGAIN.
+
+typedef struct
+{
+    Bytes* backlog;
+    int32_t count;
+    int32_t max;
+    int32_t sent;
+    Bytes* chunk;
+    int32_t chunks;
+    int32_t chunks_max;
+    int32_t paced;
+    int32_t slot;
+    int32_t donor;
+    int32_t cycles;
+    int32_t taken;
+    int32_t relayed;
+    int32_t waited;
+    bool is_taken;
+    bool is_active;
+}
+Rejoin;
+
+Rejoin Rejoin_Start(Rejoin, const int32_t slot, const int32_t donor, const int32_t cycles);
+
+Rejoin Rejoin_Stop(Rejoin);
+
+Rejoin Rejoin_Keep(Rejoin, const Bytes* const);
+
+Rejoin Rejoin_Hold(Rejoin, const Bytes* const);
+
+Rejoin Rejoin_Wait(Rejoin);
+
+void Rejoin_Free(const Rejoin);
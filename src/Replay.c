@@ -0,0 +1,174 @@
+#include "Replay.h"
+
+#include "Util.h"
+
+#include <SDL2/SDL.h>
+
+#define PREFIX (2)
+
+#define FRAME_TURN (0)
+#define FRAME_END (1)
+
+static void Write(Replay* const replay, const Bytes* const bytes)
+{
+    const uint8_t prefix[PREFIX] = {
+        (uint8_t) (bytes->size >> 0),
+        (uint8_t) (bytes->size >> 8),
+    };
+    fwrite(prefix, 1, PREFIX, replay->fp);
+    fwrite(bytes->byte, 1, (size_t) bytes->size, replay->fp);
+}
+
+// FALSE AT THE END OF THE FILE, OR AT A FRAME CUT SHORT BY A CLIENT THAT NEVER CLOSED ITS REPLAY.
+static bool Read(Replay* const replay, Bytes* const bytes)
+{
+    Bytes_Clear(bytes);
+    uint8_t prefix[PREFIX];
+    if(fread(prefix, 1, PREFIX, replay->fp) != PREFIX)
+        return false;
+    const int32_t size = prefix[0] | (prefix[1] << 8);
+    if(size > BYTES_MAX
+    || fread(bytes->byte, 1, (size_t) size, replay->fp) != (size_t) size)
+        return false;
+    bytes->size = size;
+    return true;
+}
+
+Replay* Replay_Create(const char* const path, const int32_t users, const Color color, const Civ civ, const int32_t map_size)
+{
+    FILE* const fp = fopen(path, "wb");
+    if(fp == NULL)
+        Util_Bomb("REPLAY - COULD NOT CREATE %s\n", path);
+    Replay* const replay = UTIL_ALLOC(Replay, 1);
+    replay->fp = fp;
+    replay->users = users;
+    replay->color = color;
+    replay->civ = civ;
+    replay->map_size = map_size;
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Bytes_PutVarint(&bytes, REPLAY_MAGIC);
+    Bytes_PutVarint(&bytes, REPLAY_VERSION);
+    Bytes_PutVarint(&bytes, (uint64_t) users);
+    Bytes_PutVarint(&bytes, (uint64_t) color);
+    Bytes_PutVarint(&bytes, (uint64_t) civ);
+    Bytes_PutVarint(&bytes, (uint64_t) map_size);
+    Write(replay, &bytes);
+    return replay;
+}
+
+// THE PEER TIMING IS ZEROED SO THAT IT COSTS A BYTE A FIELD.
+void Replay_Record(Replay* const replay, Packet packet)
+{
+    packet.setpoint = 0;
+    packet.echo = 0;
+    packet.hold = 0;
+    packet.users_connected = 0;
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Bytes_PutU8(&bytes, FRAME_TURN);
+    Packet_Encode(packet, &bytes);
+    Write(replay, &bytes);
+}
+
+// CLOSING ALSO FREES THE REPLAY.
+void Replay_Close(Replay* const replay, const int32_t cycles, const uint64_t parity)
+{
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Bytes_PutU8(&bytes, FRAME_END);
+    Bytes_PutVarint(&bytes, (uint64_t) cycles);
+    Bytes_PutVarint(&bytes, parity);
+    Write(replay, &bytes);
+    Replay_Free(replay);
+}
+
+Replay* Replay_Open(const char* const path)
+{
+    FILE* const fp = fopen(path, "rb");
+    if(fp == NULL)
+        Util_Bomb("REPLAY - COULD NOT OPEN %s\n", path);
+    Replay* const replay = UTIL_ALLOC(Replay, 1);
+    replay->fp = fp;
+    Bytes bytes;
+    if(!Read(replay, &bytes)
+    || Bytes_GetVarint(&bytes) != REPLAY_MAGIC
+    || Bytes_GetVarint(&bytes) != REPLAY_VERSION)
+        Util_Bomb("REPLAY - %s IS NOT A VERSION %d REPLAY\n", path, REPLAY_VERSION);
+    replay->users = (int32_t) Bytes_GetVarint(&bytes);
+    replay->color = (Color) Bytes_GetVarint(&bytes);
+    replay->civ = (Civ) Bytes_GetVarint(&bytes);
+    replay->map_size = (int32_t) Bytes_GetVarint(&bytes);
+    if(!Bytes_IsDone(&bytes)
+    || replay->users < 1
+    || replay->users > COLOR_COUNT)
+        Util_Bomb("REPLAY - %s HAS A BAD HEADER\n", path);
+    return replay;
+}
+
+// FALSE ONCE THE PACKETS RUN OUT. THE END FRAME, IF THERE IS ONE, FILLS IN THE LAST CYCLE AND PARITY.
+bool Replay_Next(Replay* const replay, Packet* const packet)
+{
+    Bytes bytes;
+    while(Read(replay, &bytes))
+    {
+        const uint8_t frame = Bytes_GetU8(&bytes);
+        if(frame == FRAME_TURN)
+        {
+            *packet = Packet_Decode(&bytes);
+            if(Bytes_IsDone(&bytes))
+                return true;
+        }
+        else if(frame == FRAME_END)
+        {
+            replay->cycles = (int32_t) Bytes_GetVarint(&bytes);
+            replay->parity = Bytes_GetVarint(&bytes);
+            replay->is_closed = Bytes_IsDone(&bytes);
+            return false;
+        }
+    }
+    return false;
+}
+
+// EVERY PACKET IS SERVICED AT ITS EXEC CYCLE, AND PLAY GOES ON TO THE LAST CYCLE RECORDED.
+Units Replay_Play(Replay* const replay, Units units, const Registrar graphics, const Grid grid, const Map map, const bool verbose)
+{
+    const double frequency = (double) SDL_GetPerformanceFrequency();
+    Packet packet;
+    bool has_packet = Replay_Next(replay, &packet);
+    while(has_packet || units.cycles < replay->cycles)
+    {
+        const uint64_t t0 = SDL_GetPerformanceCounter();
+        const Field field = Units_Field(units, map);
+        if(has_packet && packet.exec_cycle < units.cycles)
+            Util_Bomb("REPLAY - PACKET FOR CYCLE %d FOUND AT CYCLE %d\n", packet.exec_cycle, units.cycles);
+        while(has_packet && packet.exec_cycle == units.cycles)
+        {
+            units = Units_PacketService(units, graphics, packet, grid, map, field);
+            has_packet = Replay_Next(replay, &packet);
+        }
+        units = Units_Caretake(units, graphics, grid, map, field);
+        Field_Free(field);
+        const double ms = 1000.0 * (double) (SDL_GetPerformanceCounter() - t0) / frequency;
+        replay->played++;
+        replay->total_ms += ms;
+        replay->worst_ms = UTIL_MAX(replay->worst_ms, ms);
+        if(verbose)
+            printf("CYCLE %d :: %.3f MS :: UNITS %d :: 0x%016lX\n", units.cycles, ms, units.count, Units_Parity(units).root);
+    }
+    return units;
+}
+
+// A REPLAY THAT WAS NEVER CLOSED HAS NOTHING TO CHECK AGAINST.
+const char* Replay_Check(const Replay* const replay, const Units units)
+{
+    if(!replay->is_closed)
+        return "UNCHECKED";
+    return (replay->cycles == units.cycles && replay->parity == Units_Parity(units).root) ? "MATCHES" : "DIFFERS";
+}
+
+void Replay_Free(Replay* const replay)
+{
+    fclose(replay->fp);
+    free(replay);
+}
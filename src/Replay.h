@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Packet.h"
+#include "Units.h"
+#include "Color.h"
+#include "Civ.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// A RECORDING OF EVERY STABLE PACKET A CLIENT APPLIED, IN THE ORDER IT APPLIED THEM. THE TEST ZONE
+// IS BUILT FROM THE HEADER ALONE, AND THE SIMULATION DRAWS ALL ITS ENTROPY FROM UNIT IDS AND CYCLES,
+// SO THE HEADER AND THE PACKETS ARE ENOUGH TO RE-SIMULATE THE MATCH TICK FOR TICK.
+//
+// EACH FRAME IS PREFIXED WITH ITS SIZE AS TWO LITTLE ENDIAN BYTES, AS ON THE WIRE. PACKETS ARE STORED
+// WITH PACKET_ENCODE, MINUS THE TIMING FIELDS THE SIMULATION NEVER READS. A CLEANLY CLOSED REPLAY ENDS
+// WITH THE LAST CYCLE AND ITS PARITY SO THAT A PLAYBACK CAN CHECK IT ARRIVED AT THE SAME STATE.
+//
+// A PLAYBACK COUNTS THE CYCLES IT PLAYED AND TIMES THEM. UNIT IDS ARE HANDED OUT FROM A COUNTER THAT
+// IS PART OF THE SIMULATION STATE, SO THE UNITS PLAYED INTO MUST BE BUILT WITH IT AT ZERO, AS IT IS
+// IN A FRESH PROCESS.
+
+#define REPLAY_MAGIC (0x4F45524C)
+
+#define REPLAY_VERSION (5)
+
+typedef struct
+{
+    FILE* fp;
+    int32_t users;
+    Color color;
+    Civ civ;
+    int32_t map_size;
+    bool is_closed;
+    int32_t cycles;
+    uint64_t parity;
+    int32_t played;
+    double total_ms;
+    double worst_ms;
+}
+Replay;
+
+Replay* Replay_Create(const char* const path, const int32_t users, const Color, const Civ, const int32_t map_size);
+
+void Replay_Record(Replay* const, Packet);
+
+void Replay_Close(Replay* const, const int32_t cycles, const uint64_t parity);
+
+Replay* Replay_Open(const char* const path);
+
+bool Replay_Next(Replay* const, Packet* const);
+
+Units Replay_Play(Replay* const, Units, const Registrar graphics, const Grid, const Map, const bool verbose);
+
+const char* Replay_Check(const Replay* const, const Units);
+
+void Replay_Free(Replay* const);
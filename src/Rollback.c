@@ -0,0 +1,230 @@
+#include "Rollback.h"
+
+#include "Command.h"
+#include "Util.h"
+
+#include <stdio.h>
+
+Rollback* Rollback_Make(const Color color, Replay* const replay)
+{
+    Rollback* const rollback = UTIL_ALLOC(Rollback, 1);
+    rollback->color = color;
+    rollback->replay = replay;
+    for(int32_t i = 0; i < CONFIG_ROLLBACK_WINDOW; i++)
+    {
+        rollback->ring[i] = Snapshot_Make();
+        rollback->ring_cycles[i] = -1;
+    }
+    rollback->rewind = -1;
+    return rollback;
+}
+
+void Rollback_Free(Rollback* const rollback)
+{
+    for(int32_t i = 0; i < CONFIG_ROLLBACK_WINDOW; i++)
+        Snapshot_Free(rollback->ring[i]);
+    free(rollback->turn);
+    free(rollback->guess);
+    free(rollback);
+}
+
+static int32_t GetHorizon(const Rollback* const rollback)
+{
+    int32_t horizon = rollback->newest;
+    for(int32_t i = 0; i < rollback->guesses; i++)
+        horizon = UTIL_MIN(horizon, rollback->guess[i].exec_cycle);
+    return horizon;
+}
+
+int32_t Rollback_GetConfirmed(const Rollback* const rollback, const int32_t cycles)
+{
+    return UTIL_MIN(GetHorizon(rollback), cycles);
+}
+
+// THE UNITS AS THEY ARE, WITH NOTHING IN HAND, ARE CONFIRMED, AS AFTER REJOINING.
+void Rollback_Reset(Rollback* const rollback, const Units units)
+{
+    for(int32_t i = 0; i < CONFIG_ROLLBACK_WINDOW; i++)
+        rollback->ring_cycles[i] = -1;
+    rollback->turns = 0;
+    rollback->guesses = 0;
+    rollback->newest = units.cycles;
+    rollback->rewind = -1;
+    rollback->furthest = units.cycles;
+    Rollback_Save(rollback, units);
+}
+
+static void Rewind(Rollback* const rollback, const int32_t cycles)
+{
+    rollback->rewind = (rollback->rewind == -1) ? cycles : UTIL_MIN(rollback->rewind, cycles);
+}
+
+static bool HasAction(const Packet packet)
+{
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(Overview_UsedAction(packet.overview[i]))
+            return true;
+    return false;
+}
+
+static Packet* Append(Packet* packet, int32_t* const count, int32_t* const max, const Packet next)
+{
+    if(*count == *max)
+    {
+        *max = (*max == 0) ? 16 : 2 * *max;
+        packet = UTIL_REALLOC(packet, Packet, *max);
+    }
+    packet[(*count)++] = next;
+    return packet;
+}
+
+// EVERY RUNNING TURN MOVES THE NEWEST CYCLE UP, BUT ONLY A TURN CARRYING COMMANDS IS KEPT, AND ONLY
+// A LATE ONE REWINDS. A TURN BEFORE THE CONFIRMED CYCLE IS ALREADY IN THE UNITS, AS IN A BACKLOG AFTER
+// REJOINING. THE SERVER DEALS A CLIENT'S COMMANDS IN THE ORDER SENT, SO A TURN CARRYING ONE OF THIS
+// CLIENT'S COMMANDS, OR NAMING ONE DROPPED, SETTLES EVERY COMMAND SENT UP TO IT: THE COMMAND ITSELF IS
+// NOW IN THE TURNS, AND THOSE BEFORE IT WERE DEALT, MERGED INTO IT, OR DROPPED.
+void Rollback_Turn(Rollback* const rollback, const Packet packet, const int32_t cycles)
+{
+    rollback->newest = UTIL_MAX(rollback->newest, packet.exec_cycle);
+    if(Packet_IsStable(packet) && HasAction(packet) && packet.exec_cycle >= Rollback_GetConfirmed(rollback, cycles))
+    {
+        rollback->turn = Append(rollback->turn, &rollback->turns, &rollback->turns_max, packet);
+        if(packet.exec_cycle < cycles)
+            Rewind(rollback, packet.exec_cycle);
+    }
+    const Overview mine = packet.overview[rollback->color];
+    const int32_t settled = (Packet_IsStable(packet) && Overview_UsedAction(mine))
+        ? UTIL_MAX(mine.sequence, packet.dropped)
+        : packet.dropped;
+    int32_t kept = 0;
+    for(int32_t i = 0; i < rollback->guesses; i++)
+    {
+        const Packet guess = rollback->guess[i];
+        if(guess.overview[rollback->color].sequence <= settled)
+        {
+            if(guess.exec_cycle < cycles)
+                Rewind(rollback, guess.exec_cycle);
+        }
+        else
+            rollback->guess[kept++] = guess;
+    }
+    rollback->guesses = kept;
+}
+
+// THE OVERVIEW MUST CARRY THE SEQUENCE IT WAS SENT WITH.
+void Rollback_Guess(Rollback* const rollback, const Overview overview, const int32_t cycles)
+{
+    static Packet zero;
+    Packet guess = zero;
+    guess.overview[rollback->color] = Command_ToOverview(Command_FromOverview(overview));
+    guess.exec_cycle = cycles;
+    guess.is_stable = true;
+    rollback->guess = Append(rollback->guess, &rollback->guesses, &rollback->guesses_max, guess);
+}
+
+// TURNS BEFORE THE CONFIRMED CYCLE WILL NOT BE SIMULATED AGAIN.
+void Rollback_Retire(Rollback* const rollback, const int32_t cycles)
+{
+    const int32_t confirmed = Rollback_GetConfirmed(rollback, cycles);
+    int32_t kept = 0;
+    for(int32_t i = 0; i < rollback->turns; i++)
+    {
+        const Packet turn = rollback->turn[i];
+        if(turn.exec_cycle >= confirmed)
+            rollback->turn[kept++] = turn;
+        else if(rollback->replay)
+            Replay_Record(rollback->replay, turn);
+    }
+    rollback->turns = kept;
+}
+
+// CALLED AT THE START OF EVERY TICK.
+void Rollback_Save(Rollback* const rollback, const Units units)
+{
+    const int32_t slot = units.cycles % CONFIG_ROLLBACK_WINDOW;
+    rollback->ring[slot] = Units_Snapshot(units, rollback->ring[slot]);
+    rollback->ring_cycles[slot] = units.cycles;
+    Rollback_Retire(rollback, units.cycles);
+}
+
+// TURNS IN THE ORDER THEY ARRIVED, THEN GUESSES, AS THE SERVER RELAYS COMMANDS AFTER THE TURNS
+// ALREADY SENT.
+const Packet* Rollback_Next(const Rollback* const rollback, const int32_t cycles, int32_t* const index)
+{
+    while(*index < rollback->turns + rollback->guesses)
+    {
+        const int32_t i = (*index)++;
+        const Packet* const packet = (i < rollback->turns)
+            ? &rollback->turn[i]
+            : &rollback->guess[i - rollback->turns];
+        if(packet->exec_cycle == cycles)
+            return packet;
+    }
+    return NULL;
+}
+
+// REWINDS NEVER GO BEFORE THE CONFIRMED CYCLE, AND THE PRESENT NEVER GETS FURTHER AHEAD OF IT THAN
+// THE RING, SO THE CYCLE REWOUND TO IS ALWAYS IN THE RING.
+Units Rollback_Rewind(Rollback* const rollback, Units units)
+{
+    const int32_t cycles = rollback->rewind;
+    rollback->rewind = -1;
+    if(cycles == -1 || cycles >= units.cycles)
+        return units;
+    const int32_t slot = cycles % CONFIG_ROLLBACK_WINDOW;
+    if(rollback->ring_cycles[slot] != cycles)
+        Util_Bomb("ROLLBACK - CYCLE %d IS NO LONGER IN THE RING\n", cycles);
+    const int32_t depth = units.cycles - cycles;
+    rollback->furthest = UTIL_MAX(rollback->furthest, units.cycles);
+    rollback->rollbacks++;
+    rollback->depth += depth;
+    rollback->depth_max = UTIL_MAX(rollback->depth_max, depth);
+    return Units_Restore(units, rollback->ring[slot]);
+}
+
+// THE UNITS ARE SIMULATING CYCLES AGAIN UNTIL THEY PASS THE FURTHEST THEY HAD REACHED.
+bool Rollback_IsRedoing(const Rollback* const rollback, const Units units)
+{
+    return units.cycles < rollback->furthest;
+}
+
+// THE SIMULATION TIME OF A FRAME THAT SIMULATED CYCLES AGAIN.
+void Rollback_Count(Rollback* const rollback, const double ms)
+{
+    rollback->frames++;
+    rollback->resim_ms += ms;
+    rollback->resim_ms_max = UTIL_MAX(rollback->resim_ms_max, ms);
+}
+
+// A STALL IS A TICK OF THE PRESENT HELD BACK BECAUSE THE CONFIRMED CYCLE FELL A WHOLE RING BEHIND.
+// THE UNITS ARE NEVER AHEAD OF THE PRESENT, SO THEY TOO STAY WITHIN THE RING.
+bool Rollback_CanAdvance(Rollback* const rollback, const int32_t cycles)
+{
+    const bool can = cycles + 1 <= GetHorizon(rollback) + CONFIG_ROLLBACK_WINDOW;
+    if(!can)
+        rollback->stalls++;
+    return can;
+}
+
+// NULL ONCE THE RING HAS MOVED PAST THE CYCLE.
+const Snapshot* Rollback_GetSnapshot(const Rollback* const rollback, const int32_t cycles)
+{
+    const int32_t slot = cycles % CONFIG_ROLLBACK_WINDOW;
+    return (cycles >= 0 && rollback->ring_cycles[slot] == cycles) ? &rollback->ring[slot] : NULL;
+}
+
+void Rollback_Print(Rollback* const rollback)
+{
+    const int32_t count = UTIL_MAX(1, rollback->rollbacks);
+    const int32_t frames = UTIL_MAX(1, rollback->frames);
+    printf("ROLLBACK :: %d ROLLBACKS :: DEPTH %.1f MEAN %d MAX :: RESIM %.3f MS MEAN %.3f MS MAX A FRAME OVER %d FRAMES :: %d STALLS\n",
+        rollback->rollbacks, rollback->depth / (double) count, rollback->depth_max,
+        rollback->resim_ms / frames, rollback->resim_ms_max, rollback->frames, rollback->stalls);
+    rollback->rollbacks = 0;
+    rollback->depth = 0;
+    rollback->depth_max = 0;
+    rollback->frames = 0;
+    rollback->resim_ms = 0.0;
+    rollback->resim_ms_max = 0.0;
+    rollback->stalls = 0;
+}
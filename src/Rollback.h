@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Config.h"
+#include "Packet.h"
+#include "Replay.h"
+#include "Snapshot.h"
+#include "Units.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// LOCAL COMMANDS APPLIED AT ONCE, ON A PREDICTED TIMELINE. THE SERVER THEN EXECUTES EVERY TURN AS
+// SOON AS IT CAN, SO TURNS ARRIVE FOR CYCLES ALREADY SIMULATED. EVERY TICK IS SNAPSHOTTED INTO A RING,
+// AND A TURN FOR A CYCLE ALREADY SIMULATED REWINDS THE UNITS TO THAT CYCLE, TO BE SIMULATED AGAIN.
+//
+// A COMMAND IS GUESSED AT THE CYCLE IT WAS ISSUED UNTIL THE TURN CARRYING IT ARRIVES, WHEN THE GUESS
+// IS RETIRED, ALSO REWINDING. THE SERVER MAY MERGE A COMMAND INTO A LATER ONE, OR DROP IT, SO A GUESS
+// ALSO RETIRES ONCE A TURN CARRIES A LATER COMMAND OF THIS CLIENT OR NAMES IT OR A LATER ONE AS
+// DROPPED. A CYCLE IS CONFIRMED ONCE EVERY TURN BEFORE IT IS IN HAND AND NO GUESS IS LEFT BEFORE IT,
+// AND THE PRESENT NEVER RUNS MORE THAN THE RING AHEAD OF THE CONFIRMED CYCLE.
+//
+// GUESSES ARE KEPT AS PACKETS CARRYING ONLY THIS CLIENT'S OVERVIEW, WITH ITS SEQUENCE, EXECUTING AT
+// THE CYCLE ISSUED. TURNS ARE RECORDED, IF RECORDING, ONCE THEY ARE BEFORE THE CONFIRMED CYCLE, AS
+// ONLY THEN ARE THEY NEVER SIMULATED AGAIN.
+//
+// THE UNITS MAY BE BEHIND THE PRESENT, AS A REWIND IS CAUGHT UP ON A FEW TICKS A FRAME. EVERY CYCLE
+// PASSED IN IS THEREFORE THE UNITS' CYCLE, EXCEPT WHEN ASKING WHETHER THE PRESENT CAN ADVANCE.
+
+typedef struct
+{
+    Snapshot ring[CONFIG_ROLLBACK_WINDOW];
+    int32_t ring_cycles[CONFIG_ROLLBACK_WINDOW];
+    Packet* turn;
+    int32_t turns;
+    int32_t turns_max;
+    Packet* guess;
+    int32_t guesses;
+    int32_t guesses_max;
+    Color color;
+    Replay* replay;
+    int32_t newest;
+    int32_t rewind;
+    int32_t furthest;
+    int32_t rollbacks;
+    int32_t depth;
+    int32_t depth_max;
+    int32_t stalls;
+    int32_t frames;
+    double resim_ms;
+    double resim_ms_max;
+}
+Rollback;
+
+Rollback* Rollback_Make(const Color, Replay* const);
+
+void Rollback_Free(Rollback* const);
+
+void Rollback_Reset(Rollback* const, const Units);
+
+void Rollback_Turn(Rollback* const, const Packet, const int32_t cycles);
+
+void Rollback_Guess(Rollback* const, const Overview, const int32_t cycles);
+
+void Rollback_Save(Rollback* const, const Units);
+
+void Rollback_Retire(Rollback* const, const int32_t cycles);
+
+const Packet* Rollback_Next(const Rollback* const, const int32_t cycles, int32_t* const index);
+
+Units Rollback_Rewind(Rollback* const, Units);
+
+bool Rollback_IsRedoing(const Rollback* const, const Units);
+
+void Rollback_Count(Rollback* const, const double ms);
+
+int32_t Rollback_GetConfirmed(const Rollback* const, const int32_t cycles);
+
+bool Rollback_CanAdvance(Rollback* const, const int32_t cycles);
+
+const Snapshot* Rollback_GetSnapshot(const Rollback* const, const int32_t cycles);
+
+void Rollback_Print(Rollback* const);
@@ -0,0 +1,77 @@
+#include "Rtt.h"
+
+#include "Util.h"
+
+#define SCALE (8)
+
+Rtt* Rtt_Make(void)
+{
+    return UTIL_ALLOC(Rtt, 1);
+}
+
+void Rtt_Free(Rtt* const rtt)
+{
+    free(rtt);
+}
+
+// ONLY ONE THREAD SAMPLES, SO THE READ AND WRITE OF EACH FIELD NEED NOT BE ONE ATOMIC STEP.
+void Rtt_Sample(Rtt* const rtt, const int32_t ms)
+{
+    const int32_t sample = SCALE * UTIL_MAX(0, ms);
+    const int32_t samples = SDL_AtomicGet(&rtt->samples);
+    if(samples == 0)
+    {
+        SDL_AtomicSet(&rtt->smooth, sample);
+        SDL_AtomicSet(&rtt->jitter, sample / 2);
+        SDL_AtomicSet(&rtt->low, sample);
+        SDL_AtomicSet(&rtt->high, sample);
+    }
+    else
+    {
+        const int32_t smooth = SDL_AtomicGet(&rtt->smooth);
+        const int32_t jitter = SDL_AtomicGet(&rtt->jitter);
+        const int32_t error = sample - smooth;
+        SDL_AtomicSet(&rtt->smooth, smooth + error / 8);
+        SDL_AtomicSet(&rtt->jitter, jitter + (abs(error) - jitter) / 4);
+        SDL_AtomicSet(&rtt->low, UTIL_MIN(SDL_AtomicGet(&rtt->low), sample));
+        SDL_AtomicSet(&rtt->high, UTIL_MAX(SDL_AtomicGet(&rtt->high), sample));
+    }
+    SDL_AtomicSet(&rtt->last, sample);
+    SDL_AtomicSet(&rtt->samples, samples + 1);
+}
+
+// A NEGATIVE ONE UNTIL THE FIRST SAMPLE ARRIVES.
+int32_t Rtt_GetSmooth(Rtt* const rtt)
+{
+    return SDL_AtomicGet(&rtt->samples) > 0
+        ? SDL_AtomicGet(&rtt->smooth) / SCALE
+        : -1;
+}
+
+int32_t Rtt_GetJitter(Rtt* const rtt)
+{
+    return SDL_AtomicGet(&rtt->jitter) / SCALE;
+}
+
+// A NEGATIVE ONE UNTIL THE FIRST SAMPLE ARRIVES.
+int32_t Rtt_GetLast(Rtt* const rtt)
+{
+    return SDL_AtomicGet(&rtt->samples) > 0
+        ? SDL_AtomicGet(&rtt->last) / SCALE
+        : -1;
+}
+
+int32_t Rtt_GetLow(Rtt* const rtt)
+{
+    return SDL_AtomicGet(&rtt->low) / SCALE;
+}
+
+int32_t Rtt_GetHigh(Rtt* const rtt)
+{
+    return SDL_AtomicGet(&rtt->high) / SCALE;
+}
+
+int32_t Rtt_GetSamples(Rtt* const rtt)
+{
+    return SDL_AtomicGet(&rtt->samples);
+}
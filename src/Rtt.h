@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL2/SDL_atomic.h>
+
+#include <stdint.h>
+
+// ROUND TRIP TIME MEASURED FROM THE TURNS THEMSELVES. EVERY UPLINK IS STAMPED WITH THE CLIENT'S CLOCK
+// AND EVERY TURN ECHOES THE NEWEST STAMP BACK ALONG WITH HOW LONG THE SERVER HELD IT, SO THE SERVER'S
+// TURN INTERVAL DOES NOT COUNT. WHAT REMAINS INCLUDES THE UP TO ONE FRAME A TURN WAITS TO BE READ,
+// WHICH THE GAME LOOP SEES AS LATENCY ALL THE SAME.
+//
+// SMOOTHED LIKE TCP: THE AVERAGE MOVES AN EIGHTH AND THE JITTER (MEAN DEVIATION) A QUARTER OF THE WAY
+// TOWARDS EACH SAMPLE. BOTH ARE KEPT IN EIGHTHS OF A MILLISECOND AND PUBLISHED THROUGH ATOMICS, SO ANY
+// THREAD CAN READ THEM WHILE THE NETWORK THREAD SAMPLES.
+
+typedef struct
+{
+    SDL_atomic_t smooth;
+    SDL_atomic_t jitter;
+    SDL_atomic_t last;
+    SDL_atomic_t low;
+    SDL_atomic_t high;
+    SDL_atomic_t samples;
+}
+Rtt;
+
+Rtt* Rtt_Make(void);
+
+void Rtt_Free(Rtt* const);
+
+void Rtt_Sample(Rtt* const, const int32_t ms);
+
+int32_t Rtt_GetSmooth(Rtt* const);
+
+int32_t Rtt_GetJitter(Rtt* const);
+
+int32_t Rtt_GetLast(Rtt* const);
+
+int32_t Rtt_GetLow(Rtt* const);
+
+int32_t Rtt_GetHigh(Rtt* const);
+
+int32_t Rtt_GetSamples(Rtt* const);
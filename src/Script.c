@@ -0,0 +1,53 @@
+#include "Script.h"
+
+#include "Config.h"
+#include "Util.h"
+
+#define SECOND (1000 / CONFIG_MAIN_LOOP_SPEED_MS)
+
+static const char* strings[] = {
+    "idle", "steady", "burst", "flood", "silent", "mixed",
+};
+
+Script Script_Parse(const char* const name)
+{
+    for(int32_t i = 0; i < SCRIPT_COUNT; i++)
+        if(Util_StringEqual(name, strings[i]))
+            return (Script) i;
+    Util_Bomb("SWARM - UNKNOWN SCRIPT %s\n", name);
+    return SCRIPT_IDLE;
+}
+
+Script Script_ForBot(const Script script, const int32_t bot)
+{
+    return (script == SCRIPT_MIXED) ? (Script) (bot % SCRIPT_MIXED) : script;
+}
+
+const char* Script_ToString(const Script script)
+{
+    return strings[script];
+}
+
+bool Script_Commands(const Script script, const int32_t frame)
+{
+    switch(script)
+    {
+    case SCRIPT_STEADY:
+    case SCRIPT_SILENT:
+        return frame % SECOND == 0;
+    case SCRIPT_BURST:
+        return frame % (5 * SECOND) < 20 && frame % 2 == 0;
+    case SCRIPT_FLOOD:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool Script_Beats(const Script script, const int32_t frame)
+{
+    const bool is_due = frame % (CONFIG_SOCKETS_HEARTBEAT_MS / CONFIG_MAIN_LOOP_SPEED_MS) == 0;
+    return (script == SCRIPT_SILENT)
+        ? is_due && frame % (8 * SECOND) >= 2 * SECOND
+        : is_due;
+}
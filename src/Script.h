@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// WHAT A SWARM BOT DOES EACH FRAME, AS A PURE FUNCTION OF THE FRAME. IDLE ONLY KEEPS ITS HEARTBEAT.
+// STEADY ISSUES A COMMAND A SECOND, LIKE A CALM PLAYER. BURST CLICKS TEN TIMES IN QUICK SUCCESSION
+// EVERY FIVE SECONDS, LIKE A FIGHT. FLOOD ISSUES A COMMAND EVERY FRAME. SILENT PLAYS STEADY BUT STOPS
+// SENDING HEARTBEATS FOR TWO SECONDS IN EVERY EIGHT, AS A CLIENT BEHIND A STALLED LINK DOES. MIXED
+// HANDS THE OTHER SCRIPTS OUT TO THE BOTS IN TURN.
+
+typedef enum
+{
+    SCRIPT_IDLE,
+    SCRIPT_STEADY,
+    SCRIPT_BURST,
+    SCRIPT_FLOOD,
+    SCRIPT_SILENT,
+    SCRIPT_MIXED,
+    SCRIPT_COUNT
+}
+Script;
+
+Script Script_Parse(const char* const);
+
+Script Script_ForBot(const Script, const int32_t bot);
+
+const char* Script_ToString(const Script);
+
+bool Script_Commands(const Script, const int32_t frame);
+
+bool Script_Beats(const Script, const int32_t frame);
@@ -0,0 +1,136 @@
+#include "Selection.h"
+
+#include "Util.h"
+
+// HISTOGRAMS ARE OFFSET BY ONE SO THAT ACTION_NONE AND TYPE_NONE HAVE A SLOT.
+#define ACTION_SLOTS (ACTION_COUNT + 1)
+#define TYPE_SLOTS (TYPE_COUNT + 1)
+
+Selection Selection_Make(const int32_t max, const Color color)
+{
+    static Selection zero;
+    Selection selection = zero;
+    selection.unit = UTIL_ALLOC(Unit*, max);
+    selection.action = UTIL_ALLOC(Action, max);
+    selection.type = UTIL_ALLOC(Type, max);
+    selection.action_count = UTIL_ALLOC(int32_t, ACTION_SLOTS);
+    selection.type_count = UTIL_ALLOC(int32_t, TYPE_SLOTS);
+    selection.max = max;
+    selection.color = color;
+    return selection;
+}
+
+void Selection_Free(const Selection selection)
+{
+    free(selection.unit);
+    free(selection.action);
+    free(selection.type);
+    free(selection.action_count);
+    free(selection.type_count);
+}
+
+static bool IsCounted(const Selection selection, Unit* const unit)
+{
+    return unit->color == selection.color;
+}
+
+// THE ACTION AND TYPE ARE RECORDED ON ENTRY. UPGRADES REPLACE THE TRAIT IN PLACE, SO THE
+// HISTOGRAM MUST BE DECREMENTED WITH WHAT WAS COUNTED, NOT WITH WHAT THE UNIT IS NOW.
+static Selection Count(Selection selection, const int32_t index, const int32_t delta)
+{
+    if(IsCounted(selection, selection.unit[index]))
+    {
+        selection.action_count[(int32_t) selection.action[index] + 1] += delta;
+        selection.type_count[(int32_t) selection.type[index] + 1] += delta;
+    }
+    return selection;
+}
+
+Selection Selection_Add(Selection selection, Unit* const unit)
+{
+    if(Unit_IsExempt(unit) || unit->is_selected)
+        return selection;
+    if(selection.count == selection.max)
+    {
+        selection.max *= 2;
+        selection.unit = UTIL_REALLOC(selection.unit, Unit*, selection.max);
+        selection.action = UTIL_REALLOC(selection.action, Action, selection.max);
+        selection.type = UTIL_REALLOC(selection.type, Type, selection.max);
+    }
+    const int32_t index = selection.count++;
+    unit->is_selected = true;
+    selection.unit[index] = unit;
+    selection.action[index] = unit->trait.action;
+    selection.type[index] = unit->trait.type;
+    return Count(selection, index, +1);
+}
+
+static Selection Reset(Selection selection)
+{
+    for(int32_t i = 0; i < ACTION_SLOTS; i++) selection.action_count[i] = 0;
+    for(int32_t i = 0; i < TYPE_SLOTS; i++) selection.type_count[i] = 0;
+    selection.count = 0;
+    return selection;
+}
+
+Selection Selection_Clear(Selection selection)
+{
+    for(int32_t i = 0; i < selection.count; i++)
+        selection.unit[i]->is_selected = false;
+    return Reset(selection);
+}
+
+// DEATH, DECAY, AND UPGRADES CLEAR THE SELECTED FLAG OF A UNIT. THOSE UNITS ARE SWAP REMOVED.
+Selection Selection_Prune(Selection selection)
+{
+    for(int32_t i = 0; i < selection.count; i++)
+    {
+        Unit* const unit = selection.unit[i];
+        if(!unit->is_selected || Unit_IsExempt(unit))
+        {
+            unit->is_selected = false;
+            selection = Count(selection, i, -1);
+            const int32_t last = --selection.count;
+            selection.unit[i] = selection.unit[last];
+            selection.action[i] = selection.action[last];
+            selection.type[i] = selection.type[last];
+            i--;
+        }
+    }
+    return selection;
+}
+
+Selection Selection_Rebuild(Selection selection, Unit* const unit, const int32_t count)
+{
+    selection = Reset(selection);
+    for(int32_t i = 0; i < count; i++)
+        if(unit[i].is_selected)
+        {
+            unit[i].is_selected = false;
+            selection = Selection_Add(selection, &unit[i]);
+        }
+    return selection;
+}
+
+static int32_t MaxIndex(const int32_t array[], const int32_t size)
+{
+    int32_t max = 0;
+    int32_t index = 0;
+    for(int32_t i = 0; i < size; i++)
+        if(array[i] > max)
+        {
+            max = array[i];
+            index = i;
+        }
+    return index;
+}
+
+Action Selection_GetAction(const Selection selection)
+{
+    return (Action) (MaxIndex(selection.action_count, ACTION_SLOTS) - 1);
+}
+
+Type Selection_GetType(const Selection selection)
+{
+    return (Type) (MaxIndex(selection.type_count, TYPE_SLOTS) - 1);
+}
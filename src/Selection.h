@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Unit.h"
+#include "Action.h"
+#include "Type.h"
+#include "Color.h"
+
+#include <stdint.h>
+
+// THE SET OF SELECTED UNITS. HANDLES POINT INTO THE LINEAR UNIT ARRAY AND STAY VALID
+// UNTIL GARBAGE COLLECTION MOVES UNITS, AFTER WHICH THE SET IS REBUILT.
+// ACTION AND TYPE HISTOGRAMS OF SELECTED UNITS OF THE OWNING COLOR ARE KEPT AS UNITS
+// COME AND GO, SO THE MOTIVE COSTS O(SELECTION) RATHER THAN O(WORLD).
+
+typedef struct
+{
+    Unit** unit;
+    Action* action;
+    Type* type;
+    int32_t* action_count;
+    int32_t* type_count;
+    int32_t count;
+    int32_t max;
+    Color color;
+}
+Selection;
+
+Selection Selection_Make(const int32_t max, const Color);
+
+void Selection_Free(const Selection);
+
+Selection Selection_Add(Selection, Unit* const);
+
+Selection Selection_Clear(Selection);
+
+Selection Selection_Prune(Selection);
+
+Selection Selection_Rebuild(Selection, Unit* const unit, const int32_t count);
+
+Action Selection_GetAction(const Selection);
+
+Type Selection_GetType(const Selection);
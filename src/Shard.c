@@ -0,0 +1,182 @@
+#include "Shard.h"
+
+#include "Config.h"
+#include "Util.h"
+
+#include <SDL2/SDL_timer.h>
+
+#define SLOTS (SOCKETS_TAGS)
+
+static int32_t FindGame(Shard* const shard, const int32_t id)
+{
+    for(int32_t i = 0; i < shard->max; i++)
+        if(shard->id[i] == id)
+            return i;
+    return -1;
+}
+
+static void Open(Shard* const shard, const int32_t index, const Match match)
+{
+    shard->id[index] = match.id;
+    shard->is_running[index] = false;
+    shard->game[index] = Sockets_Watch(Sockets_Make(match.id, match.users), shard->poll, index * SLOTS);
+}
+
+static void Close(Shard* const shard, const int32_t index)
+{
+    Sockets_Free(shard->game[index]);
+    shard->id[index] = 0;
+}
+
+// THE REGISTRY ALREADY COUNTED THE SEAT, SO A CLIENT THAT CANNOT BE SEATED GIVES IT BACK.
+static void Seat(Shard* const shard, Wire* const wire, const Match match)
+{
+    int32_t index = FindGame(shard, match.id);
+    if(index == -1)
+    {
+        index = FindGame(shard, 0);
+        if(index == -1)
+        {
+            TCPsocket socket = wire->socket;
+            Wire_Free(wire);
+            SDLNet_TCP_Close(socket);
+            Matches_Leave(shard->matches, match.id);
+            return;
+        }
+        Open(shard, index, match);
+    }
+    const int32_t before = Sockets_Connected(shard->game[index]);
+    shard->game[index] = Sockets_Adopt(shard->game[index], wire);
+    if(Sockets_Connected(shard->game[index]) == before)
+        Matches_Leave(shard->matches, match.id);
+}
+
+static void Collect(Shard* const shard)
+{
+    SDL_LockMutex(shard->mutex);
+    for(int32_t i = 0; i < shard->inbox_count; i++)
+        Seat(shard, shard->inbox[i], shard->inbox_match[i]);
+    shard->inbox_count = 0;
+    SDL_UnlockMutex(shard->mutex);
+}
+
+static void Leave(Shard* const shard, const int32_t index, const int32_t count)
+{
+    for(int32_t i = 0; i < count; i++)
+        Matches_Leave(shard->matches, shard->id[index]);
+    if(Sockets_Connected(shard->game[index]) == 0)
+        Close(shard, index);
+}
+
+static void Read(Shard* const shard, const int32_t index, const int32_t slot)
+{
+    if(shard->id[index] != 0)
+    {
+        const int32_t before = Sockets_Connected(shard->game[index]);
+        shard->game[index] = Sockets_Read(shard->game[index], slot);
+        const int32_t after = Sockets_Connected(shard->game[index]);
+        if(after < before)
+            Leave(shard, index, before - after);
+    }
+}
+
+// A MATCH THAT FALLS OUT OF SYNC IS ENDED ON ITS OWN. THE OTHER MATCHES PLAY ON.
+static void Relay(Shard* const shard)
+{
+    for(int32_t i = 0; i < shard->max; i++)
+        if(shard->id[i] != 0)
+        {
+            Sockets game = Sockets_Relay(shard->game[i], true);
+            shard->game[i] = game;
+            if(game.is_out_of_sync)
+            {
+                const int32_t connected = Sockets_Connected(game);
+                for(int32_t j = 0; j < connected; j++)
+                    Matches_Leave(shard->matches, shard->id[i]);
+                Close(shard, i);
+            }
+            else if(game.users_connected == game.users && !shard->is_running[i])
+            {
+                Matches_Start(shard->matches, shard->id[i]);
+                shard->is_running[i] = true;
+            }
+        }
+}
+
+static int32_t Run(void* const data)
+{
+    Shard* const shard = (Shard*) data;
+    while(!SDL_AtomicGet(&shard->done))
+    {
+        int32_t tags[POLL_EVENTS_MAX];
+        const int32_t count = Poll_Wait(shard->poll, tags);
+        const uint64_t t0 = SDL_GetPerformanceCounter();
+        bool woken = false;
+        for(int32_t i = 0; i < count; i++)
+        {
+            const int32_t tag = tags[i];
+            if(tag == POLL_TIMER)
+                Relay(shard);
+            else if(tag == POLL_WAKE)
+                woken = true;
+            else
+                Read(shard, tag / SLOTS, tag % SLOTS);
+        }
+        // NEW CLIENTS ARE SEATED LAST SO THAT NO TAG LEFT IN THIS WAKEUP CAN NAME THEIR SLOTS.
+        if(woken)
+            Collect(shard);
+        const uint64_t t1 = SDL_GetPerformanceCounter();
+        SDL_AtomicAdd(&shard->busy, (int) ((t1 - t0) * 1000000 / SDL_GetPerformanceFrequency()));
+    }
+    return 0;
+}
+
+Shard* Shard_Start(Matches* const matches, const int32_t max)
+{
+    Shard* const shard = UTIL_ALLOC(Shard, 1);
+    shard->poll = Poll_Make(CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS);
+    shard->matches = matches;
+    shard->max = max;
+    shard->game = UTIL_ALLOC(Sockets, max);
+    shard->id = UTIL_ALLOC(int32_t, max);
+    shard->is_running = UTIL_ALLOC(bool, max);
+    shard->mutex = SDL_CreateMutex();
+    shard->thread = SDL_CreateThread(Run, "N/A", shard);
+    return shard;
+}
+
+void Shard_Stop(Shard* const shard)
+{
+    SDL_AtomicSet(&shard->done, true);
+    Poll_Wake(shard->poll);
+    SDL_WaitThread(shard->thread, NULL);
+    Collect(shard);
+    for(int32_t i = 0; i < shard->max; i++)
+        if(shard->id[i] != 0)
+            Close(shard, i);
+    Poll_Free(shard->poll);
+    SDL_DestroyMutex(shard->mutex);
+    free(shard->game);
+    free(shard->id);
+    free(shard->is_running);
+    free(shard->inbox);
+    free(shard->inbox_match);
+    free(shard);
+}
+
+// CALLED FROM THE ACCEPTING THREAD. THE SHARD OWNS THE WIRE FROM HERE ON.
+void Shard_Hand(Shard* const shard, Wire* const wire, const Match match)
+{
+    SDL_LockMutex(shard->mutex);
+    if(shard->inbox_count == shard->inbox_max)
+    {
+        shard->inbox_max = (shard->inbox_max == 0) ? 8 : 2 * shard->inbox_max;
+        shard->inbox = UTIL_REALLOC(shard->inbox, Wire*, shard->inbox_max);
+        shard->inbox_match = UTIL_REALLOC(shard->inbox_match, Match, shard->inbox_max);
+    }
+    shard->inbox[shard->inbox_count] = wire;
+    shard->inbox_match[shard->inbox_count] = match;
+    shard->inbox_count++;
+    SDL_UnlockMutex(shard->mutex);
+    Poll_Wake(shard->poll);
+}
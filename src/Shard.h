@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Sockets.h"
+#include "Matches.h"
+#include "Poll.h"
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_atomic.h>
+
+// A WORKER THREAD RUNNING MANY MATCHES. EVERY MATCH IS ITS OWN SOCKETS TABLE WITH ITS OWN LOBBY,
+// TURN RELAY, AND PARITY CHECK. ALL OF THEM ARE SERVED FROM ONE EPOLL, AND ONE TIMER RELAYS A TURN
+// FOR EVERY MATCH AT ONCE. CLIENTS ARRIVE FROM THE ACCEPTING THREAD THROUGH THE INBOX. BUSY COUNTS
+// THE MICROSECONDS SPENT AWAKE AND WRAPS, SO ONLY THE DIFFERENCE OF TWO READINGS IS MEANINGFUL.
+
+typedef struct
+{
+    Poll poll;
+    Matches* matches;
+    Sockets* game;
+    int32_t* id;
+    bool* is_running;
+    int32_t max;
+    Wire** inbox;
+    Match* inbox_match;
+    int32_t inbox_count;
+    int32_t inbox_max;
+    SDL_mutex* mutex;
+    SDL_Thread* thread;
+    SDL_atomic_t done;
+    SDL_atomic_t busy;
+}
+Shard;
+
+Shard* Shard_Start(Matches* const, const int32_t max);
+
+void Shard_Stop(Shard* const);
+
+void Shard_Hand(Shard* const, Wire* const, const Match);
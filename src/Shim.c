@@ -0,0 +1,330 @@
+#include "Shim.h"
+
+#include "Poll.h"
+#include "Util.h"
+
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_mutex.h>
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_timer.h>
+
+#include <string.h>
+
+typedef struct
+{
+    uint32_t due;
+    void* socket;
+    bool is_udp;
+    IPaddress address;
+    uint8_t* data;
+    int32_t size;
+}
+Parcel;
+
+typedef struct
+{
+    void* socket;
+    IPaddress address;
+    uint32_t busy;
+    uint32_t carry;
+}
+Lane;
+
+typedef struct
+{
+    Impair impair;
+    Parcel* parcel;
+    int32_t count;
+    int32_t max;
+    Lane* lane;
+    int32_t lanes;
+    int32_t lanes_max;
+    void** failed;
+    int32_t failures;
+    int32_t failures_max;
+    SDL_mutex* mutex;
+    SDL_mutex* sending;
+    SDL_Thread* thread;
+    SDL_atomic_t is_running;
+}
+Shim;
+
+static Shim shim;
+
+static bool IsLater(const uint32_t a, const uint32_t b)
+{
+    return (int32_t) (a - b) > 0;
+}
+
+static bool Roll(const int32_t permille)
+{
+    return permille > 0 && Util_RandNext(&shim.impair.seed) % 1000 < (uint32_t) permille;
+}
+
+static uint32_t GetDelay(void)
+{
+    const int32_t jitter = shim.impair.jitter_ms;
+    const int32_t noise = jitter > 0 ? (int32_t) (Util_RandNext(&shim.impair.seed) % (2 * jitter + 1)) - jitter : 0;
+    return (uint32_t) UTIL_MAX(0, shim.impair.delay_ms + noise);
+}
+
+static Lane* GetLane(void* const socket, const IPaddress address)
+{
+    for(int32_t i = 0; i < shim.lanes; i++)
+    {
+        Lane* const lane = &shim.lane[i];
+        if(lane->socket == socket && lane->address.host == address.host && lane->address.port == address.port)
+            return lane;
+    }
+    if(shim.lanes == shim.lanes_max)
+    {
+        shim.lanes_max = UTIL_MAX(8, 2 * shim.lanes_max);
+        shim.lane = UTIL_REALLOC(shim.lane, Lane, shim.lanes_max);
+    }
+    static Lane zero;
+    Lane* const lane = &shim.lane[shim.lanes++];
+    *lane = zero;
+    lane->socket = socket;
+    lane->address = address;
+    return lane;
+}
+
+// THE TIME THE LAST BIT LEAVES THE CAPPED PIPE OF ITS LANE. ONE KILOBIT PER SECOND IS ONE BIT PER
+// MILLISECOND, AND THE LEFTOVER BITS CARRY OVER TO THE NEXT SEND.
+static uint32_t Serialize(void* const socket, const IPaddress address, const int32_t size)
+{
+    const uint32_t now = SDL_GetTicks();
+    const uint32_t rate = (uint32_t) shim.impair.rate_kbps;
+    if(rate == 0)
+        return now;
+    Lane* const lane = GetLane(socket, address);
+    const uint32_t start = IsLater(lane->busy, now) ? lane->busy : now;
+    const uint32_t bits = 8 * (uint32_t) size + lane->carry;
+    lane->busy = start + bits / rate;
+    lane->carry = bits % rate;
+    return lane->busy;
+}
+
+// KEPT IN ORDER OF DUE TIME. TIES KEEP THE ORDER THEY WERE SENT IN.
+static void Enqueue(void* const socket, const bool is_udp, const IPaddress address, const void* const data, const int32_t size, const uint32_t due)
+{
+    if(shim.count == shim.max)
+    {
+        shim.max = UTIL_MAX(64, 2 * shim.max);
+        shim.parcel = UTIL_REALLOC(shim.parcel, Parcel, shim.max);
+    }
+    int32_t i = shim.count++;
+    for(; i > 0 && IsLater(shim.parcel[i - 1].due, due); i--)
+        shim.parcel[i] = shim.parcel[i - 1];
+    static Parcel zero;
+    Parcel parcel = zero;
+    parcel.due = due;
+    parcel.socket = socket;
+    parcel.is_udp = is_udp;
+    parcel.address = address;
+    parcel.data = UTIL_ALLOC(uint8_t, size);
+    parcel.size = size;
+    memcpy(parcel.data, data, (size_t) size);
+    shim.parcel[i] = parcel;
+}
+
+static bool IsFailed(void* const socket)
+{
+    for(int32_t i = 0; i < shim.failures; i++)
+        if(shim.failed[i] == socket)
+            return true;
+    return false;
+}
+
+static void Purge(void* const socket)
+{
+    int32_t kept = 0;
+    for(int32_t i = 0; i < shim.count; i++)
+        if(shim.parcel[i].socket == socket)
+            free(shim.parcel[i].data);
+        else shim.parcel[kept++] = shim.parcel[i];
+    shim.count = kept;
+}
+
+// WHAT IS STILL QUEUED FOR THE SOCKET CAN NEVER FOLLOW THE BYTES THAT FAILED.
+static void Fail(void* const socket)
+{
+    SDL_LockMutex(shim.mutex);
+    if(shim.failures == shim.failures_max)
+    {
+        shim.failures_max = UTIL_MAX(8, 2 * shim.failures_max);
+        shim.failed = UTIL_REALLOC(shim.failed, void*, shim.failures_max);
+    }
+    shim.failed[shim.failures++] = socket;
+    Purge(socket);
+    SDL_UnlockMutex(shim.mutex);
+}
+
+static bool Deliver(const Parcel parcel)
+{
+    if(parcel.is_udp)
+    {
+        static UDPpacket zero;
+        UDPpacket packet = zero;
+        packet.channel = -1;
+        packet.data = parcel.data;
+        packet.len = parcel.size;
+        packet.maxlen = parcel.size;
+        packet.address = parcel.address;
+        SDLNet_UDP_Send((UDPsocket) parcel.socket, -1, &packet);
+        return true;
+    }
+    return SDLNet_TCP_Send((TCPsocket) parcel.socket, parcel.data, parcel.size) == parcel.size;
+}
+
+// DUE PARCELS ARE TAKEN UNDER THE LOCK BUT LET OUT AFTER IT, SO A SEND THAT BLOCKS NEVER HOLDS UP
+// THE SENDERS QUEUING MORE. A SOCKET IS ONLY FORGOTTEN BETWEEN TWO BATCHES.
+static int32_t Pump(void* const data)
+{
+    (void) data;
+    Parcel* batch = NULL;
+    int32_t max = 0;
+    while(SDL_AtomicGet(&shim.is_running))
+    {
+        SDL_LockMutex(shim.sending);
+        SDL_LockMutex(shim.mutex);
+        const uint32_t now = SDL_GetTicks();
+        int32_t due = 0;
+        while(due < shim.count && !IsLater(shim.parcel[due].due, now))
+            due++;
+        if(due > max)
+        {
+            max = due;
+            batch = UTIL_REALLOC(batch, Parcel, max);
+        }
+        memcpy(batch, shim.parcel, sizeof(*batch) * (size_t) due);
+        shim.count -= due;
+        memmove(shim.parcel, &shim.parcel[due], sizeof(*shim.parcel) * (size_t) shim.count);
+        SDL_UnlockMutex(shim.mutex);
+        for(int32_t i = 0; i < due; i++)
+        {
+            if(!IsFailed(batch[i].socket) && !Deliver(batch[i]))
+                Fail(batch[i].socket);
+            free(batch[i].data);
+        }
+        SDL_UnlockMutex(shim.sending);
+        SDL_Delay(1);
+    }
+    free(batch);
+    return 0;
+}
+
+void Shim_Start(const Impair impair)
+{
+    if(!Impair_IsActive(impair))
+        return;
+    shim.impair = impair;
+    shim.mutex = SDL_CreateMutex();
+    shim.sending = SDL_CreateMutex();
+    SDL_AtomicSet(&shim.is_running, true);
+    shim.thread = SDL_CreateThread(Pump, "N/A", NULL);
+}
+
+// WHATEVER IS STILL QUEUED IS LOST, AS IF THE CABLE WAS PULLED.
+void Shim_Stop(void)
+{
+    if(!SDL_AtomicGet(&shim.is_running))
+        return;
+    SDL_AtomicSet(&shim.is_running, false);
+    SDL_WaitThread(shim.thread, NULL);
+    for(int32_t i = 0; i < shim.count; i++)
+        free(shim.parcel[i].data);
+    free(shim.parcel);
+    free(shim.lane);
+    free(shim.failed);
+    SDL_DestroyMutex(shim.mutex);
+    SDL_DestroyMutex(shim.sending);
+    static Shim zero;
+    shim = zero;
+}
+
+// CALLED WITH THE LOCK HELD. MINUS ONE ONCE THE SOCKET FAILED, AND ZERO WHILE THE QUEUE IS FULL.
+static int32_t Queue(TCPsocket socket, const void* const data, const int32_t size)
+{
+    if(IsFailed(socket))
+        return -1;
+    if(shim.count >= SHIM_QUEUE_MAX)
+        return 0;
+    static IPaddress none;
+    uint32_t due = Serialize(socket, none, size) + GetDelay();
+    if(Roll(shim.impair.loss))
+        due += SHIM_TCP_RTO_MS;
+    for(int32_t i = 0; i < shim.count; i++)
+        if(shim.parcel[i].socket == socket && IsLater(shim.parcel[i].due, due))
+            due = shim.parcel[i].due;
+    Enqueue(socket, false, none, data, size, due);
+    return size;
+}
+
+int32_t Shim_SendTcp(TCPsocket socket, const void* const data, const int32_t size)
+{
+    if(!SDL_AtomicGet(&shim.is_running))
+        return SDLNet_TCP_Send(socket, data, size);
+    SDL_LockMutex(shim.mutex);
+    int32_t queued = Queue(socket, data, size);
+    while(queued == 0 && size > 0)
+    {
+        SDL_UnlockMutex(shim.mutex);
+        SDL_Delay(1);
+        SDL_LockMutex(shim.mutex);
+        queued = Queue(socket, data, size);
+    }
+    SDL_UnlockMutex(shim.mutex);
+    return queued;
+}
+
+int32_t Shim_OfferTcp(TCPsocket socket, const void* const data, const int32_t size)
+{
+    if(!SDL_AtomicGet(&shim.is_running))
+        return Poll_Offer(socket, data, size);
+    SDL_LockMutex(shim.mutex);
+    const int32_t queued = Queue(socket, data, size);
+    SDL_UnlockMutex(shim.mutex);
+    return queued;
+}
+
+// A REORDERED DATAGRAM IS HELD BACK LONG ENOUGH FOR THE ONES SENT AFTER IT TO OVERTAKE IT.
+int32_t Shim_SendUdp(UDPsocket socket, const UDPpacket* const packet)
+{
+    if(!SDL_AtomicGet(&shim.is_running))
+        return SDLNet_UDP_Send(socket, -1, (UDPpacket*) packet);
+    SDL_LockMutex(shim.mutex);
+    if(shim.count < SHIM_QUEUE_MAX && !Roll(shim.impair.loss))
+    {
+        const uint32_t sent = Serialize(socket, packet->address, packet->len);
+        uint32_t due = sent + GetDelay();
+        if(Roll(shim.impair.reorder))
+            due += (uint32_t) UTIL_MAX(shim.impair.delay_ms, SHIM_REORDER_MIN_MS);
+        Enqueue(socket, true, packet->address, packet->data, packet->len, due);
+        if(Roll(shim.impair.duplicate))
+            Enqueue(socket, true, packet->address, packet->data, packet->len, sent + GetDelay());
+    }
+    SDL_UnlockMutex(shim.mutex);
+    return 1;
+}
+
+void Shim_Forget(void* const socket)
+{
+    if(!SDL_AtomicGet(&shim.is_running))
+        return;
+    SDL_LockMutex(shim.sending);
+    SDL_LockMutex(shim.mutex);
+    Purge(socket);
+    int32_t kept = 0;
+    for(int32_t i = 0; i < shim.lanes; i++)
+        if(shim.lane[i].socket != socket)
+            shim.lane[kept++] = shim.lane[i];
+    shim.lanes = kept;
+    kept = 0;
+    for(int32_t i = 0; i < shim.failures; i++)
+        if(shim.failed[i] != socket)
+            shim.failed[kept++] = shim.failed[i];
+    shim.failures = kept;
+    SDL_UnlockMutex(shim.mutex);
+    SDL_UnlockMutex(shim.sending);
+}
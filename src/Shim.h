@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Impair.h"
+
+#include <SDL2/SDL_net.h>
+
+// AN IN PROCESS STAND IN FOR NETEM. ONCE STARTED, EVERYTHING THE WIRES AND LINKS SEND WAITS IN ONE
+// QUEUE UNTIL A PUMP THREAD LETS IT OUT, SO DELAY, JITTER, LOSS, DUPLICATION, REORDERING AND A
+// BANDWIDTH CAP APPLY TO THIS PROCESS ALONE, WITHOUT ROOT. ONLY OUTGOING TRAFFIC IS IMPAIRED, SO
+// BOTH ENDS ARE GIVEN THE SAME PROFILE TO IMPAIR BOTH DIRECTIONS.
+//
+// DATAGRAMS ARE DROPPED, DUPLICATED AND REORDERED AS THEY ARE. A STREAM CANNOT BE: A LOST TCP SEGMENT
+// IS HELD BACK FOR A RETRANSMISSION TIMEOUT INSTEAD, AND EVERYTHING SENT AFTER IT ON THE SAME SOCKET
+// WAITS BEHIND IT, WHICH IS THE HEAD OF LINE BLOCKING TCP SUFFERS UNDER LOSS.
+//
+// THE BANDWIDTH CAP APPLIES TO EACH LANE, ONE SOCKET SENDING TO ONE PEER, AS IF EVERY CLIENT SAT
+// BEHIND A LINE OF ITS OWN. UNTIL STARTED, SENDS GO STRAIGHT TO SDL_NET, AND OFFERS STRAIGHT TO THE
+// SOCKET WITHOUT WAITING. ONCE STARTED, AN OFFER IS QUEUED WHOLE, OR NOT AT ALL WHILE THE QUEUE IS
+// FULL, WHERE A SEND WAITS FOR ROOM INSTEAD, AS ON A FULL SOCKET BUFFER. A TCP SEND THAT FAILS ONCE
+// IT IS LET OUT FAILS EVERY LATER SEND AND OFFER ON ITS SOCKET. A SOCKET MUST BE FORGOTTEN BEFORE IT
+// IS CLOSED.
+
+#define SHIM_TCP_RTO_MS (200)
+
+#define SHIM_REORDER_MIN_MS (10)
+
+#define SHIM_QUEUE_MAX (4096)
+
+void Shim_Start(const Impair);
+
+void Shim_Stop(void);
+
+int32_t Shim_SendTcp(TCPsocket, const void* const data, const int32_t size);
+
+int32_t Shim_OfferTcp(TCPsocket, const void* const data, const int32_t size);
+
+int32_t Shim_SendUdp(UDPsocket, const UDPpacket* const);
+
+void Shim_Forget(void* const socket);
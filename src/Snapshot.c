@@ -0,0 +1,48 @@
+#include "Snapshot.h"
+
+#include "Util.h"
+
+#include <string.h>
+
+Snapshot Snapshot_Make(void)
+{
+    static Snapshot zero;
+    return zero;
+}
+
+void Snapshot_Free(const Snapshot snapshot)
+{
+    free(snapshot.byte);
+}
+
+void Snapshot_Clear(Snapshot* const snapshot)
+{
+    snapshot->size = 0;
+    snapshot->index = 0;
+}
+
+// RETURNS WHERE THE BYTES WENT, FOR PATCHING IN PLACE UNTIL THE NEXT PUT. WITHOUT A SOURCE THE
+// SPACE IS ONLY RESERVED.
+void* Snapshot_Put(Snapshot* const snapshot, const void* const source, const int32_t size)
+{
+    if(snapshot->size + size > snapshot->max)
+    {
+        snapshot->max = UTIL_MAX(2 * snapshot->max, snapshot->size + size);
+        snapshot->byte = UTIL_REALLOC(snapshot->byte, uint8_t, snapshot->max);
+    }
+    uint8_t* const to = &snapshot->byte[snapshot->size];
+    if(source)
+        memcpy(to, source, (size_t) size);
+    snapshot->size += size;
+    return to;
+}
+
+// NULL ONCE THE SNAPSHOT RUNS SHORT.
+const void* Snapshot_Get(Snapshot* const snapshot, const int32_t size)
+{
+    if(snapshot->index + size > snapshot->size)
+        return NULL;
+    const uint8_t* const from = &snapshot->byte[snapshot->index];
+    snapshot->index += size;
+    return from;
+}
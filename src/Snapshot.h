@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+
+// A CONTIGUOUS BUFFER HOLDING A WORLD. NOTHING IN IT IS A POINTER - UNITS REFER TO UNITS BY INDEX
+// AND PATHS BY THEIR ORDER IN ONE POOL OF POINTS - SO IT CAN BE KEPT, COPIED, OR SENT AS IS TO A
+// PROCESS OF THE SAME BUILD. THE BUFFER IS KEPT BETWEEN SNAPSHOTS, SO TAKING ONE RARELY ALLOCATES.
+
+typedef struct
+{
+    uint8_t* byte;
+    int32_t size;
+    int32_t max;
+    int32_t index;
+}
+Snapshot;
+
+Snapshot Snapshot_Make(void);
+
+void Snapshot_Free(const Snapshot);
+
+void Snapshot_Clear(Snapshot* const);
+
+void* Snapshot_Put(Snapshot* const, const void* const, const int32_t size);
+
+const void* Snapshot_Get(Snapshot* const, const int32_t size);
@@ -1,28 +1,147 @@
 #include "Sock.h"
 
+#include "Shim.h"
 #include "Util.h"
 
+#include <SDL2/SDL_timer.h>
+
 Sock Sock_Connect(const char* const host, const int32_t port)
 {
     static Sock zero;
     Sock sock = zero;
-    IPaddress ip;
-    SDLNet_ResolveHost(&ip, host, port);
-    sock.server = SDLNet_TCP_Open(&ip);
+    SDLNet_ResolveHost(&sock.ip, host, port);
+    sock.server = SDLNet_TCP_Open(&sock.ip);
     if(sock.server == NULL)
         Util_Bomb("Could not connect to %s:%d... Is the openempires server running?\n", host, port);
     sock.set = SDLNet_AllocSocketSet(1);
     SDLNet_TCP_AddSocket(sock.set, sock.server);
+    sock.wire = Wire_Make(sock.server);
+    sock.rtt = Rtt_Make();
+    sock.transfer = UTIL_ALLOC(Transfer, 1);
+    *sock.transfer = Transfer_Make();
+    sock.codec = UTIL_ALLOC(Codec, CODEC_CHANNELS);
+    sock.huffman = UTIL_ALLOC(Huffman, 1);
+    *sock.huffman = Huffman_Make();
     return sock;
 }
 
 void Sock_Disconnect(const Sock sock)
 {
+    if(sock.link)
+    {
+        Shim_Forget(sock.link->socket);
+        SDLNet_UDP_Close(sock.link->socket);
+        Link_Free(sock.link);
+    }
+    Wire_Free(sock.wire);
+    Rtt_Free(sock.rtt);
+    Transfer_Free(*sock.transfer);
+    free(sock.transfer);
+    free(sock.codec);
+    free(sock.huffman);
     SDLNet_FreeSocketSet(sock.set);
     SDLNet_TCP_Close(sock.server);
 }
 
-void Sock_Send(const Sock sock, const Overview overview)
+// WITH A LINK, UPLINKS ONLY EVER TAKE THE LINK, SO A HEARTBEAT NEVER OVERTAKES A COMMAND.
+static void Send(const Sock sock, const Bytes* const bytes)
+{
+    if(sock.link)
+    {
+        if(!Link_Push(sock.link, bytes))
+            Util_Bomb("CLIENT - THE SERVER STOPPED ACKING\n");
+        Link_Flush(sock.link);
+    }
+    else
+    {
+        Wire_Push(sock.wire, bytes);
+        Wire_Flush(sock.wire);
+    }
+}
+
+// THE STAMP IS NEVER ZERO, AS ZERO MEANS NOTHING TO ECHO.
+void Sock_SendHeartbeat(const Sock sock, Overview overview)
+{
+    overview.stamp = UTIL_MAX(1, SDL_GetTicks());
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Overview_Encode(overview, &bytes);
+    Send(sock, &bytes);
+}
+
+void Sock_SendCommand(const Sock sock, const Overview overview)
+{
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Overview_EncodeCommand(overview, &bytes);
+    Send(sock, &bytes);
+}
+
+void Sock_SendParity(const Sock sock, const Parity parity)
 {
-    SDLNet_TCP_Send(sock.server, &overview, sizeof(overview));
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Parity_Encode(parity, &bytes);
+    Send(sock, &bytes);
+}
+
+// A FEW CHUNKS PER CALL, SO A SNAPSHOT IS PACED OVER MANY FRAMES. SNAPSHOTS TAKE THE WIRE EVEN OVER
+// UDP, SO THEY NEITHER FILL THE LINK'S WINDOW NOR HOLD UP THE HEARTBEATS AND COMMANDS BEHIND THEM.
+void Sock_SendSnapshot(const Sock sock, Transfer* const transfer, const int32_t chunks)
+{
+    Chunk chunk;
+    for(int32_t i = 0; i < chunks && Transfer_Next(transfer, &chunk); i++)
+    {
+        Bytes bytes;
+        Bytes_Clear(&bytes);
+        Chunk_Encode(chunk, &bytes);
+        Wire_Push(sock.wire, &bytes);
+    }
+    Wire_Flush(sock.wire);
+}
+
+static Join Answer(const Sock sock)
+{
+    static Join zero;
+    Bytes bytes;
+    while(!sock.wire->is_closed)
+    {
+        while(Wire_Pop(sock.wire, &bytes))
+        {
+            const Join assign = Join_Decode(&bytes, PROTOCOL_ASSIGN);
+            if(Bytes_IsDone(&bytes))
+                return assign;
+        }
+        Wire_Fill(sock.wire);
+    }
+    return zero;
+}
+
+// BLOCKS UNTIL THE SERVER ANSWERS. THE TURNS THAT FOLLOW THE ANSWER STAY BUFFERED IN THE WIRE.
+// A MATCH OF ZERO MEANS THE SERVER HAD NO SEAT. WHEN THE SERVER HANDS OUT A TOKEN, UPLINKS MOVE TO
+// UDP ON THE SAME PORT AT ONCE, AND TURNS ONCE THE HANDOFF ARRIVES. THE LINK GREETS THE SERVER
+// STRAIGHT AWAY, SO THE SERVER HAS ITS PEER BY THEN.
+Sock Sock_Join(Sock sock, const int32_t match, const int32_t users)
+{
+    static Join zero;
+    Join join = zero;
+    join.match = match;
+    join.users = users;
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Join_Encode(join, PROTOCOL_JOIN, &bytes);
+    Wire_Push(sock.wire, &bytes);
+    Wire_Flush(sock.wire);
+    const Join assign = Answer(sock);
+    sock.match = assign.match;
+    if(assign.token != 0)
+    {
+        const UDPsocket socket = SDLNet_UDP_Open(0);
+        if(socket == NULL)
+            Util_Bomb("CLIENT - COULD NOT OPEN A UDP SOCKET\n");
+        sock.link = Link_Make(socket, assign.token, sock.ip.host);
+        Link_Connect(sock.link, sock.ip);
+        Link_Greet(sock.link);
+    }
+    return sock;
 }
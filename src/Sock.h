@@ -1,6 +1,13 @@
 #pragma once
 
 #include "Overview.h"
+#include "Wire.h"
+#include "Join.h"
+#include "Link.h"
+#include "Rtt.h"
+#include "Transfer.h"
+#include "Codec.h"
+#include "Huffman.h"
 
 #include <SDL2/SDL_net.h>
 
@@ -8,6 +15,14 @@ typedef struct
 {
     TCPsocket server;
     SDLNet_SocketSet set;
+    Wire* wire;
+    Link* link;
+    Rtt* rtt;
+    Transfer* transfer;
+    Codec* codec;
+    Huffman* huffman;
+    IPaddress ip;
+    int32_t match;
 }
 Sock;
 
@@ -15,4 +30,12 @@ Sock Sock_Connect(const char* const host, const int32_t port);
 
 void Sock_Disconnect(const Sock);
 
-void Sock_Send(const Sock, const Overview);
+void Sock_SendHeartbeat(const Sock, const Overview);
+
+void Sock_SendCommand(const Sock, const Overview);
+
+void Sock_SendParity(const Sock, const Parity);
+
+void Sock_SendSnapshot(const Sock, Transfer* const, const int32_t chunks);
+
+Sock Sock_Join(Sock, const int32_t match, const int32_t users);
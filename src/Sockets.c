@@ -1,73 +1,432 @@
 #include "Sockets.h"
 
+#include "Chunk.h"
 #include "Config.h"
+#include "Protocol.h"
+#include "Shim.h"
 #include "Util.h"
 
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 
-Sockets Sockets_Init(const int32_t port, const int32_t users)
+// A MATCH WITHOUT A LISTENING SOCKET OF ITS OWN. CLIENTS ARE ADOPTED INTO IT.
+Sockets Sockets_Make(const int32_t match, const int32_t users)
 {
-    IPaddress ip;
-    SDLNet_ResolveHost(&ip, NULL, port);
     static Sockets zero;
     Sockets sockets = zero;
+    sockets.match = match;
     sockets.users = users;
+    sockets.set = SDLNet_AllocSocketSet(COLOR_COUNT + 1);
+    sockets.lead = Lead_Make();
+    return sockets;
+}
+
+// A SINGLE MATCH SERVER HOSTS MATCH ONE.
+Sockets Sockets_Init(const int32_t port, const int32_t users)
+{
+    IPaddress ip;
+    SDLNet_ResolveHost(&ip, NULL, port);
+    Sockets sockets = Sockets_Make(1, users);
     sockets.self = SDLNet_TCP_Open(&ip);
-    sockets.set = SDLNet_AllocSocketSet(COLOR_COUNT);
     return sockets;
 }
 
 void Sockets_Free(const Sockets sockets)
 {
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(sockets.socket[i])
+        {
+            if(sockets.is_polled)
+                Poll_Unwatch(sockets.poll, sockets.socket[i]);
+            Wire_Free(sockets.wire[i]);
+            SDLNet_TCP_Close(sockets.socket[i]);
+            if(sockets.link[i])
+                Link_Free(sockets.link[i]);
+            free(sockets.codec[i]);
+            Commands_Free(sockets.commands[i]);
+        }
     SDLNet_TCP_Close(sockets.self);
+    if(sockets.udp)
+        Shim_Forget(sockets.udp);
+    SDLNet_UDP_Close(sockets.udp);
+    SDLNet_FreePacket(sockets.datagram);
     SDLNet_FreeSocketSet(sockets.set);
+    Lead_Free(sockets.lead);
+    Rejoin_Free(sockets.rejoin);
+    if(sockets.spectators)
+    {
+        if(sockets.is_polled)
+            Poll_Unwatch(sockets.poll, sockets.spectators->self);
+        Spectators_Free(sockets.spectators);
+    }
+    Telemetry_Stop(sockets.telemetry);
+    free(sockets.huffman);
+}
+
+// CALLED BEFORE SOCKETS_WATCH. EVERY CLIENT ADOPTED FROM HERE ON IS HANDED A TOKEN IN ITS ASSIGN.
+Sockets Sockets_EnableUdp(Sockets sockets, const int32_t port)
+{
+    sockets.udp = SDLNet_UDP_Open(port);
+    if(sockets.udp == NULL)
+        Util_Bomb("SERVER - COULD NOT OPEN UDP PORT %d\n", port);
+    sockets.datagram = SDLNet_AllocPacket(BYTES_MAX);
+    SDLNet_UDP_AddSocket(sockets.set, sockets.udp);
+    return sockets;
+}
+
+// CALLED BEFORE SOCKETS_WATCH. THE DELAY IS IN TURNS.
+Sockets Sockets_EnableSpectators(Sockets sockets, const int32_t port, const int32_t delay)
+{
+    sockets.spectators = Spectators_Make(port, delay);
+    return sockets;
+}
+
+Sockets Sockets_EnableTelemetry(Sockets sockets, const char* const path)
+{
+    sockets.telemetry = Telemetry_Start(path);
+    return sockets;
+}
+
+// CALLED BEFORE ANY CLIENT IS ADOPTED. TURNS GO OUT AS DELTAS, AND AT THE SQUEEZE LEVEL THROUGH THE
+// SHARED HUFFMAN CODE TOO.
+Sockets Sockets_EnableCompression(Sockets sockets, const int32_t level)
+{
+    sockets.compress = level;
+    if(level >= CODEC_SQUEEZE)
+    {
+        sockets.huffman = UTIL_ALLOC(Huffman, 1);
+        *sockets.huffman = Huffman_Make();
+    }
+    return sockets;
+}
+
+static Link* FindLink(const Sockets sockets, const uint32_t token)
+{
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(sockets.link[i] && sockets.link[i]->token == token)
+            return sockets.link[i];
+    return NULL;
 }
 
-static Sockets Add(Sockets sockets, TCPsocket socket)
+// THE TOKEN IS ALL THAT STANDS BETWEEN A LINK AND ANYONE ELSE SENDING TO THE PORT, SO IT IS DRAWN
+// FROM THE SYSTEM'S ENTROPY AND NEVER FROM A CLOCK.
+static uint32_t MakeToken(const Sockets sockets)
+{
+    FILE* const fp = fopen("/dev/urandom", "rb");
+    if(fp == NULL)
+        Util_Bomb("SERVER - COULD NOT OPEN /dev/urandom FOR A LINK TOKEN\n");
+    uint32_t token = 0;
+    while(token == 0 || FindLink(sockets, token))
+        if(fread(&token, sizeof(token), 1, fp) != 1)
+            Util_Bomb("SERVER - COULD NOT READ /dev/urandom FOR A LINK TOKEN\n");
+    fclose(fp);
+    return token;
+}
+
+// WITHOUT A FREE SLOT THE CLIENT IS TURNED AWAY.
+Sockets Sockets_Adopt(Sockets sockets, Wire* const wire)
 {
     for(int32_t i = 0; i < COLOR_COUNT; i++)
         if(sockets.socket[i] == NULL)
         {
-            SDLNet_TCP_AddSocket(sockets.set, socket);
-            sockets.socket[i] = socket;
+            SDLNet_TCP_AddSocket(sockets.set, wire->socket);
+            if(sockets.is_polled)
+                Poll_Watch(sockets.poll, wire->socket, sockets.tag + i);
+            sockets.socket[i] = wire->socket;
+            sockets.wire[i] = wire;
+            sockets.commands[i] = Commands_Init();
+            sockets.is_rejoining[i] = sockets.is_started;
             return sockets;
         }
+    TCPsocket socket = wire->socket;
+    Wire_Free(wire);
+    SDLNet_TCP_Close(socket);
     return sockets;
 }
 
-Sockets Sockets_Service(Sockets sockets, const int32_t timeout)
+// THE CLIENT SKIPS EVERYTHING BEFORE ITS ASSIGN, SO TURNS ONLY GO OUT AS DELTAS AFTER IT. THE LINK
+// IS MADE HERE TOO, AND ONLY A DATAGRAM FROM THE CLIENT'S OWN HOST BINDS IT.
+static Sockets Assign(Sockets sockets, const int32_t i)
 {
-    if(SDLNet_CheckSockets(sockets.set, timeout))
-        for(int32_t i = 0; i < COLOR_COUNT; i++)
+    static Join zero;
+    if(sockets.udp && sockets.link[i] == NULL)
+    {
+        const IPaddress* const peer = SDLNet_TCP_GetPeerAddress(sockets.socket[i]);
+        sockets.link[i] = Link_Make(sockets.udp, MakeToken(sockets), peer ? peer->host : 0);
+        Link_Open(sockets.link[i]);
+    }
+    Join join = zero;
+    join.match = sockets.match;
+    join.users = sockets.users;
+    join.token = sockets.link[i] ? sockets.link[i]->token : 0;
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Join_Encode(join, PROTOCOL_ASSIGN, &bytes);
+    Telemetry_Send(sockets.telemetry, i, bytes.size);
+    Wire_Push(sockets.wire[i], &bytes);
+    Wire_Send(sockets.wire[i]);
+    if(sockets.compress > CODEC_OFF && sockets.codec[i] == NULL)
+        sockets.codec[i] = UTIL_ALLOC(Codec, CODEC_CHANNELS);
+    return sockets;
+}
+
+// A SLOT'S TURNS TAKE THE WIRE UNTIL THE HANDOFF, AND THE LINK FROM THEN ON. THE HANDOFF IS THE
+// LAST OF THEM ON THE WIRE, AND THE CLIENT ONLY READS THE LINK ONCE IT READ THE HANDOFF, SO NO TURN
+// EVER OVERTAKES ANOTHER. A LINK WHOSE PEER STOPPED ACKING CLOSES THE WIRE, AND THE SLOT IS DROPPED.
+static void Deliver(const Sockets sockets, const int32_t i, const Bytes* const bytes)
+{
+    Telemetry_Send(sockets.telemetry, i, bytes->size);
+    if(!sockets.is_linked[i])
+        Wire_Push(sockets.wire[i], bytes);
+    else if(!Link_Push(sockets.link[i], bytes))
+        sockets.wire[i]->is_closed = true;
+}
+
+// A REJOINING CLIENT IS HANDED OFF ONLY ONCE ITS SNAPSHOT AND BACKLOG ARE THROUGH, AS THOSE ARE BULK
+// THE WIRE CARRIES BETTER.
+static Sockets Handoff(Sockets sockets, const int32_t i)
+{
+    static Join zero;
+    Join join = zero;
+    join.match = sockets.match;
+    join.users = sockets.users;
+    join.token = sockets.link[i]->token;
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    Join_Encode(join, PROTOCOL_HANDOFF, &bytes);
+    Deliver(sockets, i, &bytes);
+    sockets.is_linked[i] = true;
+    return sockets;
+}
+
+// AS MUCH OF WHAT IS HELD FOR THE REJOINING CLIENT GOES OUT AS KEEPS ITS QUEUE UNDER THE LIMIT, SO A
+// SLOW CLIENT IS PACED OVER AS MANY RELAYS AS IT NEEDS AND THE SERVER NEVER WAITS ON IT. THE CHUNKS
+// GO FIRST AND THE BACKLOG BEHIND THEM, AND ONCE BOTH ARE THROUGH THE CLIENT IS IN THE MATCH FROM THE
+// NEXT TURN ON. ANY PROGRESS COUNTS AS HEARING FROM THE DONOR.
+static Sockets Pace(Sockets sockets)
+{
+    Rejoin rejoin = sockets.rejoin;
+    if(!rejoin.is_active)
+        return sockets;
+    Wire* const wire = sockets.wire[rejoin.slot];
+    const int32_t before = rejoin.paced + rejoin.sent;
+    while(rejoin.paced < rejoin.chunks && wire->out_size < CONFIG_SOCKETS_REJOIN_QUEUED)
+        Deliver(sockets, rejoin.slot, &rejoin.chunk[rejoin.paced++]);
+    if(rejoin.is_taken && rejoin.paced == rejoin.chunks)
+        while(rejoin.sent < rejoin.count && wire->out_size < CONFIG_SOCKETS_REJOIN_QUEUED)
+            Deliver(sockets, rejoin.slot, &rejoin.backlog[rejoin.sent++]);
+    if(rejoin.paced + rejoin.sent > before)
+        rejoin.waited = 0;
+    if(rejoin.is_taken && rejoin.paced == rejoin.chunks && rejoin.sent == rejoin.count)
+    {
+        sockets.is_rejoining[rejoin.slot] = false;
+        sockets.catching_up[rejoin.slot] = UTIL_MAX(1, sockets.exec_cycle);
+        sockets.agreed[rejoin.slot] = rejoin.taken;
+        rejoin = Rejoin_Stop(rejoin);
+    }
+    Wire_Send(wire);
+    sockets.rejoin = rejoin;
+    return sockets;
+}
+
+// CHUNKS FROM THE DONOR ARE HELD UNTIL THE REJOINING CLIENT TAKES THEM.
+static Sockets Forward(Sockets sockets, const int32_t i, const Chunk chunk, const Bytes* const bytes)
+{
+    Rejoin rejoin = sockets.rejoin;
+    if(!rejoin.is_active
+    || rejoin.is_taken
+    || i != rejoin.donor
+    || chunk.cycles < rejoin.cycles
+    || (rejoin.relayed > 0 && chunk.cycles != rejoin.taken))
+        return sockets;
+    rejoin = Rejoin_Hold(rejoin, bytes);
+    rejoin.taken = chunk.cycles;
+    rejoin.relayed += chunk.count;
+    rejoin.is_taken = rejoin.relayed == chunk.size;
+    rejoin.waited = 0;
+    sockets.rejoin = rejoin;
+    return Pace(sockets);
+}
+
+static bool Pop(const Sockets sockets, const int32_t i, Bytes* const bytes)
+{
+    return Wire_Pop(sockets.wire[i], bytes)
+        || (sockets.link[i] && Link_Pop(sockets.link[i], bytes));
+}
+
+// EVERY WHOLE MESSAGE THAT ARRIVED IS APPLIED IN ORDER, BY ITS KIND. THE LATEST HEARTBEAT AND THE
+// LATEST PARITY ANSWERING A PROBE WIN. COMMANDS ARE QUEUED, AND CHUNKS ARE FORWARDED AS THEY COME. A
+// MESSAGE THAT DOES NOT DECODE WHOLE AS ITS KIND IS IGNORED. A COMMAND BEFORE TURNS ARE STABLE, WHICH
+// NO TURN WOULD CARRY, OR ONE THAT DOES NOT FIT THE QUEUE, IS DROPPED.
+static Sockets Drain(Sockets sockets, const int32_t i)
+{
+    Bytes bytes;
+    while(Pop(sockets, i, &bytes))
+    {
+        Telemetry_Receive(sockets.telemetry, i, bytes.size);
+        switch(Protocol_GetKind(&bytes))
+        {
+        case PROTOCOL_UPLINK:
         {
-            TCPsocket socket = sockets.socket[i];
-            if(SDLNet_SocketReady(socket))
+            const Overview overview = Overview_Decode(&bytes);
+            if(!Bytes_IsDone(&bytes))
+                break;
+            sockets.cycles[i] = overview.cycles;
+            sockets.parity[i] = overview.parity;
+            sockets.parity_cycles[i] = overview.parity_cycles;
+            sockets.queue_size[i] = overview.queue_size;
+            sockets.pings[i] = overview.ping;
+            sockets.stamp[i] = overview.stamp;
+            sockets.stamped[i] = SDL_GetTicks();
+            if(overview.ping > 0)
+                Telemetry_Ping(sockets.telemetry, i, overview.ping);
+            break;
+        }
+        case PROTOCOL_COMMAND:
+        {
+            const Overview command = Overview_DecodeCommand(&bytes);
+            if(!Bytes_IsDone(&bytes))
+                break;
+            if(sockets.is_stable && Commands_Fits(sockets.commands[i], command))
+                sockets.commands[i] = Commands_Queue(sockets.commands[i], command);
+            else
+                sockets.dropped[i] = command.sequence;
+            break;
+        }
+        case PROTOCOL_PARITY:
+        {
+            const Parity parity = Parity_Decode(&bytes);
+            if(Bytes_IsDone(&bytes))
+                sockets.probed[i] = parity;
+            break;
+        }
+        case PROTOCOL_CHUNK:
+        {
+            const Chunk chunk = Chunk_Decode(&bytes);
+            if(!Bytes_IsDone(&bytes))
+                break;
+            sockets = Forward(sockets, i, chunk, &bytes);
+            if(sockets.spectators)
+                Spectators_Take(sockets.spectators, i, chunk, &bytes);
+            break;
+        }
+        case PROTOCOL_JOIN:
+            Join_Decode(&bytes, PROTOCOL_JOIN);
+            if(Bytes_IsDone(&bytes))
+                sockets = Assign(sockets, i);
+            break;
+        }
+    }
+    return sockets;
+}
+
+static Sockets Drop(Sockets sockets, const int32_t i)
+{
+    static Overview zero;
+    static Parity none;
+    static Commands empty;
+    SDLNet_TCP_DelSocket(sockets.set, sockets.socket[i]);
+    if(sockets.is_polled)
+        Poll_Unwatch(sockets.poll, sockets.socket[i]);
+    Wire_Free(sockets.wire[i]);
+    SDLNet_TCP_Close(sockets.socket[i]);
+    if(sockets.link[i])
+        Link_Free(sockets.link[i]);
+    free(sockets.codec[i]);
+    Commands_Free(sockets.commands[i]);
+    sockets.cycles[i] = 0;
+    sockets.parity[i] = 0;
+    sockets.parity_cycles[i] = 0;
+    sockets.agreed[i] = 0;
+    sockets.probed[i] = none;
+    sockets.queue_size[i] = 0;
+    sockets.stamp[i] = 0;
+    sockets.dropped[i] = 0;
+    sockets.is_rejoining[i] = false;
+    sockets.catching_up[i] = 0;
+    if(sockets.rejoin.is_active && (i == sockets.rejoin.slot || i == sockets.rejoin.donor))
+        sockets.rejoin = Rejoin_Stop(sockets.rejoin);
+    if(sockets.spectators)
+        Spectators_Forget(sockets.spectators, i);
+    Lead_Forget(sockets.lead, i);
+    sockets.packet.overview[i] = zero;
+    sockets.socket[i] = NULL;
+    sockets.wire[i] = NULL;
+    sockets.link[i] = NULL;
+    sockets.is_linked[i] = false;
+    sockets.codec[i] = NULL;
+    sockets.commands[i] = empty;
+    return sockets;
+}
+
+Sockets Sockets_Watch(Sockets sockets, const Poll poll, const int32_t tag)
+{
+    sockets.poll = poll;
+    sockets.tag = tag;
+    sockets.is_polled = true;
+    if(sockets.self)
+        Poll_Watch(poll, sockets.self, tag + COLOR_COUNT);
+    if(sockets.udp)
+        Poll_WatchUdp(poll, sockets.udp, tag + COLOR_COUNT + 1);
+    if(sockets.spectators)
+        Poll_Watch(poll, sockets.spectators->self, tag + COLOR_COUNT + 2);
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(sockets.socket[i])
+            Poll_Watch(poll, sockets.socket[i], tag + i);
+    return sockets;
+}
+
+// ONLY CALLED ONCE THE SOCKET IS READY. A SLOT DROPPED EARLIER IN THE SAME WAKEUP IS SKIPPED.
+// WHAT THE LAST RELAY LEFT QUEUED, AND WHAT IS HELD FOR A REJOINING CLIENT, IS TRIED AGAIN.
+Sockets Sockets_Read(Sockets sockets, const int32_t index)
+{
+    Wire* const wire = sockets.wire[index];
+    if(wire)
+    {
+        Wire_Fill(wire);
+        sockets = Drain(sockets, index);
+        sockets = Pace(sockets);
+        Wire_Send(wire);
+        if(wire->is_closed)
+            sockets = Drop(sockets, index);
+    }
+    return sockets;
+}
+
+// DATAGRAMS ARE ROUTED TO THEIR CLIENT BY TOKEN. ONCE EVERYTHING PENDING IS READ, ANY ACKS
+// OWED AND RESENDS WHOSE TIMEOUT EXPIRED GO OUT WITHOUT WAITING FOR THE NEXT TURN.
+Sockets Sockets_ReadDatagrams(Sockets sockets)
+{
+    Bytes bytes;
+    while(Link_Recv(sockets.udp, sockets.datagram, &bytes))
+    {
+        const uint32_t token = Link_GetToken(&bytes);
+        for(int32_t i = 0; i < COLOR_COUNT; i++)
+            if(token != 0 && sockets.link[i] && sockets.link[i]->token == token)
             {
-                static Overview zero;
-                Overview overview = zero;
-                const int32_t max = sizeof(overview);
-                const int32_t bytes = SDLNet_TCP_Recv(socket, &overview, max);
-                if(bytes <= 0)
-                {
-                    SDLNet_TCP_DelSocket(sockets.set, socket);
-                    sockets.cycles[i] = 0;
-                    sockets.parity[i] = 0;
-                    sockets.queue_size[i] = 0;
-                    sockets.packet.overview[i] = zero;
-                    sockets.socket[i] = NULL;
-                }
-                if(bytes == max)
-                {
-                    sockets.cycles[i] = overview.cycles;
-                    sockets.parity[i] = overview.parity;
-                    sockets.queue_size[i] = overview.queue_size;
-                    sockets.pings[i] = overview.ping;
-                    if(Overview_UsedAction(overview))
-                        sockets.packet.overview[i] = overview;
-                }
+                Link_Take(sockets.link[i], &bytes, sockets.datagram->address);
+                sockets = Drain(sockets, i);
+                break;
             }
-        }
+    }
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(sockets.link[i] && Link_IsDue(sockets.link[i]))
+            Link_Flush(sockets.link[i]);
+    return sockets;
+}
+
+Sockets Sockets_Service(Sockets sockets, const int32_t timeout)
+{
+    if(SDLNet_CheckSockets(sockets.set, timeout))
+    {
+        for(int32_t i = 0; i < COLOR_COUNT; i++)
+            if(SDLNet_SocketReady(sockets.socket[i]))
+                sockets = Sockets_Read(sockets, i);
+        if(SDLNet_SocketReady(sockets.udp))
+            sockets = Sockets_ReadDatagrams(sockets);
+    }
     return sockets;
 }
 
@@ -79,16 +438,27 @@ static Sockets Clear(Sockets sockets)
     return sockets;
 }
 
+static bool IsPlaying(const Sockets sockets, const int32_t i)
+{
+    return sockets.socket[i] != NULL
+        && !sockets.is_rejoining[i]
+        && sockets.catching_up[i] == 0;
+}
+
+// THE MEAN OF WHERE EACH CLIENT IS NOW: ITS LAST REPORT MOVED ON BY HALF ITS RTT AND BY THE TIME
+// THE REPORT HAS WAITED HERE.
 static int32_t GetCycleSetpoint(const Sockets sockets)
 {
+    const uint32_t now = SDL_GetTicks();
     int32_t setpoint = 0;
     int32_t count = 0;
     for(int32_t i = 0; i < COLOR_COUNT; i++)
     {
         const int32_t cycles = sockets.cycles[i];
-        if(cycles > 0)
+        if(cycles > 0 && IsPlaying(sockets, i))
         {
-            setpoint += cycles;
+            const int32_t ms = UTIL_MAX(0, sockets.pings[i]) / 2 + (int32_t) (now - sockets.stamped[i]);
+            setpoint += cycles + ms / CONFIG_MAIN_LOOP_SPEED_MS;
             count++;
         }
     }
@@ -107,73 +477,162 @@ static int32_t GetCycleMax(const Sockets sockets)
     return max;
 }
 
-static int32_t GetPingMax(const Sockets sockets)
-{
-    int32_t max = 0;
-    for(int32_t i = 0; i < COLOR_COUNT; i++)
-    {
-        const int32_t ping = sockets.pings[i];
-        if(ping > max)
-            max = ping;
-    }
-    return max;
-}
-
-static Sockets CalculateControlChars(Sockets sockets, const int32_t setpoint)
+// EVERY CONNECTED CLIENT'S NEWEST RTT IS ONE SAMPLE PER TURN.
+static int32_t GetLead(const Sockets sockets)
 {
     for(int32_t i = 0; i < COLOR_COUNT; i++)
-        sockets.control[i] = (sockets.cycles[i] < setpoint)
-            ? PACKET_CONTROL_SPEED_UP
-            : PACKET_CONTROL_STEADY;
-    return sockets;
+        if(sockets.socket[i])
+            Lead_Sample(sockets.lead, i, sockets.pings[i]);
+    return Lead_Update(sockets.lead);
 }
 
-static void Print(const Sockets sockets, const int32_t setpoint, const int32_t max_ping)
+static void Print(const Sockets sockets, const int32_t setpoint, const int32_t lead)
 {
-    printf("TURN %d :: SETPOINT %d :: MAX_PING %d\n", sockets.turn, setpoint, max_ping);
+    printf("TURN %d :: SETPOINT %d :: LEAD %d :: P%d RTT %d :: LATE %d/1000\n", sockets.turn, setpoint, lead,
+        CONFIG_LEAD_PERCENTILE, sockets.lead->percentile, Lead_GetLateRate(sockets.lead));
     for(int32_t i = 0; i < COLOR_COUNT; i++)
     {
         const uint64_t parity = sockets.parity[i];
         const int32_t cycles = sockets.cycles[i];
         const int32_t ping = sockets.pings[i];
-        const char control = sockets.control[i];
         const char queue_size = sockets.queue_size[i];
         const char parity_symbol = sockets.is_stable ? '!' : '?';
         TCPsocket socket = sockets.socket[i];
-        printf("%d :: %d :: %c :: 0x%016lX :: %c :: CYCLES %d :: QUEUE %d -> %d ms\n",
-                i, socket != NULL, parity_symbol, parity, control, cycles, queue_size, ping);
+        printf("%d :: %d :: %c :: 0x%016lX :: CYCLES %d (%+d) :: QUEUE %d -> %d ms\n",
+                i, socket != NULL, parity_symbol, parity, cycles, cycles - setpoint, queue_size, ping);
     }
 }
 
-static void Send(Sockets sockets, const int32_t max_cycle, const int32_t max_ping, const bool game_running)
+// ONLY A STABLE TURN CARRIES COMMANDS, SO ONLY A STABLE TURN TAKES THEM FROM THE QUEUES.
+static Sockets Deal(Sockets sockets)
+{
+    if(sockets.is_stable)
+        for(int32_t i = 0; i < COLOR_COUNT; i++)
+            if(sockets.socket[i])
+            {
+                sockets.packet.overview[i] = Commands_Peek(sockets.commands[i]);
+                sockets.commands[i] = Commands_Pop(sockets.commands[i]);
+            }
+    return sockets;
+}
+
+// WHAT EVERY CLIENT AND SPECTATOR IS SENT ALIKE.
+static Packet Build(const Sockets sockets, const int32_t setpoint, const int32_t exec_cycle, const bool game_running)
+{
+    Packet packet = sockets.packet;
+    packet.setpoint = setpoint;
+    packet.turn = sockets.turn;
+    packet.exec_cycle = exec_cycle;
+    packet.is_stable = sockets.is_stable;
+    packet.game_running = game_running;
+    packet.users_connected = sockets.users_connected;
+    packet.users = sockets.users;
+    packet.is_rollback = sockets.is_rollback;
+    return sockets.is_stable ? packet : Packet_ZeroOverviews(packet);
+}
+
+static int32_t GetSnapshot(const Sockets sockets, const int32_t i)
+{
+    if(sockets.rejoin.is_active && i == sockets.rejoin.donor)
+        return sockets.rejoin.cycles;
+    return sockets.spectators ? Spectators_GetSnapshot(sockets.spectators, i) : 0;
+}
+
+// WHOLE UNLESS THERE IS A CODEC.
+static void Encode(const Sockets sockets, const Packet packet, Codec* const codec, Bytes* const bytes)
+{
+    Bytes_Clear(bytes);
+    if(codec)
+        Packet_EncodeDelta(packet, codec, sockets.huffman, bytes);
+    else
+        Packet_Encode(packet, bytes);
+}
+
+static void Post(const Sockets sockets, const int32_t i, const Packet packet)
+{
+    Codec* const codec = sockets.codec[i];
+    const int32_t channel = sockets.is_linked[i] ? CODEC_LINK : CODEC_WIRE;
+    Bytes bytes;
+    Encode(sockets, packet, codec ? &codec[channel] : NULL, &bytes);
+    Deliver(sockets, i, &bytes);
+}
+
+// A REJOINING CLIENT IS STILL IN THE LOBBY AS FAR AS IT KNOWS. ITS TURNS GO TO THE BACKLOG INSTEAD,
+// WITHOUT AN ECHO, AS THE TIME THEY WAIT THERE IS NO ROUND TRIP. ANY OTHER CLIENT WITH A LINK IS
+// HANDED OFF TO IT BEFORE ITS NEXT TURN.
+static Sockets Send(Sockets sockets, const int32_t setpoint, const int32_t exec_cycle, const bool game_running)
 {
-    const int32_t fps = 1000 / CONFIG_MAIN_LOOP_SPEED_MS;
-    const int32_t offset = (fps * (max_ping + CONFIG_SOCKETS_SERVER_UPDATE_SPEED_CYCLES)) / 1000;
-    const int32_t exec_cycle = max_cycle + offset;
     for(int32_t i = 0; i < COLOR_COUNT; i++)
     {
         TCPsocket socket = sockets.socket[i];
         if(socket)
         {
-            Packet packet = sockets.packet;
-            packet.control = sockets.control[i];
-            packet.turn = sockets.turn;
-            packet.exec_cycle = exec_cycle;
+            Packet packet = Build(sockets, setpoint, exec_cycle, game_running);
             packet.client_id = i;
-            packet.is_stable = sockets.is_stable;
-            packet.game_running = game_running;
-            packet.users_connected = sockets.users_connected;
-            packet.users = sockets.users;
-            if(!sockets.is_stable)
+            packet.echo = sockets.stamp[i];
+            packet.hold = (int32_t) (SDL_GetTicks() - sockets.stamped[i]);
+            packet.probe = sockets.bisect.is_active ? sockets.bisect.probe : 0;
+            packet.desync = sockets.bisect.is_done ? sockets.bisect.hi : 0;
+            packet.desync_regions = sockets.bisect.regions;
+            packet.snapshot = GetSnapshot(sockets, i);
+            packet.dropped = sockets.dropped[i];
+            Bytes bytes;
+            if(sockets.is_rejoining[i])
+            {
+                if(sockets.rejoin.is_active && i == sockets.rejoin.slot && packet.is_stable)
+                {
+                    packet.echo = 0;
+                    packet.hold = 0;
+                    Bytes_Clear(&bytes);
+                    Packet_Encode(packet, &bytes);
+                    sockets.rejoin = Rejoin_Keep(sockets.rejoin, &bytes);
+                }
+                packet.game_running = false;
+                packet.is_stable = false;
                 packet = Packet_ZeroOverviews(packet);
-            SDLNet_TCP_Send(socket, &packet, sizeof(packet));
+            }
+            else if(sockets.link[i] && !sockets.is_linked[i])
+                sockets = Handoff(sockets, i);
+            Post(sockets, i, packet);
         }
     }
+    return sockets;
+}
+
+// SPECTATORS ARE NAMED AFTER NO SLOT, AND ARE NEVER PROBED NOR ASKED FOR ANYTHING.
+static void Spectate(const Sockets sockets, const int32_t setpoint, const int32_t exec_cycle, const bool game_running)
+{
+    Packet packet = Build(sockets, setpoint, exec_cycle, game_running);
+    packet.client_id = COLOR_COUNT;
+    Spectators_Relay(sockets.spectators, packet, sockets.compress, sockets.huffman);
+}
+
+// EVERYTHING QUEUED FOR A CLIENT DURING A RELAY LEAVES IN ONE SEND, AS FAR AS ITS SOCKET TAKES IT
+// WITHOUT WAITING. A SLOW CLIENT HOLDS UP NO OTHER, AND IS DROPPED ONCE ITS WIRE FILLS.
+static void Flush(const Sockets sockets)
+{
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(sockets.wire[i])
+        {
+            Wire_Send(sockets.wire[i]);
+            if(sockets.link[i])
+                Link_Flush(sockets.link[i]);
+        }
+}
+
+// A SLOT WHOSE WIRE CLOSED WHILE SENDING IS DROPPED RATHER THAN SENT ANY MORE.
+static Sockets Sweep(Sockets sockets)
+{
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(sockets.wire[i] && sockets.wire[i]->is_closed)
+            sockets = Drop(sockets, i);
+    return sockets;
 }
 
-static bool ShouldRelay(const int32_t cycles, const int32_t interval)
+static void Measure(const Sockets sockets, const int32_t setpoint)
 {
-    return (cycles % interval) == 0;
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        Telemetry_Client(sockets.telemetry, i, sockets.socket[i] != NULL, sockets.queue_size[i], sockets.cycles[i] - setpoint);
 }
 
 static Sockets CheckStability(Sockets sockets, const int32_t setpoint)
@@ -183,25 +642,65 @@ static Sockets CheckStability(Sockets sockets, const int32_t setpoint)
     return sockets;
 }
 
-static void CheckParity(const Sockets sockets)
+static void Report(const Sockets sockets)
 {
-    if(sockets.is_stable)
-        for(int32_t j = 0; j < COLOR_COUNT; j++)
+    const Bisect bisect = sockets.bisect;
+    printf("SERVER - MATCH %d :: CLIENTS %d AND %d DESYNCED :: ", sockets.match, bisect.a, bisect.b);
+    if(bisect.is_exact)
+        printf("FIRST DIFFERING CHECKPOINT %d", bisect.hi);
+    else
+        printf("GAVE UP BETWEEN CYCLES %d AND %d", bisect.lo, bisect.hi);
+    printf(" :: ASPECTS");
+    for(int32_t i = 0; i < ASPECT_COUNT; i++)
+        if(bisect.aspects & (1u << i))
+            printf(" %s", Parity_GetAspectName((Aspect) i));
+    printf(" :: REGIONS 0x%04X\n", bisect.regions);
+}
+
+// CLIENTS ARE COMPARED AT THE CHECKPOINTS THEY HAPPEN TO REPORT IN COMMON. THE FIRST PAIR THAT
+// DISAGREES IS BISECTED FROM THE LAST CHECKPOINT BOTH WERE SEEN AGREEING WITH SOMEONE AT, AND THE
+// MATCH IS ONLY OUT OF SYNC ONCE THE BISECTION IS OVER, SO THAT ITS RESULT REACHES THE CLIENTS.
+static Sockets CheckParity(Sockets sockets)
+{
+    if(sockets.bisect.is_active)
+    {
+        const Bisect bisect = sockets.bisect;
+        sockets.bisect = Bisect_Answer(bisect, sockets.probed[bisect.a], sockets.probed[bisect.b]);
+        if(sockets.bisect.is_done)
         {
-            const int32_t cycles_check = sockets.cycles[j];
-            const int32_t parity_check = sockets.parity[j];
-            for(int32_t i = 0; i < COLOR_COUNT; i++)
-            {
-                const int32_t cycles = sockets.cycles[i];
-                const int32_t parity = sockets.parity[i];
-                if((cycles == cycles_check)
-                && (parity != parity_check)) // XXX. MAKE THIS KILL THE CLIENT INSTEAD OF KILLING THE SERVER.
-                    Util_Bomb("SERVER - CLIENT_ID %d :: OUT OF SYNC\n", i);
-            }
+            Telemetry_Desync(sockets.telemetry);
+            Report(sockets);
+            sockets.is_out_of_sync = true;
         }
+    }
+    else if(sockets.is_stable && !sockets.bisect.is_done)
+        for(int32_t a = 0; a < COLOR_COUNT; a++)
+            for(int32_t b = a + 1; b < COLOR_COUNT; b++)
+                if(IsPlaying(sockets, a)
+                && IsPlaying(sockets, b)
+                && sockets.parity_cycles[a] == sockets.parity_cycles[b])
+                {
+                    const int32_t cycles = sockets.parity_cycles[a];
+                    if(sockets.parity[a] == sockets.parity[b])
+                    {
+                        if(sockets.agreed[a] < cycles || sockets.agreed[b] < cycles)
+                            Telemetry_Check(sockets.telemetry, true);
+                        sockets.agreed[a] = UTIL_MAX(sockets.agreed[a], cycles);
+                        sockets.agreed[b] = UTIL_MAX(sockets.agreed[b], cycles);
+                    }
+                    else
+                    {
+                        Telemetry_Check(sockets.telemetry, false);
+                        const int32_t agreed = UTIL_MIN(sockets.agreed[a], sockets.agreed[b]);
+                        const int32_t lo = UTIL_MAX(agreed, cycles - CONFIG_PARITY_HISTORY / 2);
+                        sockets.bisect = Bisect_Start(a, b, lo, cycles);
+                        return sockets;
+                    }
+                }
+    return sockets;
 }
 
-static Sockets CountConnectedPlayers(Sockets sockets)
+int32_t Sockets_Connected(const Sockets sockets)
 {
     int32_t count = 0;
     for(int32_t i = 0; i < COLOR_COUNT; i++)
@@ -210,7 +709,12 @@ static Sockets CountConnectedPlayers(Sockets sockets)
         if(socket != NULL)
             count++;
     }
-    sockets.users_connected = count;
+    return count;
+}
+
+static Sockets CountConnectedPlayers(Sockets sockets)
+{
+    sockets.users_connected = Sockets_Connected(sockets);
     return sockets;
 }
 
@@ -219,46 +723,128 @@ static bool GetGameRunning(const Sockets sockets)
     return sockets.users_connected == sockets.users;
 }
 
-Sockets Sockets_Relay(Sockets sockets, const int32_t cycles, const int32_t interval, const bool quiet)
+static Sockets CatchUp(Sockets sockets)
+{
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(sockets.catching_up[i] > 0 && sockets.cycles[i] >= sockets.catching_up[i])
+            sockets.catching_up[i] = 0;
+    return sockets;
+}
+
+// THE CLIENT IN STEP THAT IS FURTHEST ALONG, OR -1.
+static int32_t GetDonor(const Sockets sockets)
+{
+    int32_t donor = -1;
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(IsPlaying(sockets, i) && (donor == -1 || sockets.cycles[i] > sockets.cycles[donor]))
+            donor = i;
+    return donor;
+}
+
+// ONE CLIENT IS BROUGHT BACK AT A TIME, FROM THE CLIENT IN STEP THAT IS FURTHEST ALONG. WITHOUT A
+// CLIENT LEFT THAT IS NOT REJOINING THERE IS NO MATCH TO REJOIN, AND THE LOBBY STARTS OVER.
+static Sockets Readmit(Sockets sockets)
 {
-    if(ShouldRelay(cycles, interval))
+    if(sockets.rejoin.is_active)
     {
-        const int32_t setpoint = GetCycleSetpoint(sockets);
-        const int32_t max_cycle = GetCycleMax(sockets);
-        const int32_t max_ping = GetPingMax(sockets);
-        sockets = CalculateControlChars(sockets, setpoint);
-        sockets = CheckStability(sockets, setpoint);
-        sockets = CountConnectedPlayers(sockets);
-        const bool game_running = GetGameRunning(sockets);
-        if(!quiet)
-            Print(sockets, setpoint, max_ping);
-        CheckParity(sockets);
-        Send(sockets, max_cycle, max_ping, game_running);
-        return Clear(sockets);
+        sockets.rejoin = Rejoin_Wait(sockets.rejoin);
+        return sockets;
+    }
+    int32_t slot = -1;
+    int32_t others = 0;
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+        if(sockets.socket[i])
+        {
+            if(sockets.is_rejoining[i])
+                slot = (slot == -1) ? i : slot;
+            else
+                others++;
+        }
+    if(slot == -1)
+        return sockets;
+    const int32_t donor = GetDonor(sockets);
+    if(others == 0)
+    {
+        sockets.is_started = false;
+        for(int32_t i = 0; i < COLOR_COUNT; i++)
+            sockets.is_rejoining[i] = false;
+    }
+    else if(donor != -1)
+    {
+        sockets.rejoin = Rejoin_Start(sockets.rejoin, slot, donor, sockets.exec_cycle + 1);
+        sockets.exec_cycle = sockets.rejoin.cycles;
     }
     return sockets;
 }
 
+// SPECTATORS' KEYFRAMES ARE ASKED FOR JUST AS A REJOIN'S SNAPSHOT IS, BUT NEVER DURING ONE, AS THE
+// DONOR TAKES ONE SNAPSHOT AT A TIME.
+static Sockets Key(Sockets sockets)
+{
+    if(sockets.spectators
+    && sockets.is_started
+    && sockets.is_stable
+    && !sockets.rejoin.is_active
+    && Spectators_IsDue(sockets.spectators))
+    {
+        const int32_t donor = GetDonor(sockets);
+        if(donor != -1)
+        {
+            Spectators_Ask(sockets.spectators, donor, sockets.exec_cycle + 1);
+            sockets.exec_cycle = sockets.exec_cycle + 1;
+        }
+    }
+    return sockets;
+}
+
+// TURNS NEVER EXECUTE BEFORE ONE ALREADY SENT, NOR BEFORE A SNAPSHOT BEING TAKEN. WITH ROLLBACK
+// THE CLIENTS PREDICT RATHER THAN WAIT, SO TURNS EXECUTE AS SOON AS THEY CAN, AND ARRIVE LATE.
+static int32_t GetExecCycle(const Sockets sockets, const int32_t max_cycle, const int32_t lead)
+{
+    const int32_t offset = sockets.is_rollback ? CONFIG_ROLLBACK_LEAD : lead;
+    return UTIL_MAX(sockets.exec_cycle, max_cycle + offset);
+}
+
+Sockets Sockets_Relay(Sockets sockets, const bool quiet)
+{
+    const int32_t setpoint = GetCycleSetpoint(sockets);
+    const int32_t max_cycle = GetCycleMax(sockets);
+    const int32_t lead = GetLead(sockets);
+    sockets = CheckStability(sockets, setpoint);
+    sockets = CountConnectedPlayers(sockets);
+    const bool game_running = GetGameRunning(sockets);
+    sockets.is_started = sockets.is_started || game_running;
+    if(!quiet)
+        Print(sockets, setpoint, lead);
+    sockets = CheckParity(sockets);
+    sockets = CatchUp(sockets);
+    sockets = Readmit(sockets);
+    sockets = Key(sockets);
+    sockets.exec_cycle = GetExecCycle(sockets, max_cycle, lead);
+    sockets = Deal(sockets);
+    const uint64_t t0 = SDL_GetPerformanceCounter();
+    sockets = Send(sockets, setpoint, sockets.exec_cycle, game_running);
+    sockets = Pace(sockets);
+    Flush(sockets);
+    sockets = Sweep(sockets);
+    const uint64_t t1 = SDL_GetPerformanceCounter();
+    Telemetry_Turn(sockets.telemetry, sockets.turn, (int32_t) ((t1 - t0) * 1000000 / SDL_GetPerformanceFrequency()));
+    Measure(sockets, setpoint);
+    if(sockets.spectators)
+        Spectate(sockets, setpoint, sockets.exec_cycle, game_running);
+    return Clear(sockets);
+}
+
 Sockets Sockets_Accept(const Sockets sockets)
 {
     const TCPsocket client = SDLNet_TCP_Accept(sockets.self);
     return (client != NULL)
-        ? Add(sockets, client)
+        ? Sockets_Adopt(sockets, Wire_Make(client))
         : sockets;
 }
 
-void Sockets_Ping(const Sockets ping, const int32_t timeout)
+void Sockets_AcceptSpectator(const Sockets sockets)
 {
-    if(SDLNet_CheckSockets(ping.set, timeout))
-        for(int32_t i = 0; i < COLOR_COUNT; i++)
-        {
-            TCPsocket socket = ping.socket[i];
-            if(SDLNet_SocketReady(socket))
-            {
-                int32_t temp = 0;
-                const int32_t size = sizeof(temp);
-                SDLNet_TCP_Recv(socket, &temp, size);
-                SDLNet_TCP_Send(socket, &temp, size);
-            }
-        }
+    if(sockets.spectators)
+        Spectators_Accept(sockets.spectators);
 }
@@ -1,37 +1,116 @@
 #pragma once
 
 #include "Packet.h"
+#include "Wire.h"
+#include "Poll.h"
+#include "Join.h"
+#include "Link.h"
+#include "Lead.h"
+#include "Bisect.h"
+#include "Rejoin.h"
+#include "Spectators.h"
+#include "Telemetry.h"
+#include "Codec.h"
+#include "Huffman.h"
+#include "Commands.h"
 
 #include <stdint.h>
 #include <stdbool.h>
 #include <SDL2/SDL_net.h>
 
+// WHEN WATCHED, SLOTS ARE TAGGED FROM THE BASE TAG UP, FOLLOWED BY THE LISTENING SOCKET,
+// THE UDP SOCKET, AND THE SPECTATORS' LISTENING SOCKET.
+//
+// A CLIENT ADOPTED ONCE THE MATCH HAS STARTED IS REJOINING UNTIL ITS SNAPSHOT IS THROUGH, AND THEN
+// CATCHING UP UNTIL IT REPORTS THE CYCLE OF ITS LAST BACKLOGGED TURN. UNTIL THEN IT NEITHER MOVES
+// THE SETPOINT NOR TAKES PART IN THE PARITY CHECK.
+//
+// A TURN CARRIES ONE COMMAND PER SLOT. THE REST WAIT IN THE SLOT'S QUEUE FOR THE NEXT STABLE TURNS,
+// AS AN UNSTABLE TURN CARRIES NONE. EVERY TURN TELLS A CLIENT THE SEQUENCE OF THE LAST OF ITS COMMANDS
+// THE SERVER DROPPED, AS NO TURN WILL EVER CARRY THAT ONE.
+//
+// SPECTATORS ARE KEPT APART FROM THE SLOTS, AND ARE SENT EVERY TURN ONLY ONCE THE CLIENTS HAVE THEIRS.
+//
+// A COMPRESSING SERVER KEEPS A CODEC PER CHANNEL OF EVERY SLOT. A REJOIN BACKLOG IS SPLICED INTO A
+// STREAM THE CODEC NEVER SAW, SO ITS TURNS STAY WHOLE. THE SPECTATORS' STREAM KEEPS A CODEC OF ITS OWN.
+
+#define SOCKETS_TAGS (COLOR_COUNT + 3)
+
 typedef struct
 {
     int32_t cycles[COLOR_COUNT];
     int32_t queue_size[COLOR_COUNT];
     int32_t pings[COLOR_COUNT];
+    uint32_t stamp[COLOR_COUNT];
+    uint32_t stamped[COLOR_COUNT];
     uint64_t parity[COLOR_COUNT];
+    int32_t parity_cycles[COLOR_COUNT];
+    Parity probed[COLOR_COUNT];
     TCPsocket socket[COLOR_COUNT];
-    char control[COLOR_COUNT];
+    Wire* wire[COLOR_COUNT];
+    Link* link[COLOR_COUNT];
+    bool is_linked[COLOR_COUNT];
+    Commands commands[COLOR_COUNT];
+    int32_t dropped[COLOR_COUNT];
     TCPsocket self;
+    UDPsocket udp;
+    UDPpacket* datagram;
     Packet packet;
+    Lead* lead;
+    int32_t agreed[COLOR_COUNT];
+    Bisect bisect;
+    bool is_rejoining[COLOR_COUNT];
+    int32_t catching_up[COLOR_COUNT];
+    Rejoin rejoin;
+    Spectators* spectators;
+    Telemetry* telemetry;
+    Codec* codec[COLOR_COUNT];
+    Huffman* huffman;
+    int32_t compress;
     SDLNet_SocketSet set;
+    Poll poll;
+    int32_t tag;
+    bool is_polled;
+    int32_t match;
     int32_t turn;
+    int32_t exec_cycle;
     int32_t users_connected;
     int32_t users;
     bool is_stable;
+    bool is_started;
+    bool is_rollback;
+    bool is_out_of_sync;
 }
 Sockets;
 
+Sockets Sockets_Make(const int32_t match, const int32_t users);
+
 Sockets Sockets_Init(const int32_t port, const int32_t users);
 
 void Sockets_Free(Sockets);
 
+Sockets Sockets_EnableUdp(Sockets, const int32_t port);
+
+Sockets Sockets_EnableSpectators(Sockets, const int32_t port, const int32_t delay);
+
+Sockets Sockets_EnableTelemetry(Sockets, const char* const path);
+
+Sockets Sockets_EnableCompression(Sockets, const int32_t level);
+
+Sockets Sockets_Watch(Sockets, const Poll, const int32_t tag);
+
+Sockets Sockets_Read(const Sockets, const int32_t index);
+
+Sockets Sockets_ReadDatagrams(const Sockets);
+
 Sockets Sockets_Service(const Sockets, const int32_t timeout);
 
-Sockets Sockets_Relay(const Sockets, const int32_t cycles, const int32_t interval, const bool quiet);
+Sockets Sockets_Relay(const Sockets, const bool quiet);
 
 Sockets Sockets_Accept(const Sockets);
 
-void Sockets_Ping(const Sockets, const int32_t timeout);
+void Sockets_AcceptSpectator(const Sockets);
+
+Sockets Sockets_Adopt(Sockets, Wire* const);
+
+int32_t Sockets_Connected(const Sockets);
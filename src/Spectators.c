@@ -0,0 +1,269 @@
+#include "Spectators.h"
+
+#include "Config.h"
+#include "Util.h"
+
+#include <string.h>
+
+// OFTEN ENOUGH THAT ONE KEYFRAME IS ALWAYS RELEASED WHILE THE NEXT ONES WAIT OUT THE DELAY.
+Spectators* Spectators_Make(const int32_t port, const int32_t delay)
+{
+    IPaddress ip;
+    SDLNet_ResolveHost(&ip, NULL, port);
+    Spectators* const spectators = UTIL_ALLOC(Spectators, 1);
+    spectators->self = SDLNet_TCP_Open(&ip);
+    if(spectators->self == NULL)
+        Util_Bomb("SERVER - COULD NOT LISTEN FOR SPECTATORS ON PORT %d\n", port);
+    spectators->delay = UTIL_MAX(0, delay);
+    spectators->mark = UTIL_ALLOC(int32_t, spectators->delay + 1);
+    spectators->interval = UTIL_MAX(CONFIG_SPECTATORS_KEYFRAME_TURNS, spectators->delay / (SPECTATORS_KEYFRAMES - 2) + 1);
+    spectators->last = -1;
+    return spectators;
+}
+
+static void Close(Wire* const wire)
+{
+    TCPsocket socket = wire->socket;
+    Wire_Free(wire);
+    SDLNet_TCP_Close(socket);
+}
+
+void Spectators_Free(Spectators* const spectators)
+{
+    for(int32_t i = 0; i < spectators->count; i++)
+        Close(spectators->wire[i]);
+    for(int32_t i = 0; i < SPECTATORS_KEYFRAMES; i++)
+        Keyframe_Free(spectators->keyframe[i]);
+    SDLNet_TCP_Close(spectators->self);
+    free(spectators->wire);
+    free(spectators->cursor);
+    free(spectators->key);
+    free(spectators->keyed);
+    free(spectators->caught);
+    free(spectators->stream);
+    free(spectators->mark);
+    free(spectators);
+}
+
+void Spectators_Accept(Spectators* const spectators)
+{
+    const TCPsocket client = SDLNet_TCP_Accept(spectators->self);
+    if(client == NULL)
+        return;
+    if(spectators->count == spectators->max)
+    {
+        spectators->max = (spectators->max == 0) ? 16 : 2 * spectators->max;
+        spectators->wire = UTIL_REALLOC(spectators->wire, Wire*, spectators->max);
+        spectators->cursor = UTIL_REALLOC(spectators->cursor, int32_t, spectators->max);
+        spectators->key = UTIL_REALLOC(spectators->key, int32_t, spectators->max);
+        spectators->keyed = UTIL_REALLOC(spectators->keyed, int32_t, spectators->max);
+        spectators->caught = UTIL_REALLOC(spectators->caught, int32_t, spectators->max);
+    }
+    const int32_t i = spectators->count++;
+    spectators->wire[i] = Wire_Make(client);
+    spectators->cursor[i] = -1;
+    spectators->key[i] = -1;
+    spectators->keyed[i] = 0;
+    spectators->caught[i] = spectators->turns;
+}
+
+static int32_t GetEnd(const Spectators* const spectators)
+{
+    return spectators->base + spectators->size;
+}
+
+static bool IsSending(const Spectators* const spectators, const int32_t slot)
+{
+    for(int32_t i = 0; i < spectators->count; i++)
+        if(spectators->key[i] == slot)
+            return true;
+    return false;
+}
+
+// THE OLDEST KEYFRAME NO SPECTATOR IS HALFWAY THROUGH, OR -1.
+static int32_t GetFreeSlot(const Spectators* const spectators)
+{
+    int32_t slot = -1;
+    for(int32_t i = 0; i < SPECTATORS_KEYFRAMES; i++)
+        if(!IsSending(spectators, i)
+        && (slot == -1 || spectators->keyframe[i].turn < spectators->keyframe[slot].turn))
+            slot = i;
+    return slot;
+}
+
+// DUE AT ONCE AFTER A KEYFRAME WAS GIVEN UP ON.
+bool Spectators_IsDue(const Spectators* const spectators)
+{
+    if(spectators->last == -1)
+        return true;
+    const Keyframe keyframe = spectators->keyframe[spectators->last];
+    return !keyframe.is_active
+        && (!keyframe.is_done || spectators->turns - keyframe.turn >= spectators->interval)
+        && GetFreeSlot(spectators) != -1;
+}
+
+// THE TURNS AFTER THE OFFSET ARE DELTAS AGAINST NOTHING.
+void Spectators_Ask(Spectators* const spectators, const int32_t donor, const int32_t cycles)
+{
+    static Codec zero;
+    spectators->codec = zero;
+    const int32_t slot = GetFreeSlot(spectators);
+    Keyframe* const keyframe = &spectators->keyframe[slot];
+    *keyframe = Keyframe_Start(*keyframe, donor, cycles, GetEnd(spectators), spectators->turns);
+    spectators->last = slot;
+}
+
+// THE CYCLE CLIENT I IS ASKED TO SNAPSHOT AT, OR ZERO.
+int32_t Spectators_GetSnapshot(const Spectators* const spectators, const int32_t i)
+{
+    if(spectators->last == -1)
+        return 0;
+    const Keyframe keyframe = spectators->keyframe[spectators->last];
+    return (keyframe.is_active && keyframe.donor == i) ? keyframe.cycles : 0;
+}
+
+void Spectators_Take(Spectators* const spectators, const int32_t i, const Chunk chunk, const Bytes* const bytes)
+{
+    if(spectators->last != -1)
+    {
+        Keyframe* const keyframe = &spectators->keyframe[spectators->last];
+        *keyframe = Keyframe_Take(*keyframe, i, chunk, bytes);
+    }
+}
+
+// A DONOR THAT DROPPED IS GIVEN UP ON AT ONCE.
+void Spectators_Forget(Spectators* const spectators, const int32_t i)
+{
+    if(spectators->last != -1 && spectators->keyframe[spectators->last].donor == i)
+    {
+        Keyframe* const keyframe = &spectators->keyframe[spectators->last];
+        *keyframe = Keyframe_Stop(*keyframe);
+    }
+}
+
+static void Append(Spectators* const spectators, const Bytes* const bytes)
+{
+    if(spectators->size + WIRE_PREFIX + bytes->size > spectators->stream_max)
+    {
+        spectators->stream_max = UTIL_MAX(2 * spectators->stream_max, spectators->size + WIRE_PREFIX + bytes->size);
+        spectators->stream = UTIL_REALLOC(spectators->stream, uint8_t, spectators->stream_max);
+    }
+    spectators->size += Wire_Frame(&spectators->stream[spectators->size], bytes);
+}
+
+// THE END OF THE NEWEST TURN THE DELAY HAS PASSED.
+static int32_t GetReleased(const Spectators* const spectators)
+{
+    const int32_t turn = spectators->turns - 1 - spectators->delay;
+    return (turn >= 0) ? spectators->mark[turn % (spectators->delay + 1)] : 0;
+}
+
+static int32_t GetNewestKeyframe(const Spectators* const spectators, const int32_t released)
+{
+    int32_t slot = -1;
+    for(int32_t i = 0; i < SPECTATORS_KEYFRAMES; i++)
+    {
+        const Keyframe keyframe = spectators->keyframe[i];
+        if(keyframe.is_done
+        && keyframe.offset >= spectators->base
+        && keyframe.offset <= released
+        && (slot == -1 || keyframe.offset > spectators->keyframe[slot].offset))
+            slot = i;
+    }
+    return slot;
+}
+
+// A KEYFRAME MAY SPLIT A FRAME BETWEEN TWO TURNS, BUT NOTHING ELSE GOES TO THE SPECTATOR IN BETWEEN.
+// A SPECTATOR IS CAUGHT UP WHILE IT WAITS FOR A KEYFRAME, AND ONCE IT HAS TAKEN ALL THAT WAS RELEASED.
+static void Send(Spectators* const spectators, const int32_t i, const int32_t released)
+{
+    Wire* const wire = spectators->wire[i];
+    if(spectators->cursor[i] == -1)
+    {
+        const int32_t slot = GetNewestKeyframe(spectators, released);
+        spectators->caught[i] = spectators->turns;
+        if(slot == -1)
+            return;
+        spectators->key[i] = slot;
+        spectators->keyed[i] = 0;
+        spectators->cursor[i] = spectators->keyframe[slot].offset;
+    }
+    if(spectators->key[i] != -1)
+    {
+        const Keyframe keyframe = spectators->keyframe[spectators->key[i]];
+        const int32_t size = UTIL_MIN(CONFIG_SPECTATORS_KEYFRAME_BYTES, keyframe.size - spectators->keyed[i]);
+        spectators->keyed[i] += Wire_Write(wire, &keyframe.frames[spectators->keyed[i]], size);
+        if(spectators->keyed[i] < keyframe.size)
+            return;
+        spectators->key[i] = -1;
+    }
+    const int32_t cursor = spectators->cursor[i];
+    if(cursor < released)
+        spectators->cursor[i] += Wire_Write(wire, &spectators->stream[cursor - spectators->base], released - cursor);
+    if(spectators->cursor[i] == released)
+        spectators->caught[i] = spectators->turns;
+}
+
+static bool IsGone(const Spectators* const spectators, const int32_t i)
+{
+    return spectators->wire[i]->is_closed
+        || spectators->turns - spectators->caught[i] > CONFIG_SPECTATORS_BEHIND_TURNS;
+}
+
+static void Remove(Spectators* const spectators, const int32_t i)
+{
+    Close(spectators->wire[i]);
+    const int32_t last = --spectators->count;
+    spectators->wire[i] = spectators->wire[last];
+    spectators->cursor[i] = spectators->cursor[last];
+    spectators->key[i] = spectators->key[last];
+    spectators->keyed[i] = spectators->keyed[last];
+    spectators->caught[i] = spectators->caught[last];
+}
+
+// ONLY ONCE HALF THE STREAM IS DEAD, SO THE MOVE IS PAID FOR BY THE TURNS BEHIND IT.
+static void Trim(Spectators* const spectators, const int32_t released)
+{
+    int32_t cut = released;
+    for(int32_t i = 0; i < spectators->count; i++)
+        if(spectators->cursor[i] != -1)
+            cut = UTIL_MIN(cut, spectators->cursor[i]);
+    for(int32_t i = 0; i < SPECTATORS_KEYFRAMES; i++)
+    {
+        const Keyframe keyframe = spectators->keyframe[i];
+        if(keyframe.is_active || (keyframe.is_done && keyframe.offset >= spectators->base))
+            cut = UTIL_MIN(cut, keyframe.offset);
+    }
+    const int32_t dead = cut - spectators->base;
+    if(dead > 0 && 2 * dead >= spectators->size)
+    {
+        memmove(spectators->stream, &spectators->stream[dead], (size_t) (spectators->size - dead));
+        spectators->size -= dead;
+        spectators->base = cut;
+    }
+}
+
+void Spectators_Relay(Spectators* const spectators, const Packet packet, const int32_t compress, const Huffman* const huffman)
+{
+    Bytes bytes;
+    Bytes_Clear(&bytes);
+    if(compress > CODEC_OFF)
+        Packet_EncodeDelta(packet, &spectators->codec, huffman, &bytes);
+    else
+        Packet_Encode(packet, &bytes);
+    Append(spectators, &bytes);
+    spectators->mark[spectators->turns % (spectators->delay + 1)] = GetEnd(spectators);
+    spectators->turns++;
+    if(spectators->last != -1)
+    {
+        Keyframe* const keyframe = &spectators->keyframe[spectators->last];
+        *keyframe = Keyframe_Wait(*keyframe);
+    }
+    const int32_t released = GetReleased(spectators);
+    for(int32_t i = 0; i < spectators->count; i++)
+        Send(spectators, i, released);
+    for(int32_t i = spectators->count - 1; i >= 0; i--)
+        if(IsGone(spectators, i))
+            Remove(spectators, i);
+    Trim(spectators, released);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Codec.h"
+#include "Huffman.h"
+#include "Keyframe.h"
+#include "Packet.h"
+#include "Wire.h"
+
+#include <SDL2/SDL_net.h>
+
+// READ ONLY OBSERVERS OF A MATCH. THEY CONNECT TO A PORT OF THEIR OWN, NEXT TO THE MATCH'S, SO THEY
+// NEVER TAKE A SEAT, AND THEY ARE NEVER READ FROM. EVERY TURN IS ENCODED ONCE, WITHOUT ANY CLIENT'S
+// TIMING, AND FRAMED ONTO THE END OF ONE STREAM. EVERY SPECTATOR IS SENT STRAIGHT FROM THE STREAM,
+// SO A SPECTATOR COSTS ONE SEND PER TURN AND NOTHING MORE. THE STREAM IS RELEASED THE DELAY, IN TURNS,
+// BEHIND THE MATCH.
+//
+// NO SEND WAITS ON A FULL SOCKET. EVERY SPECTATOR'S CURSOR MOVES ONLY AS FAR AS ITS SOCKET TOOK, AND
+// THE REST GOES ON A LATER TURN. A SPECTATOR NOT SENT ALL THAT WAS RELEASED FOR MORE THAN
+// CONFIG_SPECTATORS_BEHIND_TURNS IS DROPPED, SO IT CAN NEITHER HOLD BACK THE MATCH NOR THE STREAM.
+//
+// A NEW SPECTATOR STARTS FROM THE NEWEST KEYFRAME RELEASED, A FEW CHUNKS PER TURN, AND THEN THE STREAM
+// FROM THE KEYFRAME'S OFFSET ON. A PLAYING CLIENT DONATES A KEYFRAME EVERY INTERVAL, OFTEN ENOUGH THAT
+// ONE IS ALWAYS RELEASED. OFFSETS INTO THE STREAM COUNT FROM THE START OF THE MATCH, AND THE STREAM IS
+// TRIMMED BEHIND THE SLOWEST SPECTATOR AND THE OLDEST KEYFRAME.
+//
+// A COMPRESSING SERVER ENCODES THE STREAM AS DELTAS WITH A CODEC OF ITS OWN, STARTED AGAIN FROM ZERO AT
+// EVERY KEYFRAME'S OFFSET, SO A SPECTATOR STARTING FROM A KEYFRAME DECODES WITH A ZEROED CODEC LIKE
+// ANY NEW CLIENT.
+
+#define SPECTATORS_PORT_OFFSET (1)
+
+#define SPECTATORS_KEYFRAMES (4)
+
+typedef struct
+{
+    TCPsocket self;
+    Wire** wire;
+    int32_t* cursor;
+    int32_t* key;
+    int32_t* keyed;
+    int32_t* caught;
+    int32_t count;
+    int32_t max;
+    uint8_t* stream;
+    int32_t size;
+    int32_t stream_max;
+    int32_t base;
+    int32_t* mark;
+    int32_t delay;
+    int32_t turns;
+    int32_t interval;
+    int32_t last;
+    Keyframe keyframe[SPECTATORS_KEYFRAMES];
+    Codec codec;
+}
+Spectators;
+
+Spectators* Spectators_Make(const int32_t port, const int32_t delay);
+
+void Spectators_Free(Spectators* const);
+
+void Spectators_Accept(Spectators* const);
+
+bool Spectators_IsDue(const Spectators* const);
+
+void Spectators_Ask(Spectators* const, const int32_t donor, const int32_t cycles);
+
+int32_t Spectators_GetSnapshot(const Spectators* const, const int32_t i);
+
+void Spectators_Take(Spectators* const, const int32_t i, const Chunk, const Bytes* const);
+
+void Spectators_Forget(Spectators* const, const int32_t i);
+
+void Spectators_Relay(Spectators* const, const Packet, const int32_t compress, const Huffman* const);
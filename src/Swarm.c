@@ -0,0 +1,226 @@
+#include "Swarm.h"
+
+#include "Config.h"
+#include "Packet.h"
+#include "Util.h"
+
+#include <SDL2/SDL_timer.h>
+#include <stdio.h>
+
+// EVERY BOT IS SEATED BEFORE THE FIRST FRAME, SO A FULL SERVER FAILS AT ONCE.
+Swarm* Swarm_Make(const char* const host, const int32_t port, const int32_t count, const int32_t match, const int32_t users, const Script script)
+{
+    Swarm* const swarm = UTIL_ALLOC(Swarm, 1);
+    swarm->sock = UTIL_ALLOC(Sock, count);
+    swarm->clock = UTIL_ALLOC(Clock, count);
+    swarm->script = UTIL_ALLOC(Script, count);
+    swarm->is_running = UTIL_ALLOC(bool, count);
+    swarm->cycles = UTIL_ALLOC(int32_t, count);
+    swarm->newest = UTIL_ALLOC(int32_t, count);
+    swarm->issued = UTIL_ALLOC(uint32_t, count * SWARM_ISSUED);
+    swarm->held = UTIL_ALLOC(uint32_t, count);
+    swarm->last = UTIL_ALLOC(uint32_t, count);
+    swarm->turns = UTIL_ALLOC(int32_t, count);
+    swarm->commands = UTIL_ALLOC(int32_t, count);
+    swarm->rtt = UTIL_ALLOC(Histogram, count);
+    swarm->command = UTIL_ALLOC(Histogram, count);
+    swarm->gap = UTIL_ALLOC(Histogram, count);
+    swarm->stall = UTIL_ALLOC(Histogram, count);
+    for(int32_t i = 0; i < count; i++)
+    {
+        swarm->sock[i] = Sock_Join(Sock_Connect(host, port), match, users);
+        if(swarm->sock[i].match == 0)
+            Util_Bomb("SWARM - BOT %d WAS NOT SEATED\n", i);
+        swarm->clock[i] = Clock_Make(SDL_GetTicks());
+        swarm->script[i] = Script_ForBot(script, i);
+        swarm->count++;
+    }
+    return swarm;
+}
+
+void Swarm_Free(Swarm* const swarm)
+{
+    for(int32_t i = 0; i < swarm->count; i++)
+        Sock_Disconnect(swarm->sock[i]);
+    free(swarm->sock);
+    free(swarm->clock);
+    free(swarm->script);
+    free(swarm->is_running);
+    free(swarm->cycles);
+    free(swarm->newest);
+    free(swarm->issued);
+    free(swarm->held);
+    free(swarm->last);
+    free(swarm->turns);
+    free(swarm->commands);
+    free(swarm->rtt);
+    free(swarm->command);
+    free(swarm->gap);
+    free(swarm->stall);
+    free(swarm);
+}
+
+// A COMMAND SHOWS UP UNDER THE BOT'S OWN SLOT IN THE STABLE TURN THE SERVER DEALS IT TO, AND IS TIMED
+// BY ITS SEQUENCE FROM WHEN THAT COMMAND WAS ISSUED. THE TURN STILL HAS TO WAIT FOR ITS CYCLE TO COME
+// AROUND BEFORE THE COMMAND TAKES EFFECT. A COMMAND THE SERVER MERGED INTO A LATER ONE IS NEVER DEALT,
+// AND SO NEVER TIMED.
+static void Listen(Swarm* const swarm, const int32_t i, const uint32_t now)
+{
+    const Sock sock = swarm->sock[i];
+    for(Packet packet = Packet_Get(sock); packet.turn > 0; packet = Packet_Get(sock))
+    {
+        swarm->turns[i]++;
+        if(swarm->last[i] != 0)
+            Histogram_Add(&swarm->gap[i], (int32_t) (now - swarm->last[i]));
+        swarm->last[i] = now;
+        if(packet.echo != 0)
+            Histogram_Add(&swarm->rtt[i], UTIL_MAX(0, (int32_t) (now - packet.echo) - packet.hold));
+        swarm->is_running[i] = swarm->is_running[i] || packet.game_running;
+        swarm->clock[i] = Clock_Observe(swarm->clock[i], packet.setpoint, Rtt_GetSmooth(sock.rtt));
+        if(Packet_IsStable(packet))
+        {
+            swarm->newest[i] = UTIL_MAX(swarm->newest[i], packet.exec_cycle);
+            const int32_t id = UTIL_MIN(UTIL_MAX(packet.client_id, 0), COLOR_COUNT - 1);
+            const Overview dealt = packet.overview[id];
+            uint32_t* const issued = &swarm->issued[i * SWARM_ISSUED + UTIL_WRAP(dealt.sequence, SWARM_ISSUED)];
+            if(Overview_UsedAction(dealt) && *issued != 0)
+            {
+                const int32_t wait = UTIL_MAX(0, packet.exec_cycle - swarm->cycles[i]) * CONFIG_MAIN_LOOP_SPEED_MS;
+                Histogram_Add(&swarm->command[i], (int32_t) (now - *issued) + wait);
+                *issued = 0;
+            }
+        }
+    }
+}
+
+// THE COMMAND IS A RIGHT CLICK SOMEWHERE NEW EVERY TIME, SO A BURST OF THEM QUEUED ON THE SERVER
+// MERGES INTO THE LAST ONE. NONE ARE ISSUED BEFORE THE FIRST STABLE TURN, AS UNTIL THEN THE SERVER
+// DROPS THEM.
+static void Act(Swarm* const swarm, const int32_t i, const uint32_t now)
+{
+    static Overview zero;
+    const int32_t frame = swarm->frame + i;
+    const Script script = swarm->script[i];
+    Overview overview = zero;
+    overview.cycles = swarm->cycles[i];
+    overview.ping = Rtt_GetLast(swarm->sock[i].rtt);
+    if(swarm->newest[i] > 0 && Script_Commands(script, frame))
+    {
+        Overview command = overview;
+        command.event.mouse_ru = true;
+        command.mouse_cursor.x = (frame * 37) % 800;
+        command.mouse_cursor.y = (frame * 17) % 600;
+        command.sequence = ++swarm->commands[i];
+        Sock_SendCommand(swarm->sock[i], command);
+        swarm->issued[i * SWARM_ISSUED + UTIL_WRAP(command.sequence, SWARM_ISSUED)] = now;
+    }
+    if(Script_Beats(script, frame))
+        Sock_SendHeartbeat(swarm->sock[i], overview);
+}
+
+static void Advance(Swarm* const swarm, const int32_t i, const uint32_t now)
+{
+    if(!swarm->is_running[i])
+        return;
+    swarm->clock[i] = Clock_Advance(swarm->clock[i], swarm->cycles[i], now);
+    for(int32_t tick = 0; tick < swarm->clock[i].ticks; tick++)
+    {
+        if(swarm->newest[i] > 0 && swarm->cycles[i] >= swarm->newest[i])
+        {
+            if(swarm->held[i] == 0)
+                swarm->held[i] = now;
+            return;
+        }
+        if(swarm->held[i] != 0)
+        {
+            Histogram_Add(&swarm->stall[i], (int32_t) (now - swarm->held[i]));
+            swarm->held[i] = 0;
+        }
+        swarm->cycles[i]++;
+    }
+}
+
+void Swarm_Step(Swarm* const swarm)
+{
+    for(int32_t i = 0; i < swarm->count; i++)
+    {
+        const uint32_t now = SDL_GetTicks();
+        Listen(swarm, i, now);
+        Act(swarm, i, now);
+        Advance(swarm, i, now);
+    }
+    swarm->frame++;
+}
+
+static void Total(const Swarm* const swarm, const Script script, const char* const name)
+{
+    static Histogram zero;
+    Histogram rtt = zero;
+    Histogram command = zero;
+    Histogram gap = zero;
+    Histogram stall = zero;
+    int32_t bots = 0;
+    int32_t turns = 0;
+    int32_t commands = 0;
+    for(int32_t i = 0; i < swarm->count; i++)
+        if(script == SCRIPT_COUNT || swarm->script[i] == script)
+        {
+            Histogram_Merge(&rtt, &swarm->rtt[i]);
+            Histogram_Merge(&command, &swarm->command[i]);
+            Histogram_Merge(&gap, &swarm->gap[i]);
+            Histogram_Merge(&stall, &swarm->stall[i]);
+            turns += swarm->turns[i];
+            commands += swarm->commands[i];
+            bots++;
+        }
+    if(bots == 0)
+        return;
+    printf("SWARM :: %-6s :: %4d BOTS :: TURNS %7d :: COMMANDS %6d :: RTT %3d %3d %4d MS :: COMMAND %3d %3d %4d MS :: GAP %3d %4d MS :: STALLS %5d %4d %4d %5d MS\n",
+        name, bots, turns, commands,
+        Histogram_Percentile(&rtt, 50), Histogram_Percentile(&rtt, 99), rtt.max,
+        Histogram_Percentile(&command, 50), Histogram_Percentile(&command, 99), command.max,
+        Histogram_Percentile(&gap, 99), gap.max,
+        stall.count, Histogram_Percentile(&stall, 50), Histogram_Percentile(&stall, 99), stall.max);
+}
+
+// PERCENTILES ARE P50, P99 AND THE MAXIMUM, EXCEPT FOR GAPS, WHICH ARE P99 AND THE MAXIMUM. STALLS
+// LEAD WITH THEIR COUNT.
+void Swarm_Print(const Swarm* const swarm, const bool verbose)
+{
+    if(verbose)
+        for(int32_t i = 0; i < swarm->count; i++)
+        {
+            const Histogram* const rtt = &swarm->rtt[i];
+            const Histogram* const command = &swarm->command[i];
+            const Histogram* const stall = &swarm->stall[i];
+            printf("BOT %4d :: MATCH %4d :: %-6s :: CYCLES %6d :: TURNS %5d :: RTT %3d %3d %4d MS :: COMMAND %3d %3d %4d MS :: GAP %3d %4d MS :: STALLS %4d %4d %4d %5d MS\n",
+                i, swarm->sock[i].match, Script_ToString(swarm->script[i]), swarm->cycles[i], swarm->turns[i],
+                Histogram_Percentile(rtt, 50), Histogram_Percentile(rtt, 99), rtt->max,
+                Histogram_Percentile(command, 50), Histogram_Percentile(command, 99), command->max,
+                Histogram_Percentile(&swarm->gap[i], 99), swarm->gap[i].max,
+                stall->count, Histogram_Percentile(stall, 50), Histogram_Percentile(stall, 99), stall->max);
+        }
+    for(int32_t i = 0; i < SCRIPT_MIXED; i++)
+        Total(swarm, (Script) i, Script_ToString((Script) i));
+    Total(swarm, SCRIPT_COUNT, "all");
+}
+
+// FRAMES KEEP THEIR CADENCE HOWEVER LONG THE BOTS TAKE, SO A SLOW FRAME IS MADE UP FOR. ZERO SECONDS
+// RUNS FOREVER, PRINTING THE TOTALS EVERY SO OFTEN.
+void Swarm_Run(Swarm* const swarm, const int32_t seconds)
+{
+    const uint32_t start = SDL_GetTicks();
+    uint32_t report = start;
+    for(uint32_t frame = start; seconds == 0 || (int32_t) (SDL_GetTicks() - start) < 1000 * seconds; frame += CONFIG_MAIN_LOOP_SPEED_MS)
+    {
+        Swarm_Step(swarm);
+        const int32_t ms = (int32_t) (frame + CONFIG_MAIN_LOOP_SPEED_MS - SDL_GetTicks());
+        if(ms > 0)
+            SDL_Delay(ms);
+        if(seconds == 0 && (int32_t) (SDL_GetTicks() - report) >= CONFIG_SWARM_REPORT_MS)
+        {
+            Swarm_Print(swarm, false);
+            report = SDL_GetTicks();
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Sock.h"
+#include "Clock.h"
+#include "Script.h"
+#include "Histogram.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// HEADLESS BOTS, ALL IN ONE THREAD, EACH A CLIENT TO THE SERVER IN EVERY WAY BUT THE SIMULATION. A BOT
+// JOINS, WAITS FOR ITS MATCH TO START, AND THEN KEEPS A CYCLE COUNT ON THE SERVER'S TIMELINE WITH A
+// CLOCK, AS PLAY DOES, REPORTING IT IN ITS HEARTBEATS AND ISSUING COMMANDS AS ITS SCRIPT SAYS.
+//
+// A BOT NEVER COUNTS PAST THE NEWEST TURN IN HAND, AS A LOCKSTEP CLIENT CANNOT SIMULATE A CYCLE WHOSE
+// TURNS HAVE NOT ALL ARRIVED. THE TIME ITS CLOCK IS HELD THERE IS A STALL. PER BOT, THE SWARM KEEPS
+// HISTOGRAMS OF THE RTT ECHOED IN EVERY TURN, OF THE GAPS BETWEEN TURNS, OF STALLS, AND OF COMMAND
+// LATENCY: FROM A COMMAND BEING ISSUED TO THE CYCLE ITS TURN EXECUTES AT, AS A PLAYER WOULD SEE IT.
+// THE LAST SWARM_ISSUED COMMANDS OF EVERY BOT ARE REMEMBERED BY SEQUENCE, ALONG WITH WHEN THEY WERE
+// ISSUED.
+
+#define SWARM_ISSUED (64)
+
+typedef struct
+{
+    Sock* sock;
+    Clock* clock;
+    Script* script;
+    bool* is_running;
+    int32_t* cycles;
+    int32_t* newest;
+    uint32_t* issued;
+    uint32_t* held;
+    uint32_t* last;
+    int32_t* turns;
+    int32_t* commands;
+    Histogram* rtt;
+    Histogram* command;
+    Histogram* gap;
+    Histogram* stall;
+    int32_t count;
+    int32_t frame;
+}
+Swarm;
+
+Swarm* Swarm_Make(const char* const host, const int32_t port, const int32_t count, const int32_t match, const int32_t users, const Script);
+
+void Swarm_Free(Swarm* const);
+
+void Swarm_Step(Swarm* const);
+
+void Swarm_Run(Swarm* const, const int32_t seconds);
+
+void Swarm_Print(const Swarm* const, const bool verbose);
@@ -0,0 +1,192 @@
+#include "Telemetry.h"
+
+#include "Config.h"
+#include "Util.h"
+
+#include <SDL2/SDL_timer.h>
+#include <string.h>
+
+#define NAP_MS (10)
+
+// HOW MUCH A COUNTER MOVED SINCE IT WAS LAST SEEN. A COUNTER THAT WRAPPED STILL GIVES THE RIGHT ANSWER.
+static int32_t Delta(SDL_atomic_t* const atomic, int32_t* const seen)
+{
+    const int32_t now = SDL_AtomicGet(atomic);
+    const int32_t delta = (int32_t) ((uint32_t) now - (uint32_t) *seen);
+    *seen = now;
+    return delta;
+}
+
+static Histogram Collect(SDL_atomic_t* const atomic, int32_t* const seen)
+{
+    static Histogram zero;
+    Histogram histogram = zero;
+    for(int32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+        const int32_t count = Delta(&atomic[i], &seen[i]);
+        const int32_t edge = Histogram_GetEdge(i);
+        histogram.bucket[i] = count;
+        histogram.count += count;
+        histogram.sum += (int64_t) count * edge;
+        if(count > 0)
+            histogram.max = edge;
+    }
+    return histogram;
+}
+
+static void WriteJson(Telemetry* const telemetry, const uint32_t ms, const Histogram send)
+{
+    FILE* const file = telemetry->file;
+    const int32_t turn = SDL_AtomicGet(&telemetry->turn);
+    fprintf(file, "{\"ms\":%u,\"turn\":%d,\"turns\":%d,", ms, turn, send.count);
+    fprintf(file, "\"send_us\":{\"p50\":%d,\"p99\":%d,\"max\":%d},",
+        Histogram_Percentile(&send, 50), Histogram_Percentile(&send, 99), send.max);
+    fprintf(file, "\"parity\":{\"agreed\":%d,\"differed\":%d,\"desynced\":%d},",
+        Delta(&telemetry->agreed, &telemetry->seen_agreed),
+        Delta(&telemetry->differed, &telemetry->seen_differed),
+        Delta(&telemetry->desynced, &telemetry->seen_desynced));
+    fprintf(file, "\"clients\":[");
+    bool is_first = true;
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+    {
+        const int32_t in = Delta(&telemetry->bytes_in[i], &telemetry->seen_in[i]);
+        const int32_t out = Delta(&telemetry->bytes_out[i], &telemetry->seen_out[i]);
+        const Histogram rtt = Collect(telemetry->rtt[i], telemetry->seen_rtt[i]);
+        if(!SDL_AtomicGet(&telemetry->connected[i]))
+            continue;
+        fprintf(file, "%s{\"slot\":%d,\"in\":%d,\"out\":%d,\"queue\":%d,\"lag\":%d,\"rtt\":{\"p50\":%d,\"p99\":%d,\"max\":%d,\"samples\":%d}}",
+            is_first ? "" : ",", i, in, out,
+            SDL_AtomicGet(&telemetry->queue[i]), SDL_AtomicGet(&telemetry->lag[i]),
+            Histogram_Percentile(&rtt, 50), Histogram_Percentile(&rtt, 99), rtt.max, rtt.count);
+        is_first = false;
+    }
+    fprintf(file, "]}\n");
+}
+
+// THE COLUMNS FOR THE MATCH ARE REPEATED ON EVERY ROW, SO EVERY ROW STANDS ALONE.
+static void WriteCsv(Telemetry* const telemetry, const uint32_t ms, const Histogram send)
+{
+    FILE* const file = telemetry->file;
+    const int32_t turn = SDL_AtomicGet(&telemetry->turn);
+    const int32_t agreed = Delta(&telemetry->agreed, &telemetry->seen_agreed);
+    const int32_t differed = Delta(&telemetry->differed, &telemetry->seen_differed);
+    const int32_t desynced = Delta(&telemetry->desynced, &telemetry->seen_desynced);
+    for(int32_t i = 0; i < COLOR_COUNT; i++)
+    {
+        const int32_t in = Delta(&telemetry->bytes_in[i], &telemetry->seen_in[i]);
+        const int32_t out = Delta(&telemetry->bytes_out[i], &telemetry->seen_out[i]);
+        const Histogram rtt = Collect(telemetry->rtt[i], telemetry->seen_rtt[i]);
+        if(!SDL_AtomicGet(&telemetry->connected[i]))
+            continue;
+        fprintf(file, "%u,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d\n",
+            ms, turn, send.count, Histogram_Percentile(&send, 50), Histogram_Percentile(&send, 99), send.max,
+            agreed, differed, desynced,
+            i, in, out, SDL_AtomicGet(&telemetry->queue[i]), SDL_AtomicGet(&telemetry->lag[i]),
+            Histogram_Percentile(&rtt, 50), Histogram_Percentile(&rtt, 99), rtt.max, rtt.count);
+    }
+}
+
+static void Write(Telemetry* const telemetry)
+{
+    const uint32_t ms = SDL_GetTicks() - telemetry->start;
+    const Histogram send = Collect(telemetry->send, telemetry->seen_send);
+    telemetry->is_csv
+        ? WriteCsv(telemetry, ms, send)
+        : WriteJson(telemetry, ms, send);
+    fflush(telemetry->file);
+}
+
+static int32_t Export(void* const data)
+{
+    Telemetry* const telemetry = (Telemetry*) data;
+    uint32_t due = telemetry->start + CONFIG_TELEMETRY_MS;
+    while(SDL_AtomicGet(&telemetry->is_running))
+    {
+        if((int32_t) (SDL_GetTicks() - due) >= 0)
+        {
+            Write(telemetry);
+            due += CONFIG_TELEMETRY_MS;
+        }
+        SDL_Delay(NAP_MS);
+    }
+    return 0;
+}
+
+// OPENING A NAMED PIPE WAITS FOR A READER.
+Telemetry* Telemetry_Start(const char* const path)
+{
+    Telemetry* const telemetry = UTIL_ALLOC(Telemetry, 1);
+    telemetry->file = fopen(path, "w");
+    if(telemetry->file == NULL)
+        Util_Bomb("SERVER - COULD NOT OPEN %s FOR TELEMETRY\n", path);
+    const size_t length = strlen(path);
+    telemetry->is_csv = length >= 4 && Util_StringEqual(&path[length - 4], ".csv");
+    if(telemetry->is_csv)
+        fprintf(telemetry->file, "ms,turn,turns,send_us_p50,send_us_p99,send_us_max,parity_agreed,parity_differed,parity_desynced,"
+            "slot,bytes_in,bytes_out,queue,lag,rtt_p50,rtt_p99,rtt_max,rtt_samples\n");
+    telemetry->start = SDL_GetTicks();
+    SDL_AtomicSet(&telemetry->is_running, true);
+    telemetry->thread = SDL_CreateThread(Export, "N/A", telemetry);
+    return telemetry;
+}
+
+// THE LAST PARTIAL INTERVAL IS WRITTEN TOO.
+void Telemetry_Stop(Telemetry* const telemetry)
+{
+    if(telemetry == NULL)
+        return;
+    SDL_AtomicSet(&telemetry->is_running, false);
+    SDL_WaitThread(telemetry->thread, NULL);
+    Write(telemetry);
+    fclose(telemetry->file);
+    free(telemetry);
+}
+
+void Telemetry_Receive(Telemetry* const telemetry, const int32_t client, const int32_t bytes)
+{
+    if(telemetry)
+        SDL_AtomicAdd(&telemetry->bytes_in[client], bytes);
+}
+
+void Telemetry_Send(Telemetry* const telemetry, const int32_t client, const int32_t bytes)
+{
+    if(telemetry)
+        SDL_AtomicAdd(&telemetry->bytes_out[client], bytes);
+}
+
+void Telemetry_Ping(Telemetry* const telemetry, const int32_t client, const int32_t ms)
+{
+    if(telemetry)
+        SDL_AtomicAdd(&telemetry->rtt[client][Histogram_GetBucket(ms)], 1);
+}
+
+void Telemetry_Client(Telemetry* const telemetry, const int32_t client, const bool connected, const int32_t queue, const int32_t lag)
+{
+    if(telemetry)
+    {
+        SDL_AtomicSet(&telemetry->connected[client], connected);
+        SDL_AtomicSet(&telemetry->queue[client], queue);
+        SDL_AtomicSet(&telemetry->lag[client], lag);
+    }
+}
+
+void Telemetry_Turn(Telemetry* const telemetry, const int32_t turn, const int32_t us)
+{
+    if(telemetry)
+    {
+        SDL_AtomicSet(&telemetry->turn, turn);
+        SDL_AtomicAdd(&telemetry->send[Histogram_GetBucket(us)], 1);
+    }
+}
+
+void Telemetry_Check(Telemetry* const telemetry, const bool agreed)
+{
+    if(telemetry)
+        SDL_AtomicAdd(agreed ? &telemetry->agreed : &telemetry->differed, 1);
+}
+
+void Telemetry_Desync(Telemetry* const telemetry)
+{
+    if(telemetry)
+        SDL_AtomicAdd(&telemetry->desynced, 1);
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Color.h"
+#include "Histogram.h"
+
+#include <SDL2/SDL_atomic.h>
+#include <SDL2/SDL_thread.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+// WHAT THE SERVER THREAD SEES, COUNTED INTO ATOMICS AS IT HAPPENS AND WRITTEN OUT BY A THREAD OF ITS
+// OWN EVERY CONFIG_TELEMETRY_MS, SO THE RELAY NEVER WAITS ON A FILE. PER SLOT: PAYLOAD BYTES IN AND
+// OUT, WITHOUT FRAMING, THE QUEUE AND THE LAG BEHIND THE SETPOINT AT THE LAST TURN, AND THE RTTS THE
+// CLIENT REPORTED. FOR THE MATCH: HOW LONG EACH TURN TOOK TO SEND, IN MICROSECONDS, AND THE PARITY
+// CHECKPOINTS FOUND AGREEING, FOUND DIFFERING, AND BISECTED TO A DESYNC.
+//
+// EVERY LINE COVERS ONE INTERVAL, WITH COUNTS AND PERCENTILES OVER THAT INTERVAL ALONE. A PATH ENDING
+// IN .CSV GETS A ROW PER CONNECTED SLOT, AND ANY OTHER PATH A JSON OBJECT PER LINE. A NAMED PIPE
+// WORKS AS THE PATH FOR A LIVE FEED. PERCENTILES AND MAXIMUMS ARE THE LOWER EDGES OF HISTOGRAM
+// BUCKETS. A NULL TELEMETRY COUNTS NOTHING.
+
+typedef struct
+{
+    SDL_atomic_t connected[COLOR_COUNT];
+    SDL_atomic_t bytes_in[COLOR_COUNT];
+    SDL_atomic_t bytes_out[COLOR_COUNT];
+    SDL_atomic_t queue[COLOR_COUNT];
+    SDL_atomic_t lag[COLOR_COUNT];
+    SDL_atomic_t rtt[COLOR_COUNT][HISTOGRAM_BUCKETS];
+    SDL_atomic_t send[HISTOGRAM_BUCKETS];
+    SDL_atomic_t turn;
+    SDL_atomic_t agreed;
+    SDL_atomic_t differed;
+    SDL_atomic_t desynced;
+    SDL_atomic_t is_running;
+    SDL_Thread* thread;
+    FILE* file;
+    bool is_csv;
+    uint32_t start;
+    int32_t seen_in[COLOR_COUNT];
+    int32_t seen_out[COLOR_COUNT];
+    int32_t seen_rtt[COLOR_COUNT][HISTOGRAM_BUCKETS];
+    int32_t seen_send[HISTOGRAM_BUCKETS];
+    int32_t seen_turn;
+    int32_t seen_agreed;
+    int32_t seen_differed;
+    int32_t seen_desynced;
+}
+Telemetry;
+
+Telemetry* Telemetry_Start(const char* const path);
+
+void Telemetry_Stop(Telemetry* const);
+
+void Telemetry_Receive(Telemetry* const, const int32_t client, const int32_t bytes);
+
+void Telemetry_Send(Telemetry* const, const int32_t client, const int32_t bytes);
+
+void Telemetry_Ping(Telemetry* const, const int32_t client, const int32_t ms);
+
+void Telemetry_Client(Telemetry* const, const int32_t client, const bool connected, const int32_t queue, const int32_t lag);
+
+void Telemetry_Turn(Telemetry* const, const int32_t turn, const int32_t us);
+
+void Telemetry_Check(Telemetry* const, const bool agreed);
+
+void Telemetry_Desync(Telemetry* const);
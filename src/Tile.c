@@ -1,6 +1,7 @@
 #include "Tile.h"
 
 #include "Rect.h"
+#include "Fixed.h"
 #include "Util.h"
 #include "Config.h"
 
@@ -81,7 +82,7 @@ static Tile Construct(const Overview overview, const Grid grid, const Point cart
 
 Tile Tile_GetTerrain(const Overview overview, const Grid grid, const Point cart, const Animation animation, const Terrain file)
 {
-    const int32_t bound = Util_Sqrt(animation.count);
+    const int32_t bound = Fixed_Sqrt(animation.count);
     const int32_t index = (cart.x % bound) + ((cart.y % bound) * bound);
     const Point cart_grid_offset = { 0,0 };
     const uint8_t height = Terrain_GetHeight(file);
@@ -138,6 +139,17 @@ Tile Tile_GetGraphics(const Overview overview, const Grid grid, const Point cart
     return Construct(overview, grid, shifted, offset, animation, dynamics, height, reference);
 }
 
+Tile Tile_GetEffect(const Overview overview, const Grid grid, const Effect effect, const Animation animation)
+{
+    const int32_t ticks = effect.timer / CONFIG_ANIMATION_DIVISOR;
+    const Dynamics dynamics = { ticks % animation.count, false };
+    const Point shift = { 0, 1 };
+    const Point half = Point_Div(Graphics_GetDimensions(effect.file), 2);
+    const Point shifted = Point_Add(effect.cart, Point_Add(shift, half));
+    const uint8_t height = Graphics_GetHeight(effect.file);
+    return Construct(overview, grid, shifted, effect.cart_grid_offset, animation, dynamics, height, NULL);
+}
+
 Point Tile_GetHotSpotCoords(const Tile tile)
 {
     return Point_Add(tile.iso_pixel, tile.iso_pixel_offset);
@@ -160,9 +172,8 @@ Point Tile_GetTopLeftOffsetCoords(const Tile tile, const int32_t x, const int32_
     return Point_Add(point, Tile_GetTopLeftCoords(tile));
 }
 
-void Tile_Select(const Tile tile)
+Selection Tile_Select(const Tile tile, Selection selection)
 {
     Unit_Print(tile.reference);
-    if(!Unit_IsExempt(tile.reference))
-        tile.reference->is_selected = true;
+    return Selection_Add(selection, tile.reference);
 }
@@ -7,6 +7,8 @@
 #include "Overview.h"
 #include "Animation.h"
 #include "Unit.h"
+#include "Selection.h"
+#include "Effect.h"
 #include "Direction.h"
 
 #include <stdbool.h>
@@ -34,6 +36,8 @@ Tile Tile_GetTerrain(const Overview, const Grid grid, const Point cart, const An
 
 Tile Tile_GetGraphics(const Overview, const Grid grid, const Point cart, const Point cart_grid_offset, const Animation, Unit* const reference);
 
+Tile Tile_GetEffect(const Overview, const Grid grid, const Effect, const Animation);
+
 Point Tile_GetTopLeftOffsetCoords(const Tile, const int32_t x, const int32_t y);
 
 Point Tile_GetHotSpotCoords(const Tile);
@@ -44,6 +48,6 @@ Rect Tile_GetFrameOutline(const Tile);
 
 bool Tile_IsHotspotInRect(const Tile, const Rect);
 
-void Tile_Select(const Tile);
+Selection Tile_Select(const Tile, Selection);
 
 Tile Tile_Clip(Tile tile, const Rect);
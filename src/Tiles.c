@@ -79,6 +79,22 @@ Tiles Tiles_PrepGraphics(const Registrar graphics, const Overview overview, cons
     return tiles;
 }
 
+Tiles Tiles_PrepEffects(const Registrar graphics, const Overview overview, const Grid grid, const Effects effects)
+{
+    Tile* const tile = UTIL_ALLOC(Tile, effects.count);
+    int32_t effect_count = 0;
+    for(int32_t i = 0; i < effects.count; i++)
+    {
+        const Effect effect = effects.effect[i];
+        const Animation animation = graphics.animation[COLOR_GAIA][effect.file];
+        const Tile temp = Tile_GetEffect(overview, grid, effect, animation);
+        if(!temp.totally_offscreen)
+            tile[effect_count++] = temp;
+    }
+    const Tiles tiles = { tile, effect_count };
+    return tiles;
+}
+
 void Tiles_Free(const Tiles tiles)
 {
     free(tiles.tile);
@@ -114,7 +130,7 @@ Tiles Tiles_PrepTerrain(const Registrar terrain, const Map map, const Overview o
     return tiles;
 }
 
-Tile Tiles_SelectOne(const Tiles tiles, const Point click)
+Tile Tiles_SelectOne(const Tiles tiles, const Point click, Selection* const selection)
 {
     for(int32_t i = 0; i < tiles.count; i++)
     {
@@ -126,7 +142,7 @@ Tile Tiles_SelectOne(const Tiles tiles, const Point click)
             const uint32_t pixel = Surface_GetPixel(tile.surface, origin_click.x, origin_click.y);
             if(pixel != SURFACE_COLOR_KEY)
             {
-                Tile_Select(tile);
+                *selection = Tile_Select(tile, *selection);
                 return tile;
             }
         }
@@ -135,9 +151,8 @@ Tile Tiles_SelectOne(const Tiles tiles, const Point click)
     return zero;
 }
 
-int32_t Tiles_SelectSimilar(const Tiles tiles, const Tile similar)
+Selection Tiles_SelectSimilar(const Tiles tiles, const Tile similar, Selection selection)
 {
-    int32_t count = 0;
     for(int32_t i = 0; i < tiles.count; i++)
     {
         const Tile tile = tiles.tile[i];
@@ -147,17 +162,13 @@ int32_t Tiles_SelectSimilar(const Tiles tiles, const Tile similar)
         const Color c_b = tile.reference->color;
         if(t_a == t_b
         && c_a == c_b)
-        {
-            Tile_Select(tile);
-            count++;
-        }
+            selection = Tile_Select(tile, selection);
     }
-    return count;
+    return selection;
 }
 
-int32_t Tiles_SelectWithBox(const Tiles tiles, const Rect rect)
+Selection Tiles_SelectWithBox(const Tiles tiles, const Rect rect, Selection selection)
 {
-    int32_t count = 0;
     const Rect box = Rect_CorrectOrientation(rect);
     for(int32_t i = 0; i < tiles.count; i++)
     {
@@ -165,12 +176,9 @@ int32_t Tiles_SelectWithBox(const Tiles tiles, const Rect rect)
         if(tile.reference->trait.is_inanimate)
             continue;
         if(Tile_IsHotspotInRect(tile, box))
-        {
-            Tile_Select(tile);
-            count++;
-        }
+            selection = Tile_Select(tile, selection);
     }
-    return count;
+    return selection;
 }
 
 Tiles Tiles_Copy(const Tiles tiles)
@@ -13,15 +13,17 @@ Tiles;
 
 Tiles Tiles_PrepGraphics(const Registrar, const Overview, const Grid, const Units, const Points);
 
+Tiles Tiles_PrepEffects(const Registrar, const Overview, const Grid, const Effects);
+
 Tiles Tiles_PrepTerrain(const Registrar, const Map, const Overview, const Grid, const Points);
 
 void Tiles_Free(const Tiles);
 
-Tile Tiles_SelectOne(const Tiles, const Point);
+Tile Tiles_SelectOne(const Tiles, const Point, Selection* const);
 
-int32_t Tiles_SelectSimilar(const Tiles, const Tile);
+Selection Tiles_SelectSimilar(const Tiles, const Tile, Selection);
 
-int32_t Tiles_SelectWithBox(const Tiles, const Rect);
+Selection Tiles_SelectWithBox(const Tiles, const Rect, Selection);
 
 void Tiles_SortByHeight(const Tiles);
 
@@ -11,6 +11,7 @@
 typedef struct
 {
     const char* file_name;
+    Graphics file;
     Point dimensions;
     Type type;
     int32_t max_speed;
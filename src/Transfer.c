@@ -0,0 +1,64 @@
+#include "Transfer.h"
+
+#include "Util.h"
+
+#include <string.h>
+
+Transfer Transfer_Make(void)
+{
+    static Transfer zero;
+    Transfer transfer = zero;
+    transfer.snapshot = Snapshot_Make();
+    return transfer;
+}
+
+void Transfer_Free(const Transfer transfer)
+{
+    Snapshot_Free(transfer.snapshot);
+}
+
+// THE SNAPSHOT BUFFER IS KEPT, SO A DONOR SNAPSHOTS INTO IT IN PLACE AND A RECEIVER RESERVES IT HERE.
+Transfer Transfer_Begin(Transfer transfer, const int32_t cycles, const int32_t size)
+{
+    Snapshot_Clear(&transfer.snapshot);
+    Snapshot_Put(&transfer.snapshot, NULL, size);
+    transfer.cycles = cycles;
+    transfer.done = 0;
+    transfer.is_active = true;
+    return transfer;
+}
+
+Transfer Transfer_Stop(Transfer transfer)
+{
+    transfer.is_active = false;
+    return transfer;
+}
+
+// CHUNKS ARRIVE OVER ONE CONNECTION, SO NONE IS SEEN TWICE, AND COUNTING BYTES IS ENOUGH.
+Transfer Transfer_Take(Transfer transfer, const Chunk chunk)
+{
+    if(!transfer.is_active || chunk.cycles != transfer.cycles || chunk.size != transfer.snapshot.size)
+        transfer = Transfer_Begin(transfer, chunk.cycles, chunk.size);
+    memcpy(&transfer.snapshot.byte[chunk.offset], chunk.byte, (size_t) chunk.count);
+    transfer.done += chunk.count;
+    return transfer;
+}
+
+// FALSE ONCE EVERY BYTE HAS GONE OUT.
+bool Transfer_Next(Transfer* const transfer, Chunk* const chunk)
+{
+    if(!transfer->is_active || transfer->done == transfer->snapshot.size)
+        return false;
+    chunk->cycles = transfer->cycles;
+    chunk->size = transfer->snapshot.size;
+    chunk->offset = transfer->done;
+    chunk->count = UTIL_MIN(CHUNK_BYTES, transfer->snapshot.size - transfer->done);
+    memcpy(chunk->byte, &transfer->snapshot.byte[chunk->offset], (size_t) chunk->count);
+    transfer->done += chunk->count;
+    return true;
+}
+
+bool Transfer_IsDone(const Transfer transfer)
+{
+    return transfer.is_active && transfer.done == transfer.snapshot.size;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Snapshot.h"
+#include "Chunk.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// A SNAPSHOT MOVING BETWEEN TWO CLIENTS, ONE CHUNK AT A TIME. THE DONOR COUNTS THE BYTES IT HAS SENT
+// AND THE REJOINING CLIENT THE BYTES IT HAS RECEIVED. A CHUNK OF A SNAPSHOT TAKEN AT ANOTHER CYCLE
+// STARTS THE TRANSFER OVER, AS THE SERVER ASKS A NEW DONOR WHEN THE FIRST ONE GOES QUIET.
+
+typedef struct
+{
+    Snapshot snapshot;
+    int32_t cycles;
+    int32_t done;
+    bool is_active;
+}
+Transfer;
+
+Transfer Transfer_Make(void);
+
+void Transfer_Free(const Transfer);
+
+Transfer Transfer_Begin(Transfer, const int32_t cycles, const int32_t size);
+
+Transfer Transfer_Stop(Transfer);
+
+Transfer Transfer_Take(Transfer, const Chunk);
+
+bool Transfer_Next(Transfer* const, Chunk* const);
+
+bool Transfer_IsDone(const Transfer);
@@ -4,6 +4,8 @@
 #include "Util.h"
 #include "Resource.h"
 #include "Config.h"
+#include "Rand.h"
+#include "Parity.h"
 
 #define MOCK_PATH_POINTS (2)
 
@@ -90,12 +92,6 @@ static void FollowPath(Unit* const unit, const Grid grid)
     else Stop(unit);
 }
 
-static void CapSpeed(Unit* const unit)
-{
-    if(Point_Mag(unit->velocity) > unit->trait.max_speed)
-        unit->velocity = Point_Normalize(unit->velocity, unit->trait.max_speed);
-}
-
 void UpdateCart(Unit* const unit, const Grid grid)
 {
     unit->cart_grid_offset = Grid_CellToOffset(grid, unit->cell);
@@ -161,16 +157,28 @@ static int32_t GetExpireFrames(Unit* const unit, const Registrar graphics)
     return graphics.animation[unit->color][unit->file].count;
 }
 
+// EVERY CLIENT HANDS OUT IDS IN THE SAME ORDER, SO THE NEXT ID IS PART OF THE SIMULATION STATE.
+static int32_t next_id;
+
+int32_t Unit_GetNextId(void)
+{
+    return next_id;
+}
+
+void Unit_SetNextId(const int32_t id)
+{
+    next_id = id;
+}
+
 Unit Unit_Make(Point cart, const Point offset, const Grid grid, const Graphics file, const Color color, const Registrar graphics, const bool at_center, const bool is_floating, const Trigger trigger)
 {
-    static int32_t id;
     static Unit zero;
     Unit unit = zero;
     unit.trait = Trait_Build(file);
     unit.file = file;
-    unit.id = id;
+    unit.id = next_id;
     if(!is_floating)
-        id += 1;
+        next_id += 1;
     unit.parent_id = -1;
     unit.color = color;
     unit.state = STATE_IDLE;
@@ -179,8 +187,9 @@ Unit Unit_Make(Point cart, const Point offset, const Grid grid, const Graphics f
     unit.trigger = trigger;
     if(!is_floating)
     {
-        unit.entropy = Point_Rand();
-        unit.entropy_static = Util_Rand();
+        unit.entropy.x = Rand_Get(unit.id, 0, PURPOSE_ENTROPY_X);
+        unit.entropy.y = Rand_Get(unit.id, 0, PURPOSE_ENTROPY_Y);
+        unit.entropy_static = Rand_Get(unit.id, 0, PURPOSE_ENTROPY_STATIC);
     }
     if(at_center)
     {
@@ -209,8 +218,7 @@ Unit Unit_Make(Point cart, const Point offset, const Grid grid, const Graphics f
         unit.fall_frames_per_dir = GetFramesFromState(&unit, graphics, STATE_FALL);
         unit.decay_frames_per_dir = GetFramesFromState(&unit, graphics, STATE_DECAY);
     }
-    if(unit.trait.type == TYPE_FIRE
-    || unit.trait.type == TYPE_RUBBLE)
+    if(unit.trait.type == TYPE_RUBBLE)
         unit.is_timing_to_collect = true;
     return unit;
 }
@@ -254,7 +262,6 @@ void Unit_Flow(Unit* const unit, const Grid grid)
 {
     FollowPath(unit, grid);
     ApplyStressors(unit);
-    CapSpeed(unit);
 }
 
 bool Unit_InPlatoon(Unit* const unit, Unit* const other)
@@ -421,7 +428,7 @@ void Unit_Repath(Unit* const unit, const Field field)
     }
 }
 
-static Point Nudge(Unit* const unit)
+Point Unit_Nudge(Unit* const unit)
 {
     const int32_t mag = UINT16_MAX;
     const Point half = { mag / 2, mag / 2 };
@@ -435,7 +442,7 @@ Point Unit_Separate(Unit* const unit, Unit* const other)
     {
         const Point diff = Point_Sub(other->cell, unit->cell);
         if(Point_IsZero(diff))
-            return Nudge(unit);
+            return Unit_Nudge(unit);
         const int32_t width = UTIL_MAX(unit->trait.width, other->trait.width);
         if(Point_Mag(diff) < width)
             return Point_Sub(Point_Normalize(diff, width), diff);
@@ -479,3 +486,25 @@ bool Unit_IsTriggerValid(Unit* const flag)
 {
     return !flag->is_triggered && flag->trigger != TRIGGER_NONE;
 }
+
+// EVERY ASPECT STARTS FROM THE ID, SO THAT TWO UNITS SWAPPING THEIR FIELDS STILL CHANGE THE SUM.
+void Unit_Hash(Unit* const unit, uint64_t aspect[ASPECT_COUNT])
+{
+    static Point zero;
+    const uint64_t seed = Parity_Mix(0, unit->id, unit->parent_id);
+    const Point goal = Unit_HasNoPath(unit) ? zero : unit->path.point[unit->path.count - 1];
+    aspect[ASPECT_POSITION] = Parity_Finish(Parity_Mix(Parity_Mix(Parity_Mix(seed,
+        unit->cell.x, unit->cell.y),
+        unit->velocity.x, unit->velocity.y),
+        unit->dir, unit->is_engaged));
+    aspect[ASPECT_HEALTH] = Parity_Finish(Parity_Mix(Parity_Mix(seed,
+        unit->health, unit->state),
+        unit->file, unit->color));
+    aspect[ASPECT_PATH] = Parity_Finish(Parity_Mix(Parity_Mix(Parity_Mix(seed,
+        unit->path.count, unit->path_index),
+        goal.x, goal.y),
+        unit->command_group, unit->command_group_count));
+    aspect[ASPECT_TIMER] = Parity_Finish(Parity_Mix(Parity_Mix(seed,
+        unit->state_timer, unit->dir_timer),
+        unit->path_index_timer, unit->garbage_collection_timer));
+}
@@ -12,6 +12,7 @@
 #include "Trait.h"
 #include "Direction.h"
 #include "Type.h"
+#include "Aspect.h"
 
 typedef struct Unit
 {
@@ -104,6 +105,8 @@ Resource Unit_Melee(Unit* const, const Grid);
 
 void Unit_Repath(Unit* const, const Field);
 
+Point Unit_Nudge(Unit* const);
+
 Point Unit_Separate(Unit* const, Unit* const);
 
 bool Unit_IsDead(Unit* const);
@@ -119,3 +122,9 @@ bool Unit_HasNoPath(Unit* const);
 bool Unit_IsType(Unit* const, const Color, const Type);
 
 bool Unit_IsTriggerValid(Unit* const);
+
+void Unit_Hash(Unit* const, uint64_t aspect[ASPECT_COUNT]);
+
+int32_t Unit_GetNextId(void);
+
+void Unit_SetNextId(const int32_t);
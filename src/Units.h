@@ -15,6 +15,12 @@
 #include "Registrar.h"
 #include "Stack.h"
 #include "Share.h"
+#include "Effects.h"
+#include "Selection.h"
+#include "Parity.h"
+#include "Snapshot.h"
+
+#include <stdio.h>
 
 typedef struct
 {
@@ -25,10 +31,12 @@ typedef struct
     int32_t rows;
     int32_t cols;
     int32_t command_group_next;
-    int32_t select_count;
     int32_t cpu_count;
     int32_t repath_index;
+    int32_t cycles;
     Share share;
+    Effects effects;
+    Selection selection;
 }
 Units;
 
@@ -60,6 +68,14 @@ Units Units_Float(Units, const Units, const Registrar, const Overview, const Gri
 
 Units Units_PacketService(Units, const Registrar, const Packet, const Grid, const Map, const Field);
 
-uint64_t Units_Xor(const Units);
+Parity Units_Parity(const Units);
+
+void Units_Dump(const Units, const uint32_t regions);
 
 Point Units_GetFirstTownCenterPan(const Units, const Grid, const Color);
+
+Snapshot Units_Snapshot(const Units, Snapshot);
+
+bool Units_CanRestore(const Units, Snapshot);
+
+Units Units_Restore(Units, Snapshot);
@@ -12,6 +12,9 @@
 #include "Tiles.h"
 #include "Graphics.h"
 #include "Config.h"
+#include "Rand.h"
+#include "Fixed.h"
+#include "Flock.h"
 
 #include <stdlib.h>
 
@@ -77,6 +80,8 @@ Units Units_New(const Grid grid, const int32_t cpu_count, const int32_t max, con
     units.share.motive.action = ACTION_NONE;
     units.share.motive.type = TYPE_NONE;
     units.share.color = color;
+    units.effects = Effects_New(CONFIG_EFFECTS_MAX);
+    units.selection = Selection_Make(CONFIG_UNITS_SELECTION_SIZE, color);
     return units;
 }
 
@@ -87,14 +92,8 @@ void Units_Free(const Units units)
         Stack_Free(units.stack[i]);
     free(units.stack);
     free(units.unit);
-}
-
-static Units UnSelectAll(Units units)
-{
-    units.select_count = 0;
-    for(int32_t i = 0; i < units.count; i++)
-        units.unit[i].is_selected = false;
-    return units;
+    Effects_Free(units.effects);
+    Selection_Free(units.selection);
 }
 
 static Units Select(Units units, const Overview overview, const Grid grid, const Registrar graphics, const Points render_points)
@@ -103,14 +102,14 @@ static Units Select(Units units, const Overview overview, const Grid grid, const
     {
         const Tiles tiles = Tiles_PrepGraphics(graphics, overview, grid, units, render_points);
         Tiles_SortByHeight(tiles); // For selecting transparent units behind inanimates or trees.
-        units = UnSelectAll(units);
+        units.selection = Selection_Clear(units.selection);
         if(Overview_IsSelectionBoxBigEnough(overview))
-            units.select_count = Tiles_SelectWithBox(tiles, overview.selection_box);
+            units.selection = Tiles_SelectWithBox(tiles, overview.selection_box, units.selection);
         else
         {
-            const Tile tile = Tiles_SelectOne(tiles, overview.mouse_cursor);
-            if(tile.reference && tile.reference->is_selected)
-                units.select_count = overview.event.key_left_ctrl ? Tiles_SelectSimilar(tiles, tile) : 1;
+            const Tile tile = Tiles_SelectOne(tiles, overview.mouse_cursor, &units.selection);
+            if(tile.reference && tile.reference->is_selected && overview.event.key_left_ctrl)
+                units.selection = Tiles_SelectSimilar(tiles, tile, units.selection);
         }
         Tiles_Free(tiles);
     }
@@ -119,13 +118,13 @@ static Units Select(Units units, const Overview overview, const Grid grid, const
 
 static void FindPathForSelected(const Units units, const Overview overview, const Point cart_goal, const Point cart_grid_offset_goal, const Field field)
 {
-    for(int32_t i = 0; i < units.count; i++)
+    for(int32_t i = 0; i < units.selection.count; i++)
     {
-        Unit* const unit = &units.unit[i];
-        if(unit->color == overview.share.color && unit->is_selected && unit->trait.max_speed > 0)
+        Unit* const unit = units.selection.unit[i];
+        if(unit->color == overview.share.color && unit->trait.max_speed > 0)
         {
             unit->command_group = units.command_group_next;
-            unit->command_group_count = units.select_count;
+            unit->command_group_count = units.selection.count;
             Unit_FindPath(unit, cart_goal, cart_grid_offset_goal, field);
         }
     }
@@ -133,7 +132,7 @@ static void FindPathForSelected(const Units units, const Overview overview, cons
 
 static Units Command(Units units, const Overview overview, const Grid grid, const Registrar graphics, const Map map, const Field field)
 {
-    if(overview.event.mouse_ru && units.select_count > 0)
+    if(overview.event.mouse_ru && units.selection.count > 0)
     {
         const Point cart_goal = Overview_IsoToCart(overview, grid, overview.mouse_cursor, false);
         const Point cart = Overview_IsoToCart(overview, grid, overview.mouse_cursor, true);
@@ -143,61 +142,12 @@ static Units Command(Units units, const Overview overview, const Grid grid, cons
             units.command_group_next++;
             FindPathForSelected(units, overview, cart_goal, cart_grid_offset_goal, field);
             const Parts parts = Parts_GetRedArrows();
-            units = Units_SpawnParts(units, cart_goal, cart_grid_offset_goal, grid, COLOR_GAIA, graphics, map, false, parts, false, TRIGGER_NONE);
+            units.effects = Effects_SpawnParts(units.effects, cart_goal, cart_grid_offset_goal, grid, graphics, parts);
         }
     }
     return units;
 }
 
-static Point SeparateBoids(const Units units, Unit* const unit)
-{
-    const int32_t width = 1;
-    static Point zero;
-    Point out = zero;
-    if(!Unit_IsExempt(unit))
-    {
-        for(int32_t x = -width; x <= width; x++)
-        for(int32_t y = -width; y <= width; y++)
-        {
-            const Point cart_offset = { x, y };
-            const Point cart = Point_Add(unit->cart, cart_offset);
-            const Stack stack = Units_GetStackCart(units, cart);
-            for(int32_t i = 0; i < stack.count; i++)
-            {
-                Unit* const other = stack.reference[i];
-                const Point force = Unit_Separate(unit, other);
-                out = Point_Sub(out, force);
-            }
-        }
-    }
-    return Point_Div(out, CONFIG_UNITS_SEPARATION_DIVISOR);
-}
-
-static Point AlignBoids(const Units units, Unit* const unit)
-{
-    const int32_t width = 1;
-    static Point zero;
-    Point out = zero;
-    if(!Unit_IsExempt(unit))
-    {
-        for(int32_t x = -width; x <= width; x++)
-        for(int32_t y = -width; y <= width; y++)
-        {
-            const Point cart_offset = { x, y };
-            const Point cart = Point_Add(unit->cart, cart_offset);
-            const Stack stack = Units_GetStackCart(units, cart);
-            for(int32_t i = 0; i < stack.count; i++)
-            {
-                Unit* const other = stack.reference[i];
-                if(!Unit_IsExempt(other) && Unit_IsDifferent(unit, other) && Unit_InPlatoon(unit, other))
-                    out = Point_Add(out, other->velocity);
-            }
-        }
-        return Point_Div(out, CONFIG_UNITS_ALIGN_DIVISOR);
-    }
-    return zero;
-}
-
 static Point WallPushBoids(const Units units, Unit* const unit, const Map map, const Grid grid)
 {
     static Point zero;
@@ -224,15 +174,17 @@ static Point WallPushBoids(const Units units, Unit* const unit, const Map map, c
     return out;
 }
 
-static void CalculateBoidStressors(const Units units, Unit* const unit, const Map map, const Grid grid)
+static Flock CalculateBoidStressors(const Units units, Unit* const unit, const Map map, const Grid grid, Flock flock)
 {
     static Point zero;
     if(!Unit_IsExempt(unit))
     {
-        unit->group_alignment = AlignBoids(units, unit);
+        Point separation;
+        flock = Flock_Gather(flock, units, unit);
+        Flock_Steer(flock, unit, &separation, &unit->group_alignment);
         const Point point[] = {
             unit->group_alignment,
-            SeparateBoids(units, unit),
+            separation,
             WallPushBoids(units, unit, map, grid),
         };
         Point stressors = zero;
@@ -240,6 +192,7 @@ static void CalculateBoidStressors(const Units units, Unit* const unit, const Ma
             stressors = Point_Add(stressors, point[j]);
         unit->stressors = Point_Mag(stressors) < CONFIG_UNITS_STRESSOR_DEADZONE ? zero : stressors;
     }
+    return flock;
 }
 
 static void ConditionallyStopBoids(const Units units, Unit* const unit)
@@ -277,26 +230,19 @@ static bool EqualDimension(Point dimensions, const Graphics file)
     }
 }
 
-static Units SpamFire(Units units, Unit* const unit, const Grid grid, const Registrar graphics, const Map map)
+static Units SpamFire(Units units, Unit* const unit, const Grid grid, const Registrar graphics)
 {
     for(int32_t x = 0; x < unit->trait.dimensions.x; x++)
     for(int32_t y = 0; y < unit->trait.dimensions.y; y++)
     {
         const Point offset = { x, y };
         const Point cart = Point_Add(unit->cart, offset);
-        const int32_t w = grid.tile_cart_width;
-        const int32_t h = grid.tile_cart_height;
-        const Point grid_offset = {
-            Util_Rand() % w - w / 2,
-            Util_Rand() % h - h / 2,
-        };
-        const Parts parts = Parts_GetFire();
-        units = Units_SpawnParts(units, cart, grid_offset, grid, COLOR_GAIA, graphics, map, false, parts, true, TRIGGER_NONE);
+        units.effects = Effects_SpawnFire(units.effects, cart, grid, graphics);
     }
     return units;
 }
 
-static Units SpamSmoke(Units units, Unit* const unit, const Grid grid, const Registrar graphics, const Map map)
+static Units SpamSmoke(Units units, Unit* const unit, const Grid grid, const Registrar graphics)
 {
     const Point zero = { 0,0 };
     for(int32_t x = 0; x < unit->trait.dimensions.x; x++)
@@ -305,7 +251,7 @@ static Units SpamSmoke(Units units, Unit* const unit, const Grid grid, const Reg
         const Point shift = { x, y };
         const Point cart = Point_Add(unit->cart, shift);
         const Parts parts = Parts_GetSmoke();
-        units = Units_SpawnParts(units, cart, zero, grid, COLOR_GAIA, graphics, map, false, parts, true, TRIGGER_NONE);
+        units.effects = Effects_SpawnParts(units.effects, cart, zero, grid, graphics, parts);
     }
     return units;
 }
@@ -348,7 +294,7 @@ static void Anakin(const Units units, Unit* const unit)
         KillChildren(units, unit);
 }
 
-static Units Kill(Units units, const Grid grid, const Registrar graphics, const Map map)
+static Units Kill(Units units, const Grid grid, const Registrar graphics)
 {
     for(int32_t i = 0; i < units.count; i++)
     {
@@ -361,8 +307,8 @@ static Units Kill(Units units, const Grid grid, const Registrar graphics, const
             if(unit->trait.is_inanimate)
             {
                 MakeRubble(unit, grid, graphics);
-                units = SpamFire(units, unit, grid, graphics, map);
-                units = SpamSmoke(units, unit, grid, graphics, map);
+                units = SpamFire(units, unit, grid, graphics);
+                units = SpamSmoke(units, unit, grid, graphics);
             }
         }
     }
@@ -511,11 +457,13 @@ Needle;
 static int32_t StressorThread(void* data)
 {
     Needle* const needle = (Needle*) data;
+    Flock flock = Flock_Make(CONFIG_UNITS_FLOCK_SIZE);
     for(int32_t i = needle->a; i < needle->b; i++)
     {
         Unit* const unit = &needle->units.unit[i];
-        CalculateBoidStressors(needle->units, unit, needle->map, needle->grid);
+        flock = CalculateBoidStressors(needle->units, unit, needle->map, needle->grid, flock);
     }
+    Flock_Free(flock);
     return 0;
 }
 
@@ -540,20 +488,39 @@ static void Process(const Units units, const Map map, const Grid grid, int32_t R
     free(threads);
 }
 
+// VELOCITIES ARE GATHERED AFTER FLOWING SO THAT SPEED CAPPING RUNS AS ONE FIXED POINT BATCH.
 static int32_t FlowThread(void* data)
 {
     Needle* const needle = (Needle*) data;
+    const int32_t size = needle->b - needle->a;
+    Unit** const flowing = UTIL_ALLOC(Unit*, size);
+    Point* const velocity = UTIL_ALLOC(Point, size);
+    int32_t* const max_speed = UTIL_ALLOC(int32_t, size);
+    int32_t count = 0;
     for(int32_t i = needle->a; i < needle->b; i++)
     {
         Unit* const unit = &needle->units.unit[i];
         if(!State_IsDead(unit->state))
         {
             Unit_Flow(unit, needle->grid);
-            Unit_Move(unit, needle->grid);
-            if(!CanWalk(needle->units, needle->map, unit->cart))
-                Unit_UndoMove(unit, needle->grid);
+            flowing[count] = unit;
+            velocity[count] = unit->velocity;
+            max_speed[count] = unit->trait.max_speed;
+            count++;
         }
     }
+    Fixed_ClampBatch(velocity, max_speed, count);
+    for(int32_t i = 0; i < count; i++)
+    {
+        Unit* const unit = flowing[i];
+        unit->velocity = velocity[i];
+        Unit_Move(unit, needle->grid);
+        if(!CanWalk(needle->units, needle->map, unit->cart))
+            Unit_UndoMove(unit, needle->grid);
+    }
+    free(flowing);
+    free(velocity);
+    free(max_speed);
     return 0;
 }
 
@@ -603,23 +570,22 @@ static void SortGarbage(const Units units)
     UTIL_SORT(units.unit, units.count, CompareGarbage);
 }
 
-static void FlagGarbage(const Units units)
+static int32_t FlagGarbage(const Units units)
 {
+    int32_t count = 0;
     for(int32_t i = 0; i < units.count; i++)
     {
         Unit* const unit = &units.unit[i];
         const int32_t last_tick = Unit_GetLastDecayTick(unit);
         if(unit->state == STATE_DECAY && unit->state_timer == last_tick)
             unit->must_garbage_collect = true;
-        if(unit->is_timing_to_collect)
-        {
-            const int32_t time = (unit->trait.type == TYPE_FIRE)
-                ? CONFIG_UNITS_CLEANUP_FIRE
-                : CONFIG_UNITS_CLEANUP_RUBBLE;
-            if(unit->garbage_collection_timer == time)
-                unit->must_garbage_collect = true;
-        }
+        if(unit->is_timing_to_collect
+        && unit->garbage_collection_timer == CONFIG_UNITS_CLEANUP_RUBBLE)
+            unit->must_garbage_collect = true;
+        if(unit->must_garbage_collect)
+            count++;
     }
+    return count;
 }
 
 static Units Resize(Units units)
@@ -636,78 +602,45 @@ static Units Resize(Units units)
     return units;
 }
 
-static Units RemoveGarbage(const Units units)
-{
-    FlagGarbage(units);
-    SortGarbage(units);
-    return Resize(units);
-}
-
-static void UpdateEntropy(const Units units)
-{
-    for(int32_t i = 0; i < units.count; i++)
-        units.unit[i].entropy = Point_Rand();
-}
-
-static void Zero(int32_t array[], const int32_t size)
-{
-    for(int32_t i = 0; i < size; i++)
-        array[i] = 0;
-}
-
-static int32_t MaxIndex(int32_t array[], const int32_t size)
-{
-    int32_t max = 0;
-    int32_t index = 0;
-    for(int32_t i = 0; i < size; i++)
-        if(array[i] > max)
-        {
-            max = array[i];
-            index = i;
-        }
-    return index;
-}
-
-static Action GetAction(const Units units)
+// SORTING MOVES UNITS, SO THE SELECTION IS REBUILT WHENEVER SOMETHING WAS COLLECTED.
+static Units RemoveGarbage(Units units)
 {
-    int32_t counts[ACTION_COUNT + 1];
-    const int32_t size = UTIL_LEN(counts);
-    Zero(counts, size);
-    for(int32_t i = 0; i < units.count; i++)
+    if(FlagGarbage(units) > 0)
     {
-        Unit* const unit = &units.unit[i];
-        if(unit->is_selected && unit->color == units.share.color)
-        {
-            const int32_t index = (int32_t) unit->trait.action + 1;
-            counts[index]++;
-        }
+        SortGarbage(units);
+        units = Resize(units);
+        units.selection = Selection_Rebuild(units.selection, units.unit, units.count);
     }
-    return (Action) (MaxIndex(counts, size) - 1);
+    return units;
 }
 
-static Type GetType(const Units units)
+static void UpdateEntropy(const Units units)
 {
-    int32_t counts[TYPE_COUNT + 1];
-    const int32_t size = UTIL_LEN(counts);
-    Zero(counts, size);
-    for(int32_t i = 0; i < units.count; i++)
-    {
-        Unit* const unit = &units.unit[i];
-        if(unit->is_selected && unit->color == units.share.color)
+    int32_t id[CONFIG_UNITS_ENTROPY_BATCH];
+    uint16_t x[CONFIG_UNITS_ENTROPY_BATCH];
+    uint16_t y[CONFIG_UNITS_ENTROPY_BATCH];
+    for(int32_t a = 0; a < units.count; a += CONFIG_UNITS_ENTROPY_BATCH)
+    {
+        const int32_t count = UTIL_MIN(CONFIG_UNITS_ENTROPY_BATCH, units.count - a);
+        for(int32_t i = 0; i < count; i++)
+            id[i] = units.unit[a + i].id;
+        Rand_Batch(id, x, count, units.cycles, PURPOSE_ENTROPY_X);
+        Rand_Batch(id, y, count, units.cycles, PURPOSE_ENTROPY_Y);
+        for(int32_t i = 0; i < count; i++)
         {
-            const int32_t index = (int32_t) unit->trait.type + 1;
-            counts[index]++;
+            units.unit[a + i].entropy.x = x[i];
+            units.unit[a + i].entropy.y = y[i];
         }
     }
-    return (Type) (MaxIndex(counts, size) - 1);
 }
 
 static Units UpdateMotive(Units units)
 {
     static Motive zero;
+    units.selection = Selection_Prune(units.selection);
     units.share.motive = zero;
-    units.share.motive.action = GetAction(units);
-    units.share.motive.type = GetType(units);
+    units.share.motive.action = Selection_GetAction(units.selection);
+    units.share.motive.type = Selection_GetType(units.selection);
     return units;
 }
 
@@ -906,10 +839,12 @@ Units Units_Caretake(Units units, const Registrar graphics, const Grid grid, con
     units = UpdateMotive(units);
     Decay(units);
     Expire(units);
-    units = Kill(units, grid, graphics, map);
+    units = Kill(units, grid, graphics);
     units = RemoveGarbage(units);
+    units.effects = Effects_Caretake(units.effects);
     Units_ManageStacks(units);
     units = CountPopulation(units);
+    units.cycles++;
     return units;
 }
 
@@ -945,20 +880,41 @@ Units Units_PacketService(Units units, const Registrar graphics, const Packet pa
     return units;
 }
 
-uint64_t Units_Xor(const Units units)
+// ONE PASS OVER THE UNITS, A HANDFUL OF MULTIPLIES PER UNIT.
+Parity Units_Parity(const Units units)
 {
-    uint64_t parity = 0;
+    static Parity zero;
+    Parity parity = zero;
+    parity.cycles = units.cycles;
     for(int32_t i = 0; i < units.count; i++)
     {
         Unit* const unit = &units.unit[i];
-        const uint64_t x = (uint64_t) unit->cell.x;
-        const uint64_t y = (uint64_t) unit->cell.y;
-        const uint64_t xx = unit->id * x;
-        const uint64_t yy = unit->id * y;
-        parity ^= (yy << 32) | xx;
-        parity += (int32_t) unit->file;
-    }
-    return parity;
+        uint64_t aspect[ASPECT_COUNT];
+        Unit_Hash(unit, aspect);
+        Parity_Add(&parity, Parity_GetRegion(unit->cart, units.cols, units.rows), aspect);
+    }
+    return Parity_Seal(parity);
+}
+
+// ONE LINE PER UNIT IN THE GIVEN REGIONS, IN ARRAY ORDER, SO THAT THE DUMPS OF TWO CLIENTS CAN BE DIFFED.
+void Units_Dump(const Units units, const uint32_t regions)
+{
+    for(int32_t i = 0; i < units.count; i++)
+    {
+        Unit* const unit = &units.unit[i];
+        const int32_t region = Parity_GetRegion(unit->cart, units.cols, units.rows);
+        if(regions & (1u << region))
+        {
+            uint64_t aspect[ASPECT_COUNT];
+            Unit_Hash(unit, aspect);
+            printf("UNIT %d :: REGION %d :: COLOR %d :: FILE %d :: CELL %d %d :: HEALTH %d :: STATE %d :: PATH %d/%d :: TIMERS %d %d %d",
+                unit->id, region, unit->color, unit->file, unit->cell.x, unit->cell.y, unit->health, unit->state,
+                unit->path_index, unit->path.count, unit->state_timer, unit->dir_timer, unit->path_index_timer);
+            for(int32_t j = 0; j < ASPECT_COUNT; j++)
+                printf(" :: %s 0x%016lX", Parity_GetAspectName((Aspect) j), aspect[j]);
+            printf("\n");
+        }
+    }
 }
 
 static Unit* GetFirstTownCenter(const Units units, const Color color)
@@ -0,0 +1,267 @@
+// Snapshots.
+
+#include "Units.h"
+
+#include "Util.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#define MAGIC (0x55534E50)
+#define VERSION (2)
+
+typedef struct
+{
+    int32_t magic;
+    int32_t version;
+    int32_t unit_size;
+    int32_t rows;
+    int32_t cols;
+    int32_t count;
+    int32_t points;
+    int32_t command_group_next;
+    int32_t repath_index;
+    int32_t cycles;
+    int32_t next_id;
+    Share share;
+}
+Head;
+
+typedef struct
+{
+    size_t offset;
+    size_t size;
+}
+Span;
+
+#define SPAN(member) { offsetof(Unit, member), sizeof(((Unit*) NULL)->member) }
+
+// EVERY FIELD OF A UNIT BUT ITS POINTERS, IN THE ORDER THEY LIE. WHAT IS NOT LISTED, THE POINTERS
+// AND THE PADDING THE COMPILER PUT BETWEEN AND AFTER THE FIELDS, IS ZEROED IN THE SNAPSHOT. A FIELD
+// ADDED TO UNIT OR TRAIT MUST BE ADDED HERE, OR IT IS ZEROED TOO.
+static const Span spans[] = {
+    SPAN(trait.file),
+    SPAN(trait.dimensions),
+    SPAN(trait.type),
+    SPAN(trait.max_speed),
+    SPAN(trait.max_health),
+    SPAN(trait.attack),
+    SPAN(trait.width),
+    SPAN(trait.action),
+    SPAN(trait.upgrade),
+    SPAN(trait.is_single_frame),
+    SPAN(trait.is_walkable),
+    SPAN(trait.is_multi_state),
+    SPAN(trait.is_inanimate),
+    SPAN(trait.can_expire),
+    SPAN(trait.is_detail),
+    SPAN(trait.needs_midding),
+    SPAN(cart),
+    SPAN(cart_grid_offset),
+    SPAN(cart_grid_offset_goal),
+    SPAN(cell),
+    SPAN(cell_last),
+    SPAN(cell_inanimate),
+    SPAN(velocity),
+    SPAN(group_alignment),
+    SPAN(stressors),
+    SPAN(entropy),
+    SPAN(path.count),
+    SPAN(path.max),
+    SPAN(color),
+    SPAN(dir),
+    SPAN(state),
+    SPAN(file),
+    SPAN(trigger),
+    SPAN(entropy_static),
+    SPAN(id),
+    SPAN(parent_id),
+    SPAN(path_index),
+    SPAN(path_index_timer),
+    SPAN(command_group),
+    SPAN(command_group_count),
+    SPAN(health),
+    SPAN(state_timer),
+    SPAN(dir_timer),
+    SPAN(garbage_collection_timer),
+    SPAN(attack_frames_per_dir),
+    SPAN(fall_frames_per_dir),
+    SPAN(decay_frames_per_dir),
+    SPAN(expire_frames),
+    SPAN(is_engaged),
+    SPAN(is_selected),
+    SPAN(must_garbage_collect),
+    SPAN(is_state_locked),
+    SPAN(is_already_tiled),
+    SPAN(was_wall_pushed),
+    SPAN(is_timing_to_collect),
+    SPAN(has_children),
+    SPAN(is_floating),
+    SPAN(is_triggered),
+    SPAN(must_skip_debris),
+};
+
+#define SPANS ((int32_t) (sizeof(spans) / sizeof(*spans)))
+
+// THE GAPS BETWEEN THE SPANS, AND THE GAP AFTER THE LAST ONE.
+static int32_t GetGaps(Span gaps[SPANS + 1])
+{
+    int32_t count = 0;
+    size_t end = 0;
+    for(int32_t i = 0; i <= SPANS; i++)
+    {
+        const size_t start = (i < SPANS) ? spans[i].offset : sizeof(Unit);
+        if(start > end)
+        {
+            const Span gap = { end, start - end };
+            gaps[count++] = gap;
+        }
+        if(i < SPANS)
+            end = spans[i].offset + spans[i].size;
+    }
+    return count;
+}
+
+Snapshot Units_Snapshot(const Units units, Snapshot snapshot)
+{
+    Snapshot_Clear(&snapshot);
+    static Head zero;
+    Head head = zero;
+    head.magic = MAGIC;
+    head.version = VERSION;
+    head.unit_size = sizeof(Unit);
+    head.rows = units.rows;
+    head.cols = units.cols;
+    head.count = units.count;
+    head.command_group_next = units.command_group_next;
+    head.repath_index = units.repath_index;
+    head.cycles = units.cycles;
+    head.next_id = Unit_GetNextId();
+    head.share = units.share;
+    for(int32_t i = 0; i < units.count; i++)
+        head.points += units.unit[i].path.count;
+    Snapshot_Put(&snapshot, &head, sizeof(head));
+    Span gaps[SPANS + 1];
+    const int32_t count = GetGaps(gaps);
+    uint8_t* const unit = (uint8_t*) Snapshot_Put(&snapshot, units.unit, units.count * (int32_t) sizeof(Unit));
+    for(int32_t i = 0; i < units.count; i++)
+    {
+        uint8_t* const at = unit + i * sizeof(Unit);
+        for(int32_t j = 0; j < count; j++)
+            memset(at + gaps[j].offset, 0, gaps[j].size);
+        memcpy(at + offsetof(Unit, path) + offsetof(Points, max), &units.unit[i].path.count, sizeof(int32_t));
+    }
+    uint8_t* const interest = (uint8_t*) Snapshot_Put(&snapshot, NULL, units.count * (int32_t) sizeof(int32_t));
+    for(int32_t i = 0; i < units.count; i++)
+    {
+        Unit* const other = units.unit[i].interest;
+        const int32_t index = other ? (int32_t) (other - units.unit) : -1;
+        memcpy(interest + i * sizeof(int32_t), &index, sizeof(index));
+    }
+    for(int32_t i = 0; i < units.count; i++)
+    {
+        const Points path = units.unit[i].path;
+        if(path.count > 0)
+            Snapshot_Put(&snapshot, path.point, path.count * (int32_t) sizeof(Point));
+    }
+    return snapshot;
+}
+
+static bool GetHead(Snapshot* const snapshot, Head* const head)
+{
+    const void* const from = Snapshot_Get(snapshot, sizeof(*head));
+    if(from)
+        memcpy(head, from, sizeof(*head));
+    return from != NULL;
+}
+
+static bool FitsHead(const Units units, const Snapshot snapshot, const Head head)
+{
+    return head.magic == MAGIC
+        && head.version == VERSION
+        && head.unit_size == (int32_t) sizeof(Unit)
+        && head.rows == units.rows
+        && head.cols == units.cols
+        && head.count >= 0
+        && head.count <= units.max
+        && head.points >= 0
+        && snapshot.size - snapshot.index == head.count * (int64_t) (sizeof(Unit) + sizeof(int32_t)) + head.points * (int64_t) sizeof(Point);
+}
+
+// EVERY PATH MUST BE SIZED TO ITS POINTS AND HAVE ITS INDEX ON IT, EVERY INTEREST MUST NAME A UNIT OR NONE,
+// AND THE PATHS MUST ADD UP TO THE POINTS THAT FOLLOW. THE FIELDS ARE READ WHERE THEY LIE.
+static bool FitsUnits(Snapshot snapshot, const Head head)
+{
+    const uint8_t* const unit = (const uint8_t*) Snapshot_Get(&snapshot, head.count * (int32_t) sizeof(Unit));
+    const uint8_t* const interest = (const uint8_t*) Snapshot_Get(&snapshot, head.count * (int32_t) sizeof(int32_t));
+    int64_t points = 0;
+    for(int32_t i = 0; i < head.count; i++)
+    {
+        const uint8_t* const at = unit + i * sizeof(Unit);
+        Points path;
+        int32_t path_index;
+        int32_t index;
+        memcpy(&path, at + offsetof(Unit, path), sizeof(path));
+        memcpy(&path_index, at + offsetof(Unit, path_index), sizeof(path_index));
+        memcpy(&index, interest + i * sizeof(int32_t), sizeof(index));
+        if(path.count < 0
+        || path.max != path.count
+        || path_index < 0
+        || (path.count == 0 ? path_index != 0 : path_index >= path.count)
+        || index < -1
+        || index >= head.count)
+            return false;
+        points += path.count;
+    }
+    return points == head.points;
+}
+
+// ONLY A SNAPSHOT OF THIS BUILD, OF THE SAME GRID, THAT FITS, CAN BE RESTORED.
+bool Units_CanRestore(const Units units, Snapshot snapshot)
+{
+    snapshot.index = 0;
+    Head head;
+    return GetHead(&snapshot, &head)
+        && FitsHead(units, snapshot, head)
+        && FitsUnits(snapshot, head);
+}
+
+// THE UNITS COME BACK WITH ONE COPY. EACH ONE THEN HAS ITS INTEREST, NAME, AND PATH RELINKED, AND
+// THE STACKS AND SELECTION ARE REBUILT. THE PATHS THE UNITS HAD BEFORE ARE FREED. A SNAPSHOT THAT
+// DOES NOT FIT IS REFUSED BEFORE ANYTHING IS COPIED.
+Units Units_Restore(Units units, Snapshot snapshot)
+{
+    if(!Units_CanRestore(units, snapshot))
+        Util_Bomb("UNITS - SNAPSHOT DOES NOT FIT\n");
+    snapshot.index = 0;
+    Head head;
+    GetHead(&snapshot, &head);
+    for(int32_t i = 0; i < units.count; i++)
+        units.unit[i].path = Points_Free(units.unit[i].path);
+    memcpy(units.unit, Snapshot_Get(&snapshot, head.count * (int32_t) sizeof(Unit)), head.count * sizeof(Unit));
+    const uint8_t* const interest = (const uint8_t*) Snapshot_Get(&snapshot, head.count * (int32_t) sizeof(int32_t));
+    for(int32_t i = 0; i < head.count; i++)
+    {
+        Unit* const unit = &units.unit[i];
+        int32_t index;
+        memcpy(&index, interest + i * sizeof(int32_t), sizeof(index));
+        unit->interest = (index >= 0) ? &units.unit[index] : NULL;
+        unit->trait.file_name = Graphics_GetString(unit->trait.file);
+        unit->path.point = NULL;
+        if(unit->path.count > 0)
+        {
+            unit->path.point = UTIL_ALLOC(Point, unit->path.count);
+            const int32_t size = unit->path.count * (int32_t) sizeof(Point);
+            memcpy(unit->path.point, Snapshot_Get(&snapshot, size), (size_t) size);
+        }
+    }
+    units.count = head.count;
+    units.command_group_next = head.command_group_next;
+    units.repath_index = head.repath_index;
+    units.cycles = head.cycles;
+    units.share = head.share;
+    Unit_SetNextId(head.next_id);
+    Units_ManageStacks(units);
+    units.selection = Selection_Rebuild(units.selection, units.unit, units.count);
+    return units;
+}
@@ -36,26 +36,10 @@ bool Util_StringEqual(const char* const a, const char* const b)
     return strcmp(a, b) == 0;
 }
 
-int32_t Util_Sqrt(const int64_t val)
+uint16_t Util_RandNext(uint32_t* const next)
 {
-    uint32_t a = 0;
-    uint32_t b = 0;
-    if(val < 2)
-        return (int32_t) val;
-    a = 1255;
-    for(int32_t i = 0; i < 8; i++)
-    {
-        b = val / a;
-        a = (a + b) / 2;
-    }
-    return a;
-}
-
-uint16_t Util_Rand(void)
-{
-    static uint32_t next = 1;
-    next = next * 1103515245 + 12345;
-    return (uint16_t) (next / 65536) % 32768;
+    *next = *next * 1103515245 + 12345;
+    return (uint16_t) (*next / 65536) % 32768;
 }
 
 int32_t Util_Time(void)
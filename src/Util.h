@@ -29,8 +29,6 @@ char* Util_StringDup(const char* s);
 
 bool Util_StringEqual(const char* const a, const char* const b);
 
-int32_t Util_Sqrt(const int64_t val);
-
-uint16_t Util_Rand(void);
+uint16_t Util_RandNext(uint32_t* const next);
 
 int32_t Util_Time(void);
@@ -100,11 +100,13 @@ void Video_Draw(const Video video, const Data data, const Map map, const Units u
     const Vram vram = Vram_Lock(video.canvas, video.xres, video.yres, video.cpu_count);
     const Tiles graphics_tiles = Tiles_PrepGraphics(data.graphics, overview, grid, units, window.units);
     const Tiles graphics_tiles_floats = Tiles_PrepGraphics(data.graphics, overview, grid, floats, window.units);
+    const Tiles effect_tiles = Tiles_PrepEffects(data.graphics, overview, grid, units.effects);
     const Tiles terrain_tiles = Tiles_PrepTerrain(data.terrain, map, overview, grid, window.terrain);
     const Lines blend_lines = Map_GetBlendLines(map, window.terrain);
     Lines_Sort(blend_lines);
     Vram_Clear(vram, 0x0);
     Vram_DrawUnits(vram, graphics_tiles);
+    Vram_DrawUnits(vram, effect_tiles);
     Vram_DrawUnitHealthBars(vram, graphics_tiles);
 #if SANITIZE_THREAD == 0
     // Breaks sanitizer - but that's okay - renderer race conditions will not affect syncing P2P.
@@ -122,6 +124,7 @@ void Video_Draw(const Video video, const Data data, const Map map, const Units u
     Vram_Free(vram);
     Tiles_Free(graphics_tiles);
     Tiles_Free(graphics_tiles_floats);
+    Tiles_Free(effect_tiles);
     Tiles_Free(terrain_tiles);
     Lines_Free(blend_lines);
     Window_Free(window);
@@ -0,0 +1,128 @@
+#include "Wire.h"
+
+#include "Shim.h"
+#include "Util.h"
+
+#include <string.h>
+
+#define PREFIX (WIRE_PREFIX)
+#define MASK (WIRE_RING_SIZE - 1)
+
+Wire* Wire_Make(TCPsocket socket)
+{
+    Wire* const wire = UTIL_ALLOC(Wire, 1);
+    wire->socket = socket;
+    wire->in = UTIL_ALLOC(uint8_t, WIRE_RING_SIZE);
+    wire->out = UTIL_ALLOC(uint8_t, WIRE_RING_SIZE);
+    return wire;
+}
+
+// THE SOCKET IS CLOSED BY ITS OWNER, AFTER THE WIRE IS FREED.
+void Wire_Free(Wire* const wire)
+{
+    Shim_Forget(wire->socket);
+    free(wire->in);
+    free(wire->out);
+    free(wire);
+}
+
+static uint32_t GetUsed(Wire* const wire)
+{
+    return wire->b - wire->a;
+}
+
+// ONE RECEIVE PER READINESS EVENT, INTO THE CONTIGUOUS FREE SPACE OF THE RING.
+// SDLNET ONLY BLOCKS WHEN NOTHING IS PENDING, AND THIS IS ONLY CALLED ONCE THE SOCKET IS READY.
+void Wire_Fill(Wire* const wire)
+{
+    const uint32_t free_space = WIRE_RING_SIZE - GetUsed(wire);
+    const uint32_t index = wire->b & MASK;
+    const uint32_t contiguous = UTIL_MIN(free_space, WIRE_RING_SIZE - index);
+    if(contiguous == 0)
+        return;
+    const int32_t bytes = SDLNet_TCP_Recv(wire->socket, &wire->in[index], (int32_t) contiguous);
+    if(bytes <= 0)
+        wire->is_closed = true;
+    else
+        wire->b += (uint32_t) bytes;
+}
+
+static uint8_t Peek(Wire* const wire, const uint32_t offset)
+{
+    return wire->in[(wire->a + offset) & MASK];
+}
+
+// FALSE UNTIL A WHOLE MESSAGE IS BUFFERED. A FRAME LARGER THAN ANY MESSAGE CLOSES THE WIRE.
+bool Wire_Pop(Wire* const wire, Bytes* const bytes)
+{
+    Bytes_Clear(bytes);
+    const uint32_t used = GetUsed(wire);
+    if(used < PREFIX)
+        return false;
+    const int32_t size = Peek(wire, 0) | (Peek(wire, 1) << 8);
+    if(size > BYTES_MAX)
+    {
+        wire->is_closed = true;
+        return false;
+    }
+    if(used < (uint32_t) (PREFIX + size))
+        return false;
+    for(int32_t i = 0; i < size; i++)
+        bytes->byte[i] = Peek(wire, PREFIX + i);
+    bytes->size = size;
+    wire->a += PREFIX + size;
+    return true;
+}
+
+void Wire_Push(Wire* const wire, const Bytes* const bytes)
+{
+    if(wire->out_size + PREFIX + bytes->size > WIRE_RING_SIZE)
+    {
+        wire->is_closed = true;
+        return;
+    }
+    wire->out_size += Wire_Frame(&wire->out[wire->out_size], bytes);
+}
+
+// RETURNS THE SIZE OF THE FRAME.
+int32_t Wire_Frame(uint8_t* const frame, const Bytes* const bytes)
+{
+    frame[0] = (uint8_t) (bytes->size >> 0);
+    frame[1] = (uint8_t) (bytes->size >> 8);
+    for(int32_t i = 0; i < bytes->size; i++)
+        frame[PREFIX + i] = bytes->byte[i];
+    return PREFIX + bytes->size;
+}
+
+void Wire_Flush(Wire* const wire)
+{
+    if(wire->out_size > 0)
+    {
+        if(Shim_SendTcp(wire->socket, wire->out, wire->out_size) < wire->out_size)
+            wire->is_closed = true;
+        wire->out_size = 0;
+    }
+}
+
+// WHAT THE SOCKET DOES NOT TAKE NOW IS MOVED TO THE FRONT, AND GOES FIRST NEXT TIME.
+void Wire_Send(Wire* const wire)
+{
+    const int32_t sent = Wire_Write(wire, wire->out, wire->out_size);
+    wire->out_size -= sent;
+    memmove(wire->out, &wire->out[sent], (size_t) wire->out_size);
+}
+
+// FRAMES ALREADY MADE GO OUT STRAIGHT FROM WHERE THEY ARE, WITHOUT A COPY, AS FAR AS THE SOCKET TAKES
+// THEM NOW. RETURNS HOW MANY BYTES WENT, WHICH MAY END MID FRAME. NOTHING ELSE MAY BE QUEUED ON THE WIRE.
+int32_t Wire_Write(Wire* const wire, const uint8_t* const frames, const int32_t size)
+{
+    if(size <= 0 || wire->is_closed)
+        return 0;
+    const int32_t sent = Shim_OfferTcp(wire->socket, frames, size);
+    if(sent < 0)
+    {
+        wire->is_closed = true;
+        return 0;
+    }
+    return sent;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Bytes.h"
+
+#include <SDL2/SDL_net.h>
+
+// A FRAMED TCP CONNECTION. EACH MESSAGE IS PREFIXED WITH ITS SIZE AS TWO LITTLE ENDIAN BYTES.
+// INCOMING BYTES COLLECT IN A RING UNTIL A WHOLE MESSAGE IS PRESENT, SO A SEGMENTED MESSAGE IS
+// NEVER LOST, AND SEVERAL MESSAGES ARRIVING TOGETHER ARE ALL DRAINED. OUTGOING MESSAGES ARE
+// QUEUED AND GO OUT TOGETHER IN ONE SEND WHEN FLUSHED, OR AS FAR AS THE SOCKET TAKES THEM WITHOUT
+// WAITING WHEN SENT, THE REST STAYING QUEUED. A PEER THAT STOPS READING FOR A WHOLE RING OF QUEUED
+// MESSAGES CLOSES ITS WIRE. MESSAGES FRAMED ONCE CAN BE WRITTEN TO ANY NUMBER OF WIRES AS THEY ARE,
+// WITHOUT WAITING, SO THE WRITER KEEPS ITS OWN PLACE IN THEM.
+
+#define WIRE_RING_SIZE (1 << 16)
+
+#define WIRE_PREFIX (2)
+
+typedef struct
+{
+    TCPsocket socket;
+    uint8_t* in;
+    uint8_t* out;
+    uint32_t a;
+    uint32_t b;
+    int32_t out_size;
+    bool is_closed;
+}
+Wire;
+
+Wire* Wire_Make(TCPsocket);
+
+void Wire_Free(Wire* const);
+
+void Wire_Fill(Wire* const);
+
+bool Wire_Pop(Wire* const, Bytes* const);
+
+void Wire_Push(Wire* const, const Bytes* const);
+
+void Wire_Flush(Wire* const);
+
+void Wire_Send(Wire* const);
+
+int32_t Wire_Frame(uint8_t* const, const Bytes* const);
+
+int32_t Wire_Write(Wire* const, const uint8_t* const, const int32_t size);
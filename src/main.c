@@ -7,124 +7,387 @@
 #include "Units.h"
 #include "Args.h"
 #include "Util.h"
+#include "Bench.h"
+#include "Host.h"
+#include "Shim.h"
+#include "Clock.h"
+#include "Replay.h"
+#include "Parities.h"
+#include "Rollback.h"
+#include "Swarm.h"
 
-#include <SDL2/SDL_mutex.h>
+#include <string.h>
 
-static SDL_mutex* mutex;
-static int32_t ping;
-
-static void SetPing(const int32_t dt)
+// AN IDLE CLIENT SENDS NOTHING BUT A HEARTBEAT NOW AND THEN.
+static uint32_t Beat(const Sock sock, const Overview overview, const uint32_t beat)
 {
-    if(SDL_TryLockMutex(mutex) == 0)
-    {
-        ping = dt;
-        SDL_UnlockMutex(mutex);
-    }
+    const uint32_t now = SDL_GetTicks();
+    if((int32_t) (now - beat) < CONFIG_SOCKETS_HEARTBEAT_MS)
+        return beat;
+    Sock_SendHeartbeat(sock, overview);
+    return now;
 }
 
-static int32_t GetPing(void)
+// EVERY CLIENT DUMPS WHAT IT HAD AT THE FIRST CYCLE THAT DIFFERED, AND THE UNITS IT HAS NOW IN THE
+// REGIONS THAT DIFFERED, FOR DIFFING AGAINST THE OTHER CLIENTS.
+static void Desync(const Units units, const Parities parities, const Packet packet)
 {
-    int32_t out = -1;
-    if(SDL_TryLockMutex(mutex) == 0)
-    {
-        out = ping;
-        SDL_UnlockMutex(mutex);
-    }
-    return out;
+    printf("CLIENT - CLIENT_ID %d :: DESYNC AT CYCLE %d :: NOW AT CYCLE %d\n", packet.client_id, packet.desync, units.cycles);
+    const Parity parity = Parities_Get(parities, packet.desync);
+    if(parity.cycles == packet.desync)
+        Parity_Print(parity);
+    Units_Dump(units, packet.desync_regions);
+    Util_Bomb("CLIENT - CLIENT_ID %d :: OUT OF SYNC\n", packet.client_id);
 }
 
-static Overview WaitInLobby(const Video video, const Sock sock, int32_t* users)
+// A CLIENT REJOINING A RUNNING MATCH IS KEPT HERE, AS THE SERVER TELLS IT THE MATCH HAS NOT STARTED,
+// UNTIL ITS SNAPSHOT IS THROUGH.
+static Overview WaitInLobby(const Video video, const Sock sock, int32_t* users, bool* is_rollback)
 {
     int32_t loops = 0;
+    uint32_t beat = SDL_GetTicks() - CONFIG_SOCKETS_HEARTBEAT_MS;
     Overview overview = Overview_Init(video.xres, video.yres);
     for(Input input = Input_Ready(); !input.done; input = Input_Pump(input))
     {
-        Sock_Send(sock, overview);
-        const Packet packet = Packet_Get(sock);
-        if(packet.turn > 0)
+        beat = Beat(sock, overview, beat);
+        // STOPS AT THE FIRST RUNNING PACKET - THE TURNS BEHIND IT ARE LEFT FOR THE GAME LOOP.
+        for(Packet packet = Packet_Get(sock); packet.turn > 0; packet = Packet_Get(sock))
         {
             overview.share.color = (Color) packet.client_id;
             Video_PrintLobby(video, packet.users_connected, packet.users, overview.share.color, loops++);
+            *users = packet.users;
+            *is_rollback = packet.is_rollback;
             if(packet.game_running)
-            {
-                *users = packet.users;
-                break;
-            }
+                return overview;
         }
+        if(Transfer_IsDone(*sock.transfer))
+            return overview;
         SDL_Delay(CONFIG_MAIN_LOOP_SPEED_MS);
     }
     return overview;
 }
 
-static int32_t Ping(void* const data)
+// THE DONOR'S WORLD WITH THIS CLIENT'S OWN SHARE. RESOURCES ARE GATHERED INTO EVERY CLIENT'S SHARE
+// ALIKE, SO THEY ARE TAKEN FROM THE DONOR, BUT THE DONOR'S AGE AND RESEARCH ARE ITS OWN. THIS
+// CLIENT'S WERE LOST WITH ITS CONNECTION, SO ITS BUTTONS START OVER FROM THE FIRST AGE.
+static Units Readmit(Units units, const Transfer transfer)
 {
-    Args* args = (Args*) data;
-    const Sock pinger = Sock_Connect(args->host, args->port_ping);
-    while(true)
+    const Share share = units.share;
+    units = Units_Restore(units, transfer.snapshot);
+    units.share.color = share.color;
+    units.share.status.civ = share.status.civ;
+    units.share.status.age = share.status.age;
+    units.share.bits = share.bits;
+    units.share.motive = share.motive;
+    return units;
+}
+
+// A DONOR SNAPSHOTS AT THE FIRST TICK AT OR PAST THE CYCLE IT WAS ASKED FOR, BEFORE THE TURNS OF THAT
+// CYCLE ARE SERVICED, AS THE REJOINING CLIENT IS SENT THOSE TURNS.
+static Transfer Donate(Transfer transfer, const Units units, const int32_t asked, const int32_t cycles)
+{
+    if(asked > 0 && !transfer.is_active && cycles >= asked)
     {
-        const int32_t message = 0xCAFEBABE;
-        int32_t temp;
-        const int32_t size = sizeof(temp);
-        const int32_t t0 = SDL_GetTicks();
-        SDLNet_TCP_Send(pinger.server, &message, size);
-        SDLNet_TCP_Recv(pinger.server, &temp, size);
-        const int32_t t1 = SDL_GetTicks();
-        if(temp == message)
-            SetPing(t1 - t0);
+        transfer = Transfer_Begin(transfer, cycles, 0);
+        transfer.snapshot = Units_Snapshot(units, transfer.snapshot);
     }
-    Sock_Disconnect(pinger);
-    return 0;
+    return transfer;
+}
+
+// WITH ROLLBACK THE DONOR LENDS THE CONFIRMED CYCLE ASKED FOR FROM ITS RING, OR IF THE RING HAS MOVED
+// ON, THE CONFIRMED CYCLE IT IS AT. THE TURNS THE REJOINING CLIENT IS SENT BEFORE IT ARE IGNORED.
+static Transfer Lend(Transfer transfer, Rollback* const rollback, const int32_t asked, const int32_t cycles)
+{
+    const int32_t confirmed = Rollback_GetConfirmed(rollback, cycles);
+    if(asked > 0 && !transfer.is_active && confirmed >= asked)
+    {
+        const Snapshot* snapshot = Rollback_GetSnapshot(rollback, asked);
+        int32_t at = asked;
+        if(snapshot == NULL)
+        {
+            snapshot = Rollback_GetSnapshot(rollback, confirmed);
+            at = confirmed;
+        }
+        if(snapshot)
+        {
+            transfer = Transfer_Begin(transfer, at, snapshot->size);
+            memcpy(transfer.snapshot.byte, snapshot->byte, (size_t) snapshot->size);
+        }
+    }
+    return transfer;
+}
+
+// ONE PREDICTED TICK. THE PARITY OF A CHECKPOINT IS PUT AGAIN EVERY TIME IT IS SIMULATED AGAIN, SO
+// ONLY CONFIRMED CYCLES ARE EVER REPORTED. EFFECTS ONLY SPAWN THE FIRST TIME A CYCLE IS SIMULATED.
+static Units Predict(Units units, Rollback* const rollback, const bool is_behind, const Parities parities, const Data data, const Grid grid, const Map map)
+{
+    units.effects.is_quiet = is_behind || Rollback_IsRedoing(rollback, units);
+    Rollback_Save(rollback, units);
+    const Field field = Units_Field(units, map);
+    int32_t index = 0;
+    for(const Packet* packet = Rollback_Next(rollback, units.cycles, &index); packet; packet = Rollback_Next(rollback, units.cycles, &index))
+        units = Units_PacketService(units, data.graphics, *packet, grid, map, field);
+    units = Units_Caretake(units, data.graphics, grid, map, field);
+    Field_Free(field);
+    if(Parity_IsCheckpoint(units.cycles))
+        Parities_Put(parities, Units_Parity(units));
+    return units;
+}
+
+// LATE TURNS AND RETIRED GUESSES REWIND TO THE EARLIEST CYCLE THEY TOUCH, AND THE UNITS THEN TICK UP
+// TO THE PRESENT WITHIN A BUDGET, SO A DEEP REWIND IS SPREAD OVER FRAMES. NO TICK IS STARTED THAT THE
+// SLOWEST TICK SO FAR SAYS WOULD OVERRUN THE BUDGET, BUT ONE ALWAYS IS, SO THE UNITS NEVER STOP. THE
+// UNITS DRAWN MAY THEN BE A FEW CYCLES BEHIND THE PRESENT. FAR BEHIND, THE BUDGET IS A WHOLE FRAME.
+static Units CatchUp(Units units, Rollback* const rollback, const int32_t present, const bool is_behind, const Parities parities, const Data data, const Grid grid, const Map map)
+{
+    const double budget = is_behind ? CONFIG_MAIN_LOOP_SPEED_MS : CONFIG_ROLLBACK_RESIM_MS;
+    const uint64_t t0 = SDL_GetPerformanceCounter();
+    units = Rollback_Rewind(rollback, units);
+    const bool is_redoing = Rollback_IsRedoing(rollback, units);
+    double spent = 0.0;
+    double tick = 0.0;
+    while(units.cycles < present && (spent == 0.0 || spent + tick <= budget))
+    {
+        units = Predict(units, rollback, is_behind, parities, data, grid, map);
+        const double ms = 1000.0 * (double) (SDL_GetPerformanceCounter() - t0) / (double) SDL_GetPerformanceFrequency();
+        tick = UTIL_MAX(tick, ms - spent);
+        spent = ms;
+    }
+    if(is_redoing)
+        Rollback_Count(rollback, spent);
+    return units;
+}
+
+// HEADLESS TICKS, WITHOUT RENDERING, WHILE FAR BEHIND THE SERVER, AS A CLIENT IS AFTER REJOINING.
+// NEVER PAST THE NEWEST TURN IN HAND, AND NEVER LONGER THAN A FRAME.
+static bool IsBehind(const Clock clock, const int32_t cycles, const int32_t newest, const uint32_t t0)
+{
+    return clock.is_synced
+        && Clock_GetOffset(clock, cycles) > CONFIG_SOCKETS_REJOIN_BEHIND
+        && cycles < newest
+        && (int32_t) (SDL_GetTicks() - t0) < CONFIG_MAIN_LOOP_SPEED_MS;
 }
 
 static void Play(const Video video, const Data data, const Map map, const Grid grid, const Args args)
 {
     int32_t users = 0;
-    const Sock sock = Sock_Connect(args.host, args.port);
-    Overview overview = WaitInLobby(video, sock, &users);
+    const Sock sock = Sock_Join(Sock_Connect(args.host, args.port), args.match, args.users);
+    if(sock.match == 0)
+        Util_Bomb("CLIENT - THE SERVER HAS NO SEAT IN MATCH %d\n", args.match);
+    bool is_rollback = false;
+    Overview overview = WaitInLobby(video, sock, &users, &is_rollback);
     Units units = Units_New(grid, video.cpu_count, CONFIG_UNITS_MAX, overview.share.color, args.civ);
     Units floats = Units_New(grid, video.cpu_count, CONFIG_UNITS_FLOAT_BUFFER, overview.share.color, args.civ);
     units = Units_GenerateTestZone(units, map, grid, data.graphics, users);
+    const bool is_rejoining = Transfer_IsDone(*sock.transfer);
+    if(is_rejoining)
+        units = Readmit(units, *sock.transfer);
     overview.pan = Units_GetFirstTownCenterPan(units, grid, overview.share.color);
+    // A REPLAY STARTS FROM THE TEST ZONE, SO A REJOINED MATCH IS NOT RECORDED.
+    Replay* const replay = args.record && !is_rejoining
+        ? Replay_Create(args.record, users, overview.share.color, args.civ, map.rows)
+        : NULL;
     Packets packets = Packets_Init();
-    int32_t cycles = 0;
+    Parities parities = Parities_Make(CONFIG_PARITY_HISTORY);
+    Parities_Put(parities, Units_Parity(units));
+    Clock clock = Clock_Make(SDL_GetTicks());
+    Transfer donation = Transfer_Make();
+    Rollback* const rollback = is_rollback ? Rollback_Make(overview.share.color, replay) : NULL;
+    if(rollback)
+        Rollback_Reset(rollback, units);
+    uint32_t beat = SDL_GetTicks() - CONFIG_SOCKETS_HEARTBEAT_MS;
+    uint32_t report = SDL_GetTicks();
+    int32_t cycles = units.cycles;
+    int32_t probed = 0;
+    int32_t asked = 0;
+    int32_t newest = cycles;
+    bool is_locked = is_rejoining;
     for(Input input = Input_Ready(); !input.done; input = Input_Pump(input))
     {
         const int32_t t0 = SDL_GetTicks();
-        const uint64_t parity = Units_Xor(units);
-        const int32_t my_ping = GetPing();
+        const int32_t confirmed = rollback ? Rollback_GetConfirmed(rollback, units.cycles) : cycles;
+        const Parity parity = Parities_Get(parities, Parity_GetCheckpoint(confirmed));
+        const int32_t my_ping = Rtt_GetLast(sock.rtt);
         overview = Overview_Update(overview, input, parity, cycles, Packets_Size(packets), units.share, my_ping);
-        Sock_Send(sock, overview);
-        const Packet packet = Packet_Get(sock);
-        if(Packet_IsStable(packet))
-            packets = Packets_Queue(packets, packet);
-        while(Packets_Active(packets) && Packets_Peek(packets).exec_cycle < cycles)
+        if(Overview_UsedAction(overview))
+        {
+            overview.sequence++;
+            Sock_SendCommand(sock, overview);
+            if(rollback)
+                Rollback_Guess(rollback, overview, cycles);
+        }
+        beat = Beat(sock, overview, beat);
+        for(Packet next = Packet_Get(sock); next.turn > 0; next = Packet_Get(sock))
+        {
+            if(rollback)
+            {
+                Rollback_Turn(rollback, next, units.cycles);
+                newest = UTIL_MAX(newest, next.exec_cycle);
+            }
+            else if(Packet_IsStable(next))
+            {
+                packets = Packets_Queue(packets, &next);
+                newest = UTIL_MAX(newest, next.exec_cycle);
+                is_locked = true;
+            }
+            if(next.snapshot != asked)
+            {
+                donation = Transfer_Stop(donation);
+                asked = next.snapshot;
+            }
+            clock = Clock_Observe(clock, next.setpoint, Rtt_GetSmooth(sock.rtt));
+            if(next.probe > 0 && next.probe != probed)
+            {
+                Sock_SendParity(sock, Parities_Get(parities, next.probe));
+                probed = next.probe;
+            }
+            if(next.desync > 0)
+                Desync(units, parities, next);
+        }
+        clock = Clock_Advance(clock, cycles, t0);
+        const bool is_behind = IsBehind(clock, rollback ? units.cycles : cycles, newest, t0);
+        units.effects.is_quiet = is_behind;
+        for(int32_t tick = 0; tick < clock.ticks || (is_behind && IsBehind(clock, cycles, newest, t0)); tick++)
+        {
+            if(rollback)
+            {
+                if(!Rollback_CanAdvance(rollback, cycles))
+                    break;
+                cycles++;
+                continue;
+            }
+            // ANOTHER TURN FOR THE NEWEST CYCLE, OR FOR ANY CYCLE PAST IT, MAY STILL BE IN FLIGHT, SO
+            // ONCE TURNS ARE STABLE LOCKSTEP HOLDS THERE, AS WATCHING DOES, RATHER THAN SKIP IT. BEFORE
+            // THEN NO TURN CARRIES ANYTHING, AND THE CLOCK RUNS FREE SO THAT THE SERVER SEES CYCLES.
+            if(is_locked && cycles >= newest)
+                break;
+            packets = Packets_Skip(packets, cycles);
+            donation = Donate(donation, units, asked, cycles);
+            const Field field = Units_Field(units, map);
+            for(const Packet* turn = Packets_Find(packets, cycles); turn; turn = Packets_Find(packets, cycles))
+            {
+                if(replay)
+                    Replay_Record(replay, *turn);
+                units = Units_PacketService(units, data.graphics, *turn, grid, map, field);
+                packets = Packets_Pop(packets);
+            }
+            units = Units_Caretake(units, data.graphics, grid, map, field);
+            Field_Free(field);
+            cycles++;
+            if(Parity_IsCheckpoint(cycles))
+                Parities_Put(parities, Units_Parity(units));
+        }
+        if(rollback)
+        {
+            units = CatchUp(units, rollback, cycles, is_behind, parities, data, grid, map);
+            donation = Lend(donation, rollback, asked, units.cycles);
+            if((int32_t) (SDL_GetTicks() - report) >= CONFIG_ROLLBACK_REPORT_MS)
+            {
+                Rollback_Print(rollback);
+                report = SDL_GetTicks();
+            }
+        }
+        Sock_SendSnapshot(sock, &donation, CONFIG_SOCKETS_REJOIN_CHUNKS);
+        if(!is_behind)
+        {
+            floats = Units_Float(floats, units, data.graphics, overview, grid, map, units.share.motive);
+            Video_Draw(video, data, map, units, floats, overview, grid);
+            const int32_t t1 = SDL_GetTicks();
+            const int32_t dt = t1 - t0;
+            Video_Render(video, units, dt, cycles);
+        }
+        const int32_t t2 = SDL_GetTicks();
+        const int32_t ms = CONFIG_MAIN_LOOP_SPEED_MS - (t2 - t0);
+        if(ms > 0)
+            SDL_Delay(ms);
+    }
+    // WITH ROLLBACK A RECORDING ENDS AT THE CONFIRMED CYCLE, AS THE CYCLES PAST IT WERE PREDICTED. THE
+    // CONFIRMED CYCLE NEED NOT BE A CHECKPOINT, SO ITS PARITY IS TAKEN FROM ITS SNAPSHOT IN THE RING,
+    // WHICH ONLY THE PRESENT IS NOT YET IN.
+    if(replay && rollback)
+    {
+        const int32_t confirmed = Rollback_GetConfirmed(rollback, units.cycles);
+        Rollback_Retire(rollback, units.cycles);
+        const Snapshot* const snapshot = Rollback_GetSnapshot(rollback, confirmed);
+        if(snapshot)
+            units = Units_Restore(units, *snapshot);
+        Replay_Close(replay, confirmed, Units_Parity(units).root);
+    }
+    else if(replay)
+        Replay_Close(replay, cycles, Units_Parity(units).root);
+    Units_Free(floats);
+    Units_Free(units);
+    Packets_Free(packets);
+    Parities_Free(parities);
+    Transfer_Free(donation);
+    if(rollback)
+        Rollback_Free(rollback);
+    Sock_Disconnect(sock);
+}
+
+// A SPECTATOR SENDS NOTHING, AND IS SENT NOTHING UNTIL A KEYFRAME. IT SEES THE MATCH AS THE DONOR
+// OF ITS KEYFRAME DOES, AND AS ITS TURNS ARE THE DELAY OLD IT NEVER TICKS A CYCLE BEFORE A TURN FOR A
+// LATER ONE IS IN HAND, SO NO TURN CAN STILL COME FOR IT.
+static void Watch(const Video video, const Data data, const Map map, const Grid grid, const Args args)
+{
+    const Sock sock = Sock_Connect(args.host, args.port + SPECTATORS_PORT_OFFSET);
+    int32_t loops = 0;
+    Input input = Input_Ready();
+    for(; !input.done && !Transfer_IsDone(*sock.transfer); input = Input_Pump(input))
+    {
+        Packet_Get(sock);
+        Video_PrintLobby(video, 0, 0, COLOR_GAIA, loops++);
+        SDL_Delay(CONFIG_MAIN_LOOP_SPEED_MS);
+    }
+    Units units = Units_New(grid, video.cpu_count, CONFIG_UNITS_MAX, args.color, args.civ);
+    Units floats = Units_New(grid, video.cpu_count, CONFIG_UNITS_FLOAT_BUFFER, args.color, args.civ);
+    if(Transfer_IsDone(*sock.transfer))
+        units = Units_Restore(units, sock.transfer->snapshot);
+    Overview overview = Overview_Init(video.xres, video.yres);
+    overview.share.color = units.share.color;
+    overview.pan = Units_GetFirstTownCenterPan(units, grid, overview.share.color);
+    static Parity none;
+    Packets packets = Packets_Init();
+    Clock clock = Clock_Make(SDL_GetTicks());
+    int32_t cycles = units.cycles;
+    int32_t newest = cycles;
+    for(; !input.done; input = Input_Pump(input))
+    {
+        const int32_t t0 = SDL_GetTicks();
+        overview = Overview_Update(overview, input, none, cycles, Packets_Size(packets), units.share, 0);
+        for(Packet next = Packet_Get(sock); next.turn > 0; next = Packet_Get(sock))
         {
-            Packet waste;
-            packets = Packets_Dequeue(packets, &waste);
+            if(Packet_IsStable(next))
+            {
+                packets = Packets_Queue(packets, &next);
+                newest = UTIL_MAX(newest, next.exec_cycle);
+            }
+            clock = Clock_Observe(clock, next.setpoint, 0);
         }
-        const Field field = Units_Field(units, map);
-        if(Packets_Active(packets))
+        clock = Clock_Advance(clock, cycles, t0);
+        const bool is_behind = IsBehind(clock, cycles, newest, t0);
+        units.effects.is_quiet = is_behind;
+        for(int32_t tick = 0; (tick < clock.ticks || (is_behind && IsBehind(clock, cycles, newest, t0))) && cycles < newest; tick++)
         {
-            const Packet peek = Packets_Peek(packets);
-            if(cycles > peek.exec_cycle)
-                Util_Bomb("CLIENT - CLIENT_ID %d :: OUT OF SYNC :: CYCLES %d :: PEEK %d\n", peek.client_id, cycles, peek.exec_cycle);
-            while(cycles == Packets_Peek(packets).exec_cycle)
+            packets = Packets_Skip(packets, cycles);
+            const Field field = Units_Field(units, map);
+            for(const Packet* turn = Packets_Find(packets, cycles); turn; turn = Packets_Find(packets, cycles))
             {
-                Packet dequeued;
-                packets = Packets_Dequeue(packets, &dequeued);
-                units = Units_PacketService(units, data.graphics, dequeued, grid, map, field);
+                units = Units_PacketService(units, data.graphics, *turn, grid, map, field);
+                packets = Packets_Pop(packets);
             }
+            units = Units_Caretake(units, data.graphics, grid, map, field);
+            Field_Free(field);
+            cycles++;
+        }
+        if(!is_behind)
+        {
+            floats = Units_Float(floats, units, data.graphics, overview, grid, map, units.share.motive);
+            Video_Draw(video, data, map, units, floats, overview, grid);
+            const int32_t t1 = SDL_GetTicks();
+            const int32_t dt = t1 - t0;
+            Video_Render(video, units, dt, cycles);
         }
-        units = Units_Caretake(units, data.graphics, grid, map, field);
-        cycles++;
-        if(packet.control == PACKET_CONTROL_SPEED_UP)
-            continue;
-        floats = Units_Float(floats, units, data.graphics, overview, grid, map, units.share.motive);
-        Video_Draw(video, data, map, units, floats, overview, grid);
-        const int32_t t1 = SDL_GetTicks();
-        const int32_t dt = t1 - t0;
-        Video_Render(video, units, dt, cycles);
-        Field_Free(field);
         const int32_t t2 = SDL_GetTicks();
         const int32_t ms = CONFIG_MAIN_LOOP_SPEED_MS - (t2 - t0);
         if(ms > 0)
@@ -138,47 +401,157 @@ static void Play(const Video video, const Data data, const Map map, const Grid g
 
 static void RunClient(const Args args)
 {
-    mutex = SDL_CreateMutex();
-    SDL_CreateThread(Ping, "N/A", (void*) &args);
     SDL_Init(SDL_INIT_VIDEO);
     const Video video = Video_Setup(args.xres, args.yres, CONFIG_MAIN_GAME_NAME);
     Video_PrintLobby(video, 0, 0, COLOR_GAIA, 0);
     const Data data = Data_Load(args.path);
     const Map map = Map_Make(40, data.terrain);
     const Grid grid = Grid_Make(map.cols, map.rows, map.tile_width, map.tile_height);
-    args.demo
-        ? Video_RenderDataDemo(video, data, args.color)
-        : Play(video, data, map, grid, args);
+    if(args.demo)
+        Video_RenderDataDemo(video, data, args.color);
+    else if(args.observe)
+        Watch(video, data, map, grid, args);
+    else
+        Play(video, data, map, grid, args);
     Map_Free(map);
     Data_Free(data);
     Video_Free(video);
     SDL_Quit();
-    SDL_DestroyMutex(mutex);
-    // NO NEED TO FREE PING LOOP. OPERATING SYSTEM WILL SHUT IT DOWN.
 }
 
-static void RunServer(const Args args)
+// RE-SIMULATES A RECORDED MATCH AS FAST AS THE CPU ALLOWS, WITH NEITHER A WINDOW NOR A SERVER,
+// PRINTING THE TIME AND PARITY OF EVERY TICK.
+static void RunReplay(const Args args)
+{
+    SDL_Init(SDL_INIT_TIMER);
+    Replay* const replay = Replay_Open(args.replay);
+    const Data data = Data_Load(args.path);
+    const Map map = Map_Make(replay->map_size, data.terrain);
+    const Grid grid = Grid_Make(map.cols, map.rows, map.tile_width, map.tile_height);
+    Units units = Units_New(grid, SDL_GetCPUCount(), CONFIG_UNITS_MAX, replay->color, replay->civ);
+    units = Units_GenerateTestZone(units, map, grid, data.graphics, replay->users);
+    units = Replay_Play(replay, units, data.graphics, grid, map, true);
+    printf("REPLAY :: %d CYCLES :: %.3f MS MEAN :: %.3f MS WORST :: 0x%016lX %s\n",
+        units.cycles, replay->total_ms / UTIL_MAX(replay->played, 1), replay->worst_ms, Units_Parity(units).root, Replay_Check(replay, units));
+    Replay_Free(replay);
+    Units_Free(units);
+    Map_Free(map);
+    Data_Free(data);
+    SDL_Quit();
+}
+
+// BOTS THAT NEED NEITHER A WINDOW NOR THE GAME DATA, FOR LOADING A SERVER. WITH A MULTI MATCH SERVER
+// THEY FILL AS MANY MATCHES AS IT TAKES.
+static void RunSwarm(const Args args)
+{
+    SDL_Init(SDL_INIT_TIMER);
+    Swarm* const swarm = Swarm_Make(args.host, args.port, args.swarm, args.match, args.users, Script_Parse(args.script));
+    Swarm_Run(swarm, args.seconds);
+    Swarm_Print(swarm, !args.quiet);
+    Swarm_Free(swarm);
+    SDL_Quit();
+}
+
+static Sockets Open(const Args args)
 {
     Sockets sockets = Sockets_Init(args.port, args.users);
-    Sockets pingers = Sockets_Init(args.port_ping, args.users);
-    for(int32_t cycles = 0; true; cycles++)
+    sockets.is_rollback = args.rollback;
+    // THE DELAY IS GIVEN IN SECONDS.
+    if(args.watch >= 0)
+        sockets = Sockets_EnableSpectators(sockets, args.port + SPECTATORS_PORT_OFFSET,
+            args.watch * 1000 / CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS);
+    if(args.telemetry)
+        sockets = Sockets_EnableTelemetry(sockets, args.telemetry);
+    if(args.compress > CODEC_OFF)
+        sockets = Sockets_EnableCompression(sockets, args.compress);
+    return args.udp
+        ? Sockets_EnableUdp(sockets, args.port)
+        : sockets;
+}
+
+#ifdef __linux__
+
+#define TAG_SOCKETS (0)
+
+// EVERYTHING HAPPENS IN RESPONSE TO EPOLL: A TURN IS RELAYED WHEN THE TIMER FIRES,
+// AND A SOCKET IS ONLY READ OR ACCEPTED ONCE IT IS READY.
+static void RunServer(const Args args)
+{
+    const Poll poll = Poll_Make(CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS);
+    Sockets sockets = Sockets_Watch(Open(args), poll, TAG_SOCKETS);
+    while(true)
+    {
+        int32_t tags[POLL_EVENTS_MAX];
+        const int32_t count = Poll_Wait(poll, tags);
+        for(int32_t i = 0; i < count; i++)
+        {
+            const int32_t tag = tags[i];
+            if(tag == POLL_TIMER)
+            {
+                sockets = Sockets_Relay(sockets, args.quiet);
+                if(sockets.is_out_of_sync)
+                    Util_Bomb("SERVER - OUT OF SYNC\n");
+            }
+            else if(tag - TAG_SOCKETS == COLOR_COUNT)
+                sockets = Sockets_Accept(sockets);
+            else if(tag - TAG_SOCKETS == COLOR_COUNT + 1)
+                sockets = Sockets_ReadDatagrams(sockets);
+            else if(tag - TAG_SOCKETS == COLOR_COUNT + 2)
+                Sockets_AcceptSpectator(sockets);
+            else
+                sockets = Sockets_Read(sockets, tag - TAG_SOCKETS);
+        }
+    }
+    Sockets_Free(sockets);
+    Poll_Free(poll);
+}
+
+#else
+
+static void RunServer(const Args args)
+{
+    Sockets sockets = Open(args);
+    for(uint32_t relay = SDL_GetTicks(); true;)
     {
         sockets = Sockets_Accept(sockets);
+        Sockets_AcceptSpectator(sockets);
         sockets = Sockets_Service(sockets, CONFIG_SOCKETS_SERVER_TIMEOUT_MS);
-        sockets = Sockets_Relay(sockets, cycles, CONFIG_SOCKETS_SERVER_UPDATE_SPEED_CYCLES, args.quiet);
-        pingers = Sockets_Accept(pingers);
-        Sockets_Ping(pingers, CONFIG_SOCKETS_SERVER_TIMEOUT_MS);
+        if((int32_t) (SDL_GetTicks() - relay) >= 0)
+        {
+            sockets = Sockets_Relay(sockets, args.quiet);
+            if(sockets.is_out_of_sync)
+                Util_Bomb("SERVER - OUT OF SYNC\n");
+            relay += CONFIG_SOCKETS_SERVER_UPDATE_SPEED_MS;
+        }
     }
-    Sockets_Free(pingers);
     Sockets_Free(sockets);
 }
 
+#endif
+
+static void RunHost(const Args args)
+{
+    Host* const host = Host_Start(args.port, args.shards);
+    Host_Wait(host);
+    Host_Stop(host);
+}
+
 int main(const int argc, const char* argv[])
 {
     SDLNet_Init();
     const Args args = Args_Parse(argc, argv);
-    args.is_server
+    Shim_Start(args.impair);
+    if(args.bench)
+        Bench_Run(args.bench);
+    else if(args.replay)
+        RunReplay(args);
+    else if(args.swarm > 0)
+        RunSwarm(args);
+    else if(args.shards > 0)
+        RunHost(args);
+    else args.is_server
         ? RunServer(args)
         : RunClient(args);
+    Shim_Stop();
     SDLNet_Quit();
 }